@@ -0,0 +1,36 @@
+#include "Async.h"
+
+template<typename T>
+AsyncTask<Matrix<T>> multiplyAsync(Matrix<T> A, Matrix<T> B, TaskPriority priority, ThreadPool& pool) {
+    // Checked here so a shape error reaches the caller before any queueing
+    if (A.getCols() != B.getRows()) {
+        throw std::invalid_argument("Invalid matrix dimensions for multiplication");
+    }
+    return pool.submit([A = std::move(A), B = std::move(B)]() { return A * B; }, priority);
+}
+
+template<typename T>
+AsyncTask<Matrix<T>> inverseAsync(Matrix<T> A, TaskPriority priority, ThreadPool& pool) {
+    return pool.submit([A = std::move(A)]() { return A.inverse(); }, priority);
+}
+
+template<typename T>
+AsyncTask<T> determinantAsync(Matrix<T> A, TaskPriority priority, ThreadPool& pool) {
+    return pool.submit([A = std::move(A)]() { return A.determinant(); }, priority);
+}
+
+template<typename T>
+AsyncTask<Matrix<T>> solveAsync(Matrix<T> A, Matrix<T> B, TaskPriority priority, ThreadPool& pool) {
+    return pool.submit([A = std::move(A), B = std::move(B)]() { return A.solve(B); }, priority);
+}
+
+template<typename T>
+AsyncTask<std::vector<std::complex<T>>> eigenvaluesAsync(Matrix<T> A, TaskPriority priority, ThreadPool& pool) {
+    return pool.submit([A = std::move(A)]() { return A.eigenvalues(); }, priority);
+}
+
+template<typename T>
+AsyncTask<std::pair<std::vector<T>, Matrix<T>>> eigenDecompositionAsync(Matrix<T> A, TaskPriority priority,
+                                                                        ThreadPool& pool) {
+    return pool.submit([A = std::move(A)]() { return A.eigenDecomposition(); }, priority);
+}
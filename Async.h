@@ -0,0 +1,46 @@
+#pragma once
+#include "Matrix.h"
+#include "ThreadPool.h"
+#include <complex>
+#include <utility>
+#include <vector>
+
+// Future-returning variants of the heavy Matrix operations, run on a
+// ThreadPool (the library's global pool by default) so request threads can
+// keep serving while many independent kernels are in flight:
+//
+//   auto inv = inverseAsync(std::move(A), TaskPriority::High);
+//   ...
+//   MatrixD Ainv = inv.get();  // rethrows e.g. "Matrix is singular..."
+//
+// Operands are taken by value, so the task owns them and the caller may
+// modify or release its matrices right after the call; std::move avoids the
+// copy. Errors of the operation are rethrown by get(). A task cancelled
+// before it starts throws TaskCancelled from get() instead.
+
+template<typename T>
+AsyncTask<Matrix<T>> multiplyAsync(Matrix<T> A, Matrix<T> B, TaskPriority priority = TaskPriority::Normal,
+                                   ThreadPool& pool = ThreadPool::global());
+
+template<typename T>
+AsyncTask<Matrix<T>> inverseAsync(Matrix<T> A, TaskPriority priority = TaskPriority::Normal,
+                                  ThreadPool& pool = ThreadPool::global());
+
+template<typename T>
+AsyncTask<T> determinantAsync(Matrix<T> A, TaskPriority priority = TaskPriority::Normal,
+                              ThreadPool& pool = ThreadPool::global());
+
+template<typename T>
+AsyncTask<Matrix<T>> solveAsync(Matrix<T> A, Matrix<T> B, TaskPriority priority = TaskPriority::Normal,
+                                ThreadPool& pool = ThreadPool::global());
+
+template<typename T>
+AsyncTask<std::vector<std::complex<T>>> eigenvaluesAsync(Matrix<T> A, TaskPriority priority = TaskPriority::Normal,
+                                                         ThreadPool& pool = ThreadPool::global());
+
+template<typename T>
+AsyncTask<std::pair<std::vector<T>, Matrix<T>>> eigenDecompositionAsync(Matrix<T> A,
+                                                                        TaskPriority priority = TaskPriority::Normal,
+                                                                        ThreadPool& pool = ThreadPool::global());
+
+#include "Async.cpp"  // Include implementation (header-only library)
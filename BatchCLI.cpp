@@ -0,0 +1,545 @@
+#include "BatchCLI.h"
+#include "Distance.h"
+#include "MatrixIO.h"
+#include "PerformanceBenchmark.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+// Thrown for malformed command lines (exit status 2)
+class UsageError : public std::invalid_argument {
+public:
+    using std::invalid_argument::invalid_argument;
+};
+
+// Thrown by 'bench' when the baseline comparison finds a regression (exit status 3)
+class BenchmarkRegressionError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+const std::map<std::string, BatchCLI::Command>& BatchCLI::commands() {
+    static const std::map<std::string, Command> table = {
+        {"multiply", {"multiply", "C = A * B", {"a", "b", "out"}, {}, &BatchCLI::multiply}},
+        {"det", {"det", "Determinant of A (--log prints sign and log|det|, --exact all digits for integer A)",
+                 {"a"}, {"log", "exact"}, &BatchCLI::determinant}},
+        {"inv", {"inv", "Inverse of A", {"a", "out"}, {}, &BatchCLI::inverse}},
+        {"eig", {"eig", "Eigenvalues of A (stdout, or an n x 2 [re im] matrix with --out)", {"a"}, {"out"}, &BatchCLI::eigenvalues}},
+        {"solve", {"solve", "X with A * X = B", {"a", "b", "out"}, {}, &BatchCLI::solve}},
+        {"lu", {"lu", "Pivoted LU, P * A = L * U", {"a", "l", "u"}, {"p"}, &BatchCLI::lu}},
+        {"qr", {"qr", "QR decomposition, A = Q * R", {"a", "q", "r"}, {}, &BatchCLI::qr}},
+        {"knn", {"knn", "Indices of the --k nearest rows of B for every row of A (--metric euclidean, sqeuclidean, cosine, ip)",
+                 {"a", "b", "k", "out"}, {"metric", "distances"}, &BatchCLI::nearest}},
+        {"cov", {"cov", "Covariance of the rows of A as observations (--gram: A^T * A)", {"a", "out"}, {"gram"}, &BatchCLI::covariance}},
+        {"random", {"random", "Random matrix, uniform on [--min, --max) or --normal with --mean and --stddev; --seed makes it reproducible",
+                    {"rows", "cols", "out"}, {"min", "max", "normal", "mean", "stddev", "seed"}, &BatchCLI::random}},
+        {"convert", {"convert", "Rewrite A in the format of --out", {"a", "out"}, {}, &BatchCLI::convert}},
+        {"bench", {"bench", "Benchmark suite; JSON/CSV results, compare with a --json baseline",
+                   {}, {"groups", "json", "csv", "baseline", "threshold"}, &BatchCLI::benchmark}},
+        {"sweep", {"sweep", "Size/aspect/dtype/thread sweep with strong and weak scaling tables",
+                   {}, {"kernels", "dtypes", "sizes", "aspects", "threads", "json", "csv"}, &BatchCLI::sweep}},
+        {"tune", {"tune", "Autotune kernel blocking and cutoffs for this CPU and save them",
+                  {}, {"dtypes", "out"}, &BatchCLI::tune}},
+    };
+    return table;
+}
+
+void BatchCLI::printUsage(std::ostream& os) {
+    os << "Usage: linalg <command> [--option value ...]\n"
+       << "       linalg            (interactive calculator)\n\n"
+       << "Commands:\n";
+    for (const auto& entry : commands()) {
+        const Command& command = entry.second;
+        os << "  " << std::left << std::setw(10) << command.name << command.summary << "\n"
+           << "  " << std::setw(10) << "";
+        for (const std::string& name : command.required) os << " --" << name << " <...>";
+        for (const std::string& name : command.optional) os << " [--" << name << "]";
+        os << "\n";
+    }
+    os << "\nCommon options:\n"
+       << "  --threads N   Worker threads for the computation and for parsing and writing text\n"
+       << "                formats (default: the tuned count for the computation, else all cores)\n"
+       << "  --quiet       Do not print timing to stderr\n"
+       << "  --profile     Print calls, time, GFLOPS and GB/s per library operation to stderr\n"
+       << "  --trace FILE  Write a Chrome trace (chrome://tracing, Perfetto) of every operation\n"
+       << "                (--profile and --trace need a 'make profiling' build)\n\n"
+       << "File formats follow the extension: .lamx/.bin, .csv, .tsv, .mtx, .npy\n"
+       << "'bench' exits with status 3 when a benchmark is significantly slower than\n"
+       << "its --baseline by more than --threshold (default 0.05 = 5%). --groups takes\n"
+       << "a comma-separated subset of:";
+    for (const std::string& group : PerformanceBenchmark::benchmarkGroups()) os << " " << group;
+    os << "\n'sweep' takes comma-separated lists: --kernels (gemm, lu, qr, cholesky, eigen,\n"
+       << "dot), --dtypes, --sizes (or MIN:MAX, doubling), --aspects (rows/cols, e.g. 4 for\n"
+       << "tall-skinny, 0.25 for short-wide) and --threads (default 1,2,4,.. up to all cores).\n"
+       << "'bench' and 'sweep' write --json / --csv reports.";
+    os << "\n'tune' writes to --out (default " << Tuning::defaultPath() << "), which every\n"
+       << "run reads at startup; --dtypes takes a comma-separated subset of:";
+    for (const std::string& dtype : PerformanceBenchmark::tuningTypes()) os << " " << dtype;
+    os << "\n";
+}
+
+int BatchCLI::run(int argc, char* argv[]) {
+    const std::string name = argv[1];
+    if (name == "help" || name == "--help" || name == "-h") {
+        printUsage(std::cout);
+        return 0;
+    }
+
+    try {
+        const auto found = commands().find(name);
+        if (found == commands().end()) {
+            throw UsageError("Unknown command '" + name + "'");
+        }
+        const Options options = parseOptions(argc, argv, found->second);
+        // --threads bounds the command's compute as well as its file I/O;
+        // 'sweep' takes its own list of thread counts instead
+        const std::vector<std::string>& optional = found->second.optional;
+        if (options.count("threads") && std::find(optional.begin(), optional.end(), "threads") == optional.end()) {
+            Tuning::parameters<double>().threads = threads(options);
+        }
+        startProfiling(options);
+        timed(options, "total", [&]() { found->second.handler(options); });
+        finishProfiling(options);
+        return 0;
+    } catch (const BenchmarkRegressionError& error) {
+        std::cerr << "Error: " << error.what() << std::endl;
+        return 3;
+    } catch (const UsageError& error) {
+        std::cerr << "Error: " << error.what() << "\nRun 'linalg help' for usage." << std::endl;
+        return 2;
+    } catch (const std::exception& error) {
+        std::cerr << "Error: " << error.what() << std::endl;
+        return 1;
+    }
+}
+
+BatchCLI::Options BatchCLI::parseOptions(int argc, char* argv[], const Command& command) {
+    Options options;
+    for (int i = 2; i < argc; ++i) {
+        std::string argument = argv[i];
+        if (argument.size() < 3 || argument.compare(0, 2, "--") != 0) {
+            throw UsageError("Unexpected argument '" + argument + "'");
+        }
+        argument = argument.substr(2);
+
+        std::string value = "true";  // Flags without a value are switches
+        const size_t equals = argument.find('=');
+        if (equals != std::string::npos) {
+            value = argument.substr(equals + 1);
+            argument = argument.substr(0, equals);
+        } else if (i + 1 < argc && std::string(argv[i + 1]).compare(0, 2, "--") != 0) {
+            value = argv[++i];
+        }
+
+        auto listed = [&](const std::vector<std::string>& names) {
+            return std::find(names.begin(), names.end(), argument) != names.end();
+        };
+        const bool known = listed(command.required) || listed(command.optional) ||
+                           argument == "threads" || argument == "quiet" ||
+                           argument == "profile" || argument == "trace";
+        if (!known) {
+            throw UsageError("Unknown option --" + argument + " for '" + command.name + "'");
+        }
+        options[argument] = value;
+    }
+
+    for (const std::string& name : command.required) {
+        if (!options.count(name)) {
+            throw UsageError("Missing --" + name + " for '" + command.name + "'");
+        }
+    }
+    return options;
+}
+
+const std::string& BatchCLI::get(const Options& options, const std::string& name) {
+    return options.at(name);
+}
+
+size_t BatchCLI::getSize(const Options& options, const std::string& name, size_t fallback) {
+    const auto found = options.find(name);
+    if (found == options.end()) return fallback;
+    try {
+        size_t used = 0;
+        const unsigned long long value = std::stoull(found->second, &used);
+        if (used != found->second.size()) throw std::invalid_argument(found->second);
+        return static_cast<size_t>(value);
+    } catch (const std::exception&) {
+        throw UsageError("--" + name + " expects a non-negative integer, got '" + found->second + "'");
+    }
+}
+
+double BatchCLI::getDouble(const Options& options, const std::string& name, double fallback) {
+    const auto found = options.find(name);
+    if (found == options.end()) return fallback;
+    try {
+        size_t used = 0;
+        const double value = std::stod(found->second, &used);
+        if (used != found->second.size()) throw std::invalid_argument(found->second);
+        return value;
+    } catch (const std::exception&) {
+        throw UsageError("--" + name + " expects a number, got '" + found->second + "'");
+    }
+}
+
+unsigned BatchCLI::threads(const Options& options) {
+    return static_cast<unsigned>(getSize(options, "threads", 0));
+}
+
+void BatchCLI::timed(const Options& options, const char* phase, const std::function<void()>& step) {
+    const auto start = Clock::now();
+    step();
+    const double elapsed = Duration(Clock::now() - start).count();
+    if (!options.count("quiet")) {
+        std::cerr << "[time] " << std::left << std::setw(8) << phase << std::right << std::fixed
+                  << std::setprecision(3) << std::setw(12) << elapsed << " ms" << std::endl;
+    }
+}
+
+void BatchCLI::startProfiling(const Options& options) {
+    if (!options.count("profile") && !options.count("trace")) return;
+#if LINALG_PROFILING_ENABLED
+    if (options.count("trace") && get(options, "trace") == "true") {
+        throw UsageError("--trace expects an output file");
+    }
+    Profiler::reset();
+    Profiler::setTracing(options.count("trace") > 0);
+#else
+    throw UsageError("--profile and --trace need a build with profiling ('make profiling')");
+#endif
+}
+
+void BatchCLI::finishProfiling(const Options& options) {
+#if LINALG_PROFILING_ENABLED
+    if (options.count("trace")) {
+        Profiler::setTracing(false);
+        Profiler::writeChromeTrace(get(options, "trace"));
+        if (Profiler::droppedSpans() > 0) {
+            std::cerr << "[trace] " << Profiler::droppedSpans() << " spans dropped (span limit reached)" << std::endl;
+        }
+    }
+    if (options.count("profile")) {
+        Profiler::report(std::cerr);
+    }
+#else
+    (void)options;
+#endif
+}
+
+MatrixD BatchCLI::load(const Options& options, const std::string& name) {
+    MatrixD matrix;
+    timed(options, ("load " + name).c_str(), [&]() { matrix = loadMatrixFile<double>(get(options, name), threads(options)); });
+    return matrix;
+}
+
+void BatchCLI::save(const Options& options, const std::string& name, const MatrixD& matrix) {
+    timed(options, ("save " + name).c_str(), [&]() { saveMatrixFile(matrix, get(options, name), threads(options)); });
+}
+
+// ---------------------------------------------------------------------------
+// Commands
+// ---------------------------------------------------------------------------
+
+void BatchCLI::multiply(const Options& options) {
+    const MatrixD A = load(options, "a");
+    const MatrixD B = load(options, "b");
+    MatrixD C;
+    timed(options, "compute", [&]() { C = A * B; });
+    save(options, "out", C);
+}
+
+void BatchCLI::determinant(const Options& options) {
+    const MatrixD A = load(options, "a");
+    std::cout << std::setprecision(17);
+    if (options.count("log")) {
+        std::pair<double, double> result;
+        timed(options, "compute", [&]() { result = A.logAbsDeterminant(); });
+        std::cout << result.first << " " << result.second << std::endl;
+    } else if (options.count("exact")) {
+        Matrix<long long> integer(A.getRows(), A.getCols());
+        for (size_t i = 0; i < A.getRows(); ++i) {
+            for (size_t j = 0; j < A.getCols(); ++j) {
+                const double value = A(i, j);
+                if (value != std::floor(value) || std::abs(value) >= 9223372036854775808.0) {
+                    throw std::invalid_argument("--exact needs integer entries");
+                }
+                integer(i, j) = static_cast<long long>(value);
+            }
+        }
+        BigInt det;
+        ExactOptions exact;
+        exact.threads = threads(options);
+        timed(options, "compute", [&]() { det = exactDeterminant(integer, exact); });
+        std::cout << det << std::endl;
+    } else {
+        double det = 0.0;
+        timed(options, "compute", [&]() { det = A.determinant(); });
+        std::cout << det << std::endl;
+    }
+}
+
+void BatchCLI::inverse(const Options& options) {
+    const MatrixD A = load(options, "a");
+    MatrixD inv;
+    timed(options, "compute", [&]() { inv = A.inverse(); });
+    save(options, "out", inv);
+}
+
+void BatchCLI::eigenvalues(const Options& options) {
+    const MatrixD A = load(options, "a");
+    std::vector<std::complex<double>> values;
+    timed(options, "compute", [&]() { values = A.eigenvalues(); });
+
+    if (options.count("out")) {
+        MatrixD result(values.size(), 2);
+        for (size_t i = 0; i < values.size(); ++i) {
+            result(i, 0) = values[i].real();
+            result(i, 1) = values[i].imag();
+        }
+        save(options, "out", result);
+    } else {
+        std::cout << std::setprecision(17);
+        for (const std::complex<double>& value : values) {
+            std::cout << value.real() << " " << value.imag() << "\n";
+        }
+        std::cout.flush();
+    }
+}
+
+void BatchCLI::solve(const Options& options) {
+    const MatrixD A = load(options, "a");
+    const MatrixD B = load(options, "b");
+    MatrixD X;
+    timed(options, "compute", [&]() { X = A.solve(B); });
+    save(options, "out", X);
+}
+
+void BatchCLI::lu(const Options& options) {
+    const MatrixD A = load(options, "a");
+    LUFactorization<double> factorization;
+    timed(options, "compute", [&]() { factorization.refactor(A); });
+    if (factorization.isSingular()) {
+        std::cerr << "Warning: matrix is singular; U has a zero pivot" << std::endl;
+    }
+    save(options, "l", factorization.lower());
+    save(options, "u", factorization.upper());
+    if (options.count("p")) {
+        const std::vector<size_t>& permutation = factorization.getPermutation();
+        MatrixD P(permutation.size(), permutation.size());
+        for (size_t i = 0; i < permutation.size(); ++i) P(i, permutation[i]) = 1.0;
+        save(options, "p", P);
+    }
+}
+
+void BatchCLI::qr(const Options& options) {
+    const MatrixD A = load(options, "a");
+    std::pair<MatrixD, MatrixD> factors;
+    timed(options, "compute", [&]() { factors = A.qrDecomposition(); });
+    save(options, "q", factors.first);
+    save(options, "r", factors.second);
+}
+
+void BatchCLI::covariance(const Options& options) {
+    const MatrixD A = load(options, "a");
+    MatrixD result;
+    timed(options, "compute", [&]() { result = options.count("gram") ? A.gram() : A.covariance(); });
+    save(options, "out", result);
+}
+
+void BatchCLI::nearest(const Options& options) {
+    static const std::map<std::string, DistanceMetric> metrics = {
+        {"euclidean", DistanceMetric::Euclidean},
+        {"sqeuclidean", DistanceMetric::SquaredEuclidean},
+        {"cosine", DistanceMetric::Cosine},
+        {"ip", DistanceMetric::InnerProduct},
+    };
+    const std::string metricName = options.count("metric") ? get(options, "metric") : "euclidean";
+    const auto metric = metrics.find(metricName);
+    if (metric == metrics.end()) {
+        throw UsageError("--metric expects euclidean, sqeuclidean, cosine or ip, got '" + metricName + "'");
+    }
+    const size_t k = getSize(options, "k", 0);
+    const MatrixD queries = load(options, "a");
+    MatrixD points = load(options, "b");
+
+    std::vector<std::vector<Neighbor<double>>> neighbors;
+    timed(options, "compute", [&]() {
+        neighbors = PointSet<double>(std::move(points), metric->second).nearest(queries, k);
+    });
+
+    // One row per query; rows are shorter than k only when B has fewer rows
+    const size_t found = neighbors.empty() ? 0 : neighbors.front().size();
+    MatrixD indices(queries.getRows(), found);
+    MatrixD distances(queries.getRows(), found);
+    for (size_t i = 0; i < neighbors.size(); ++i) {
+        for (size_t r = 0; r < found; ++r) {
+            indices(i, r) = double(neighbors[i][r].index);
+            distances(i, r) = neighbors[i][r].distance;
+        }
+    }
+    save(options, "out", indices);
+    if (options.count("distances")) save(options, "distances", distances);
+}
+
+void BatchCLI::random(const Options& options) {
+    const size_t rows = getSize(options, "rows", 0);
+    const size_t cols = getSize(options, "cols", 0);
+    const bool normal = options.count("normal") > 0;
+    const double first = normal ? getDouble(options, "mean", 0.0) : getDouble(options, "min", 0.0);
+    const double second = normal ? getDouble(options, "stddev", 1.0) : getDouble(options, "max", 1.0);
+    const uint64_t seed = options.count("seed") ? getSize(options, "seed", 0) : randomSeed();
+
+    MatrixD result;
+    timed(options, "compute", [&]() {
+        result = normal ? MatrixD::randomNormal(rows, cols, first, second, seed)
+                        : MatrixD::random(rows, cols, first, second, seed);
+    });
+    save(options, "out", result);
+}
+
+void BatchCLI::convert(const Options& options) {
+    save(options, "out", load(options, "a"));
+}
+
+bool BatchCLI::reportOnStdout(const Options& options) {
+    return (options.count("json") && get(options, "json") == "-") ||
+           (options.count("csv") && get(options, "csv") == "-");
+}
+
+const std::vector<BenchmarkRecord>& BatchCLI::runReported(const Options& options, const char* phase,
+                                                          const std::function<void()>& suite) {
+    PerformanceBenchmark::clearResults();
+    {
+        // Progress goes to stderr when a report is written to stdout
+        struct RestoreStdout {
+            std::streambuf* buffer;
+            ~RestoreStdout() { std::cout.rdbuf(buffer); }
+        } restore{std::cout.rdbuf()};
+        if (reportOnStdout(options)) std::cout.rdbuf(std::cerr.rdbuf());
+
+        try {
+            timed(options, phase, suite);
+        } catch (const std::invalid_argument& error) {
+            throw UsageError(error.what());
+        }
+    }
+
+    const std::vector<BenchmarkRecord>& results = PerformanceBenchmark::results();
+    BenchmarkEnvironment environment = BenchmarkEnvironment::detect();
+    environment.roofline = RooflineModel::host();
+    if (options.count("json")) BenchmarkReport::writeJSON(get(options, "json"), environment, results);
+    if (options.count("csv")) BenchmarkReport::writeCSV(get(options, "csv"), environment, results);
+    return results;
+}
+
+static std::vector<std::string> commaList(const std::string& text) {
+    std::vector<std::string> items;
+    std::stringstream list(text);
+    std::string item;
+    while (std::getline(list, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+void BatchCLI::benchmark(const Options& options) {
+    const std::vector<std::string> groups = options.count("groups") ? commaList(get(options, "groups"))
+                                                                    : std::vector<std::string>();
+    const double threshold = getDouble(options, "threshold", 0.05);
+    if (threshold < 0.0) {
+        throw UsageError("--threshold must be non-negative");
+    }
+    std::vector<BenchmarkRecord> baseline;
+    if (options.count("baseline")) {
+        baseline = BenchmarkReport::readJSON(get(options, "baseline"));  // Fail before the long run
+    }
+
+    const std::vector<BenchmarkRecord>& results = runReported(options, "bench", [&]() {
+        PerformanceBenchmark::runBenchmarks(groups);
+    });
+
+    if (options.count("baseline")) {
+        const std::vector<BenchmarkComparison> comparisons = BenchmarkReport::compare(baseline, results, threshold);
+        // Keep stdout clean when a report is written there
+        std::ostream& log = reportOnStdout(options) ? std::cerr : std::cout;
+        log << "\nComparison with " << get(options, "baseline") << ":\n";
+        const size_t regressions = BenchmarkReport::printComparison(comparisons, log);
+        if (regressions > 0) {
+            throw BenchmarkRegressionError(std::to_string(regressions) + " benchmark(s) regressed against the baseline");
+        }
+    }
+}
+
+// --sizes: "64,100,200" or "MIN:MAX" for MIN, 2*MIN, ... up to MAX
+static std::vector<size_t> sweepSizes(const std::string& text) {
+    auto parse = [&](const std::string& item) {
+        size_t used = 0;
+        unsigned long long value = 0;
+        try {
+            value = std::stoull(item, &used);
+        } catch (const std::exception&) {
+            used = 0;
+        }
+        if (used == 0 || used != item.size() || value == 0) {
+            throw UsageError("--sizes expects positive integers or MIN:MAX, got '" + text + "'");
+        }
+        return static_cast<size_t>(value);
+    };
+    std::vector<size_t> sizes;
+    const size_t colon = text.find(':');
+    if (colon == std::string::npos) {
+        for (const std::string& item : commaList(text)) sizes.push_back(parse(item));
+        return sizes;
+    }
+    const size_t last = parse(text.substr(colon + 1));
+    for (size_t size = parse(text.substr(0, colon)); size <= last; size *= 2) sizes.push_back(size);
+    return sizes;
+}
+
+template<typename Number>
+static std::vector<Number> numberList(const std::map<std::string, std::string>& options, const std::string& name) {
+    std::vector<Number> numbers;
+    for (const std::string& item : commaList(options.at(name))) {
+        std::istringstream parser(item);
+        Number value;
+        if (!(parser >> value) || !parser.eof()) {
+            throw UsageError("--" + name + " expects a comma-separated list of numbers, got '" + options.at(name) + "'");
+        }
+        numbers.push_back(value);
+    }
+    return numbers;
+}
+
+void BatchCLI::sweep(const Options& options) {
+    SweepConfig config;
+    if (options.count("kernels")) config.kernels = commaList(get(options, "kernels"));
+    if (options.count("dtypes")) config.dtypes = commaList(get(options, "dtypes"));
+    if (options.count("sizes")) config.sizes = sweepSizes(get(options, "sizes"));
+    if (options.count("aspects")) config.aspects = numberList<double>(options, "aspects");
+    if (options.count("threads")) {
+        config.threads = numberList<unsigned>(options, "threads");
+    } else {
+        config.threads = {1};
+        for (unsigned threads = 2; threads <= std::thread::hardware_concurrency(); threads *= 2) {
+            config.threads.push_back(threads);
+        }
+    }
+    runReported(options, "sweep", [&]() { PerformanceBenchmark::runSweep(config); });
+}
+
+void BatchCLI::tune(const Options& options) {
+    const std::vector<std::string> dtypes = options.count("dtypes") ? commaList(get(options, "dtypes"))
+                                                                    : std::vector<std::string>();
+    const std::string path = options.count("out") ? get(options, "out") : Tuning::defaultPath();
+    if (path.empty()) {
+        throw UsageError("No tuning file: LINALG_TUNING_FILE is empty and no --out was given");
+    }
+    try {
+        timed(options, "tune", [&]() { PerformanceBenchmark::autotune(dtypes); });
+    } catch (const std::invalid_argument& error) {
+        throw UsageError(error.what());
+    }
+    Tuning::save(path);
+    std::cout << "Saved kernel tuning for " << Tuning::hostCpu() << " to " << path << std::endl;
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include "Matrix.h"
+#include "BenchmarkReport.h"
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+// Non-interactive command-line mode for scripted pipelines:
+//
+//   linalg <command> [--option value ...]
+//
+// Matrices are read and written with the formats in MatrixIO.h, chosen by
+// file extension. Results that are not matrices go to stdout; timing goes to
+// stderr unless --quiet is given; --profile and --trace report the library
+// operations a command ran (see Profiler.h). Exit status is 0 on success, 1 when the
+// computation fails, 2 on a usage error and 3 when 'bench' finds a
+// regression against its baseline.
+class BatchCLI {
+private:
+    using Clock = std::chrono::high_resolution_clock;
+    using Duration = std::chrono::duration<double, std::milli>;
+    using Options = std::map<std::string, std::string>;
+
+    struct Command {
+        const char* name;
+        const char* summary;
+        std::vector<std::string> required;
+        std::vector<std::string> optional;
+        void (*handler)(const Options& options);
+    };
+
+public:
+    // Returns true when argv selects batch mode (any argument given)
+    static bool isBatchInvocation(int argc) { return argc > 1; }
+
+    // Runs one command and returns the process exit code
+    static int run(int argc, char* argv[]);
+
+    static void printUsage(std::ostream& os = std::cout);
+
+private:
+    static const std::map<std::string, Command>& commands();
+    static Options parseOptions(int argc, char* argv[], const Command& command);
+
+    // Option helpers
+    static const std::string& get(const Options& options, const std::string& name);
+    static size_t getSize(const Options& options, const std::string& name, size_t fallback);
+    static double getDouble(const Options& options, const std::string& name, double fallback);
+    static unsigned threads(const Options& options);
+
+    // Timed load / save, reported on stderr
+    static MatrixD load(const Options& options, const std::string& name);
+    static void save(const Options& options, const std::string& name, const MatrixD& matrix);
+    static void timed(const Options& options, const char* phase, const std::function<void()>& step);
+
+    // Runs a benchmark suite and writes its --json / --csv reports
+    static const std::vector<BenchmarkRecord>& runReported(const Options& options, const char* phase,
+                                                           const std::function<void()>& suite);
+    static bool reportOnStdout(const Options& options);
+
+    // --profile / --trace (builds with LINALG_ENABLE_PROFILING only)
+    static void startProfiling(const Options& options);
+    static void finishProfiling(const Options& options);
+
+    // Commands
+    static void multiply(const Options& options);
+    static void determinant(const Options& options);
+    static void inverse(const Options& options);
+    static void eigenvalues(const Options& options);
+    static void solve(const Options& options);
+    static void lu(const Options& options);
+    static void qr(const Options& options);
+    static void covariance(const Options& options);
+    static void nearest(const Options& options);
+    static void random(const Options& options);
+    static void convert(const Options& options);
+    static void benchmark(const Options& options);
+    static void sweep(const Options& options);
+    static void tune(const Options& options);
+};
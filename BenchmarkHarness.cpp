@@ -0,0 +1,121 @@
+#include "BenchmarkHarness.h"
+#include <cmath>
+#include <limits>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#ifdef __linux__
+static cpu_set_t savedAffinity;
+static bool affinitySaved = false;
+#endif
+
+// Fractional degrees of freedom (Welch) are rounded down, which errs on the
+// side of a wider interval
+double BenchmarkHarness::studentT95(double degreesOfFreedom) {
+    static const double table[] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042,
+    };
+    if (!(degreesOfFreedom >= 1.0)) return std::numeric_limits<double>::infinity();
+    if (degreesOfFreedom < 31.0) return table[static_cast<size_t>(degreesOfFreedom) - 1];
+    return 1.960 + 2.4 / degreesOfFreedom;  // Within 0.005 of the exact value
+}
+
+// Linearly interpolated percentile of sorted data, p in [0, 1]
+static double percentile(const std::vector<double>& sorted, double p) {
+    const double position = p * static_cast<double>(sorted.size() - 1);
+    const size_t lower = static_cast<size_t>(position);
+    const size_t upper = std::min(lower + 1, sorted.size() - 1);
+    const double fraction = position - static_cast<double>(lower);
+    return sorted[lower] + fraction * (sorted[upper] - sorted[lower]);
+}
+
+const TimerCalibration& BenchmarkHarness::calibration() {
+    static const TimerCalibration calibrated = []() {
+        TimerCalibration result;
+
+        // Resolution: smallest nonzero step between consecutive readings
+        double resolution = std::numeric_limits<double>::infinity();
+        for (int trial = 0; trial < 1000; ++trial) {
+            const Clock::time_point first = Clock::now();
+            Clock::time_point next = Clock::now();
+            while (next == first) next = Clock::now();
+            resolution = std::min(resolution, std::chrono::duration<double, std::nano>(next - first).count());
+        }
+
+        // Overhead: average cost of one reading
+        const int CALLS = 100000;
+        const Clock::time_point start = Clock::now();
+        for (int i = 0; i < CALLS; ++i) {
+            doNotOptimize(Clock::now());
+        }
+        const double total = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+        result.resolutionNs = resolution;
+        result.overheadNs = total / CALLS;
+        return result;
+    }();
+    return calibrated;
+}
+
+BenchmarkStats BenchmarkHarness::summarize(const std::string& name, const std::vector<double>& sampleMs,
+                                           size_t iterationsPerSample) {
+    BenchmarkStats stats;
+    stats.name = name;
+    stats.samples = sampleMs.size();
+    stats.iterationsPerSample = iterationsPerSample;
+    stats.sampleMs = sampleMs;
+    if (sampleMs.empty()) return stats;
+
+    std::vector<double> sorted = sampleMs;
+    std::sort(sorted.begin(), sorted.end());
+    stats.minMs = sorted.front();
+    stats.maxMs = sorted.back();
+    stats.medianMs = percentile(sorted, 0.5);
+    stats.p95Ms = percentile(sorted, 0.95);
+
+    double sum = 0.0;
+    for (double value : sorted) sum += value;
+    stats.meanMs = sum / static_cast<double>(sorted.size());
+
+    if (sorted.size() > 1) {
+        double squares = 0.0;
+        for (double value : sorted) squares += (value - stats.meanMs) * (value - stats.meanMs);
+        stats.stddevMs = std::sqrt(squares / static_cast<double>(sorted.size() - 1));
+        stats.ciHalfWidthMs = studentT95(static_cast<double>(sorted.size() - 1)) * stats.stddevMs / std::sqrt(static_cast<double>(sorted.size()));
+    } else {
+        stats.ciHalfWidthMs = std::numeric_limits<double>::infinity();
+    }
+    return stats;
+}
+
+bool BenchmarkHarness::pinCurrentThread() {
+#ifdef __linux__
+    const int cpu = sched_getcpu();
+    if (cpu < 0 || sched_getaffinity(0, sizeof(savedAffinity), &savedAffinity) != 0) {
+        return false;
+    }
+    cpu_set_t single;
+    CPU_ZERO(&single);
+    CPU_SET(cpu, &single);
+    if (sched_setaffinity(0, sizeof(single), &single) != 0) {
+        return false;
+    }
+    affinitySaved = true;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void BenchmarkHarness::restoreAffinity() {
+#ifdef __linux__
+    if (affinitySaved) {
+        sched_setaffinity(0, sizeof(savedAffinity), &savedAffinity);
+        affinitySaved = false;
+    }
+#endif
+}
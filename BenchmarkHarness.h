@@ -0,0 +1,148 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <type_traits>
+
+// Optimization barriers. doNotOptimize(value) forces value to be computed
+// and treated as read; clobberMemory() forces pending stores to memory.
+// Without them, benchmark bodies whose results are unused can be elided.
+template<typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    if constexpr (std::is_trivially_copyable<T>::value && sizeof(T) <= sizeof(void*)) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    } else {
+        asm volatile("" : : "m"(value) : "memory");
+    }
+#else
+    const volatile char* sink = reinterpret_cast<const volatile char*>(&value);
+    (void)*sink;
+#endif
+}
+
+inline void clobberMemory() {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : : "memory");
+#else
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+struct BenchmarkConfig {
+    size_t warmupRuns = 1;             // Untimed calls before sampling (cold caches, first touch)
+    double warmupMs = 20.0;            // ...continued until this much time has passed
+    size_t minSamples = 5;             // Unless maxTimeMs runs out first (never fewer than 2)
+    size_t maxSamples = 1000;
+    double minSampleMs = 1.0;          // Fast kernels are batched until a sample lasts this long
+    double targetRelativeCI = 0.02;    // Stop once the 95% CI of the mean is within +-2%
+    double maxTimeMs = 1000.0;         // Sampling budget per benchmark
+    bool pinThread = false;            // Pin to the current CPU; only for single-threaded kernels, as
+                                       // threads started while pinned (pools, workers) inherit the mask
+};
+
+struct BenchmarkStats {
+    std::string name;
+    size_t samples = 0;
+    size_t iterationsPerSample = 1;
+    double minMs = 0.0;
+    double medianMs = 0.0;
+    double meanMs = 0.0;
+    double p95Ms = 0.0;
+    double maxMs = 0.0;
+    double stddevMs = 0.0;
+    double ciHalfWidthMs = 0.0;        // 95% confidence interval of the mean
+    bool converged = false;            // Reached targetRelativeCI within the budget
+    std::vector<double> sampleMs;      // Per-iteration time of every sample
+
+    double relativeCI() const { return meanMs > 0.0 ? ciHalfWidthMs / meanMs : 0.0; }
+};
+
+// Clock properties measured once per process
+struct TimerCalibration {
+    double resolutionNs = 0.0;  // Smallest observable nonzero tick
+    double overheadNs = 0.0;    // Cost of one now() call
+};
+
+// Statistically repeated timing of a callable: warmup, adaptive batching of
+// fast kernels against the calibrated timer, then sampling until the
+// confidence target or the time budget is reached.
+class BenchmarkHarness {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    template<typename Func>
+    static BenchmarkStats run(const std::string& name, Func&& func, const BenchmarkConfig& config = BenchmarkConfig());
+
+    static const TimerCalibration& calibration();
+
+    // Order statistics, mean, standard deviation and the t-based 95% CI
+    static BenchmarkStats summarize(const std::string& name, const std::vector<double>& sampleMs,
+                                    size_t iterationsPerSample);
+
+    // Two-sided 95% Student t quantile
+    static double studentT95(double degreesOfFreedom);
+
+    // Pins the calling thread to the CPU it is running on (Linux only);
+    // restoreAffinity undoes it. Returns false when pinning is unavailable.
+    static bool pinCurrentThread();
+    static void restoreAffinity();
+
+private:
+    static double elapsedMs(Clock::time_point start, Clock::time_point end) {
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+};
+
+template<typename Func>
+BenchmarkStats BenchmarkHarness::run(const std::string& name, Func&& func, const BenchmarkConfig& config) {
+    const TimerCalibration& timer = calibration();
+    const bool pinned = config.pinThread && pinCurrentThread();
+
+    // Warmup, which also gives a first estimate of the cost of one call
+    size_t warmupCalls = 0;
+    const Clock::time_point warmupStart = Clock::now();
+    while (warmupCalls < config.warmupRuns || elapsedMs(warmupStart, Clock::now()) < config.warmupMs) {
+        func();
+        clobberMemory();
+        ++warmupCalls;
+    }
+    const double estimateMs = elapsedMs(warmupStart, Clock::now()) / static_cast<double>(warmupCalls);
+
+    // Batch calls so every sample is long compared to the timer resolution
+    const double floorMs = std::max(config.minSampleMs, 1000.0 * timer.resolutionNs * 1e-6);
+    const size_t iterations = estimateMs >= floorMs ? 1 : static_cast<size_t>(floorMs / std::max(estimateMs, 1e-9)) + 1;
+
+    std::vector<double> samples;
+    const Clock::time_point samplingStart = Clock::now();
+    bool converged = false;
+    for (;;) {
+        clobberMemory();
+        const Clock::time_point start = Clock::now();
+        for (size_t i = 0; i < iterations; ++i) {
+            func();
+            clobberMemory();
+        }
+        const Clock::time_point end = Clock::now();
+        const double sample = (elapsedMs(start, end) - timer.overheadNs * 1e-6) / static_cast<double>(iterations);
+        samples.push_back(std::max(sample, 0.0));
+
+        if (samples.size() >= config.minSamples &&
+            summarize(name, samples, iterations).relativeCI() <= config.targetRelativeCI) {
+            converged = true;
+            break;
+        }
+        const bool outOfTime = samples.size() >= 2 && elapsedMs(samplingStart, Clock::now()) >= config.maxTimeMs;
+        if (samples.size() >= config.maxSamples || outOfTime) {
+            break;
+        }
+    }
+
+    if (pinned) restoreAffinity();
+    BenchmarkStats stats = summarize(name, samples, iterations);
+    stats.converged = converged;
+    return stats;
+}
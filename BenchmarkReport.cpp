@@ -0,0 +1,504 @@
+#include "BenchmarkReport.h"
+#include "Tuning.h"
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+std::string BenchmarkRecord::key() const {
+    return operation + "/" + std::to_string(rows) + "x" + std::to_string(cols) + "/" + dtype +
+           "/t" + std::to_string(threads);
+}
+
+double BenchmarkRecord::rooflinePercent(const RooflineModel& roofline) const {
+    const double attainable = roofline.attainableGflops(arithmeticIntensity());
+    return attainable > 0.0 ? 100.0 * gflops() / attainable : std::numeric_limits<double>::quiet_NaN();
+}
+
+// ---------------------------------------------------------------------------
+// Environment
+// ---------------------------------------------------------------------------
+
+BenchmarkEnvironment BenchmarkEnvironment::detect() {
+    BenchmarkEnvironment environment;
+
+    environment.cpuModel = Tuning::hostCpu();
+
+#if defined(__clang__)
+    environment.compiler = "clang " __clang_version__;
+#elif defined(__GNUC__)
+    environment.compiler = "g++ " __VERSION__;
+#elif defined(_MSC_VER)
+    environment.compiler = "msvc " + std::to_string(_MSC_VER);
+#else
+    environment.compiler = "unknown";
+#endif
+
+#ifdef LINALG_BUILD_FLAGS
+    environment.flags = LINALG_BUILD_FLAGS;
+#else
+    environment.flags = "unknown";
+#endif
+
+    std::string isa;
+    auto add = [&isa](const char* name) { isa += (isa.empty() ? "" : "+") + std::string(name); };
+#ifdef __AVX512F__
+    add("avx512f");
+#endif
+#ifdef __AVX2__
+    add("avx2");
+#endif
+#ifdef __FMA__
+    add("fma");
+#endif
+#if defined(__AVX__) && !defined(__AVX2__)
+    add("avx");
+#endif
+#if defined(__SSE4_2__) && !defined(__AVX__)
+    add("sse4.2");
+#endif
+#if defined(__SSE2__) && !defined(__SSE4_2__)
+    add("sse2");
+#endif
+#ifdef __ARM_NEON
+    add("neon");
+#endif
+    environment.isa = isa.empty() ? "scalar" : isa;
+
+    environment.hardwareThreads = std::thread::hardware_concurrency();
+
+    char buffer[32];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+    environment.timestamp = buffer;
+    return environment;
+}
+
+// ---------------------------------------------------------------------------
+// Writers
+// ---------------------------------------------------------------------------
+
+static std::string jsonString(const std::string& text) {
+    std::string out = "\"";
+    for (char c : text) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    out += escaped;
+                } else {
+                    out += c;
+                }
+        }
+    }
+    return out + "\"";
+}
+
+// JSON has no infinity or NaN
+static std::string jsonNumber(double value) {
+    if (!std::isfinite(value)) return "null";
+    std::ostringstream os;
+    os << std::setprecision(10) << value;
+    return os.str();
+}
+
+static std::string csvNumber(double value) {
+    return std::isfinite(value) ? jsonNumber(value) : "";
+}
+
+static std::string csvField(const std::string& text) {
+    if (text.find_first_of(",\"\n") == std::string::npos) return text;
+    std::string out = "\"";
+    for (char c : text) {
+        if (c == '"') out += '"';
+        out += c;
+    }
+    return out + "\"";
+}
+
+void BenchmarkReport::writeJSON(std::ostream& os, const BenchmarkEnvironment& environment,
+                                const std::vector<BenchmarkRecord>& records) {
+    os << "{\n"
+       << "  \"environment\": {\n"
+       << "    \"cpu\": " << jsonString(environment.cpuModel) << ",\n"
+       << "    \"compiler\": " << jsonString(environment.compiler) << ",\n"
+       << "    \"flags\": " << jsonString(environment.flags) << ",\n"
+       << "    \"isa\": " << jsonString(environment.isa) << ",\n"
+       << "    \"hardware_threads\": " << environment.hardwareThreads << ",\n"
+       << "    \"peak_gflops\": " << jsonNumber(environment.roofline.peakGflops) << ",\n"
+       << "    \"bandwidth_gb_per_s\": " << jsonNumber(environment.roofline.bandwidthGBs) << ",\n"
+       << "    \"timestamp\": " << jsonString(environment.timestamp) << "\n"
+       << "  },\n"
+       << "  \"benchmarks\": [";
+    for (size_t i = 0; i < records.size(); ++i) {
+        const BenchmarkRecord& record = records[i];
+        const BenchmarkStats& stats = record.stats;
+        os << (i ? "," : "") << "\n    {"
+           << "\"name\": " << jsonString(stats.name)
+           << ", \"operation\": " << jsonString(record.operation)
+           << ", \"rows\": " << record.rows
+           << ", \"cols\": " << record.cols
+           << ", \"dtype\": " << jsonString(record.dtype)
+           << ", \"threads\": " << record.threads
+           << ", \"isa\": " << jsonString(environment.isa)
+           << ", \"samples\": " << stats.samples
+           << ", \"iterations_per_sample\": " << stats.iterationsPerSample
+           << ", \"min_ms\": " << jsonNumber(stats.minMs)
+           << ", \"median_ms\": " << jsonNumber(stats.medianMs)
+           << ", \"mean_ms\": " << jsonNumber(stats.meanMs)
+           << ", \"p95_ms\": " << jsonNumber(stats.p95Ms)
+           << ", \"max_ms\": " << jsonNumber(stats.maxMs)
+           << ", \"stddev_ms\": " << jsonNumber(stats.stddevMs)
+           << ", \"ci95_ms\": " << jsonNumber(stats.ciHalfWidthMs)
+           << ", \"converged\": " << (stats.converged ? "true" : "false")
+           << ", \"flops\": " << jsonNumber(record.flops)
+           << ", \"bytes\": " << jsonNumber(record.bytes)
+           << ", \"gflops\": " << jsonNumber(record.gflops())
+           << ", \"gb_per_s\": " << jsonNumber(record.gbPerSecond())
+           << ", \"arithmetic_intensity\": " << jsonNumber(record.arithmeticIntensity())
+           << ", \"roofline_pct\": " << jsonNumber(record.rooflinePercent(environment.roofline))
+           << ", \"cycles\": " << jsonNumber(record.profile.cycles)
+           << ", \"instructions\": " << jsonNumber(record.profile.instructions)
+           << ", \"cache_misses\": " << jsonNumber(record.profile.cacheMisses)
+           << ", \"fp_ops\": " << jsonNumber(record.profile.fpOps)
+           << ", \"allocations\": " << jsonNumber(record.profile.allocations)
+           << ", \"allocated_bytes\": " << jsonNumber(record.profile.allocatedBytes)
+           << ", \"peak_rss_bytes\": " << record.profile.peakRssBytes
+           << "}";
+    }
+    os << "\n  ]\n}\n";
+}
+
+void BenchmarkReport::writeCSV(std::ostream& os, const BenchmarkEnvironment& environment,
+                               const std::vector<BenchmarkRecord>& records) {
+    os << "name,operation,rows,cols,dtype,threads,isa,samples,iterations_per_sample,"
+       << "min_ms,median_ms,mean_ms,p95_ms,max_ms,stddev_ms,ci95_ms,converged,"
+       << "gflops,gb_per_s,arithmetic_intensity,roofline_pct,cycles,instructions,cache_misses,fp_ops,"
+       << "allocations,allocated_bytes,peak_rss_bytes,cpu,compiler,flags,timestamp\n";
+    for (const BenchmarkRecord& record : records) {
+        const BenchmarkStats& stats = record.stats;
+        os << csvField(stats.name) << ',' << record.operation << ',' << record.rows << ',' << record.cols << ','
+           << record.dtype << ',' << record.threads << ',' << environment.isa << ','
+           << stats.samples << ',' << stats.iterationsPerSample << ','
+           << csvNumber(stats.minMs) << ',' << csvNumber(stats.medianMs) << ',' << csvNumber(stats.meanMs) << ','
+           << csvNumber(stats.p95Ms) << ',' << csvNumber(stats.maxMs) << ',' << csvNumber(stats.stddevMs) << ','
+           << csvNumber(stats.ciHalfWidthMs) << ',' << (stats.converged ? "true" : "false") << ','
+           << csvNumber(record.gflops()) << ',' << csvNumber(record.gbPerSecond()) << ','
+           << csvNumber(record.arithmeticIntensity()) << ',' << csvNumber(record.rooflinePercent(environment.roofline)) << ','
+           << csvNumber(record.profile.cycles) << ',' << csvNumber(record.profile.instructions) << ','
+           << csvNumber(record.profile.cacheMisses) << ',' << csvNumber(record.profile.fpOps) << ','
+           << csvNumber(record.profile.allocations) << ',' << csvNumber(record.profile.allocatedBytes) << ','
+           << record.profile.peakRssBytes << ','
+           << csvField(environment.cpuModel) << ',' << csvField(environment.compiler) << ','
+           << csvField(environment.flags) << ',' << environment.timestamp << '\n';
+    }
+}
+
+template<typename Writer>
+static void writeToPath(const std::string& path, Writer&& writer) {
+    if (path == "-") {
+        writer(std::cout);
+        std::cout.flush();
+        return;
+    }
+    std::ofstream file(path);
+    if (!file) {
+        throw std::runtime_error("Cannot open '" + path + "' for writing");
+    }
+    writer(file);
+    if (!file) {
+        throw std::runtime_error("Failed writing '" + path + "'");
+    }
+}
+
+void BenchmarkReport::writeJSON(const std::string& path, const BenchmarkEnvironment& environment,
+                                const std::vector<BenchmarkRecord>& records) {
+    writeToPath(path, [&](std::ostream& os) { writeJSON(os, environment, records); });
+}
+
+void BenchmarkReport::writeCSV(const std::string& path, const BenchmarkEnvironment& environment,
+                               const std::vector<BenchmarkRecord>& records) {
+    writeToPath(path, [&](std::ostream& os) { writeCSV(os, environment, records); });
+}
+
+// ---------------------------------------------------------------------------
+// Reader: just enough JSON for files written by writeJSON
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct JsonValue {
+    enum Type { Null, Boolean, Number, String, Array, Object } type = Null;
+    bool boolean = false;
+    double number = 0.0;
+    std::string string;
+    std::vector<JsonValue> items;          // Array elements / object values
+    std::vector<std::string> keys;         // Object keys, parallel to items
+
+    const JsonValue* find(const std::string& key) const {
+        for (size_t i = 0; i < keys.size(); ++i) {
+            if (keys[i] == key) return &items[i];
+        }
+        return nullptr;
+    }
+};
+
+class JsonParser {
+private:
+    const std::string& text;
+    size_t pos = 0;
+
+    [[noreturn]] void fail(const std::string& what) const {
+        throw std::runtime_error("Invalid benchmark JSON at offset " + std::to_string(pos) + ": " + what);
+    }
+
+    void skipSpace() {
+        while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) ++pos;
+    }
+
+    void expect(char c) {
+        skipSpace();
+        if (pos >= text.size() || text[pos] != c) fail(std::string("expected '") + c + "'");
+        ++pos;
+    }
+
+    bool consume(const char* literal) {
+        const size_t length = std::char_traits<char>::length(literal);
+        if (text.compare(pos, length, literal) != 0) return false;
+        pos += length;
+        return true;
+    }
+
+    bool consumeComma() {
+        skipSpace();
+        if (pos >= text.size() || text[pos] != ',') return false;
+        ++pos;
+        return true;
+    }
+
+    std::string parseString() {
+        expect('"');
+        std::string out;
+        while (pos < text.size() && text[pos] != '"') {
+            char c = text[pos++];
+            if (c == '\\') {
+                if (pos >= text.size()) fail("unterminated escape");
+                const char escaped = text[pos++];
+                switch (escaped) {
+                    case 'n': c = '\n'; break;
+                    case 't': c = '\t'; break;
+                    case 'r': c = '\r'; break;
+                    case 'b': c = '\b'; break;
+                    case 'f': c = '\f'; break;
+                    case 'u':
+                        if (pos + 4 > text.size()) fail("short \\u escape");
+                        c = static_cast<char>(std::stoi(text.substr(pos, 4), nullptr, 16));  // ASCII only
+                        pos += 4;
+                        break;
+                    default: c = escaped;
+                }
+            }
+            out += c;
+        }
+        if (pos >= text.size()) fail("unterminated string");
+        ++pos;
+        return out;
+    }
+
+public:
+    explicit JsonParser(const std::string& source) : text(source) {}
+
+    JsonValue parse() {
+        JsonValue value;
+        skipSpace();
+        if (pos >= text.size()) fail("unexpected end");
+
+        const char c = text[pos];
+        if (c == '{') {
+            ++pos;
+            value.type = JsonValue::Object;
+            skipSpace();
+            if (pos < text.size() && text[pos] == '}') { ++pos; return value; }
+            for (;;) {
+                value.keys.push_back(parseString());
+                expect(':');
+                value.items.push_back(parse());
+                if (!consumeComma()) break;
+            }
+            expect('}');
+        } else if (c == '[') {
+            ++pos;
+            value.type = JsonValue::Array;
+            skipSpace();
+            if (pos < text.size() && text[pos] == ']') { ++pos; return value; }
+            for (;;) {
+                value.items.push_back(parse());
+                if (!consumeComma()) break;
+            }
+            expect(']');
+        } else if (c == '"') {
+            value.type = JsonValue::String;
+            value.string = parseString();
+        } else if (consume("true")) {
+            value.type = JsonValue::Boolean;
+            value.boolean = true;
+        } else if (consume("false")) {
+            value.type = JsonValue::Boolean;
+        } else if (consume("null")) {
+            value.type = JsonValue::Null;
+        } else {
+            const char* begin = text.c_str() + pos;
+            char* end = nullptr;
+            value.type = JsonValue::Number;
+            value.number = std::strtod(begin, &end);
+            if (end == begin) fail("unexpected character");
+            pos += static_cast<size_t>(end - begin);
+        }
+        return value;
+    }
+};
+
+double numberField(const JsonValue& object, const std::string& key) {
+    const JsonValue* value = object.find(key);
+    if (!value) throw std::runtime_error("Benchmark JSON record is missing \"" + key + "\"");
+    return value->type == JsonValue::Number ? value->number : std::numeric_limits<double>::quiet_NaN();
+}
+
+std::string stringField(const JsonValue& object, const std::string& key) {
+    const JsonValue* value = object.find(key);
+    if (!value || value->type != JsonValue::String) {
+        throw std::runtime_error("Benchmark JSON record is missing \"" + key + "\"");
+    }
+    return value->string;
+}
+
+}  // namespace
+
+std::vector<BenchmarkRecord> BenchmarkReport::readJSON(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("Cannot open baseline '" + path + "'");
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    const std::string text = buffer.str();
+
+    const JsonValue root = JsonParser(text).parse();
+    const JsonValue* benchmarks = root.find("benchmarks");
+    if (!benchmarks || benchmarks->type != JsonValue::Array) {
+        throw std::runtime_error("'" + path + "' has no \"benchmarks\" array");
+    }
+
+    std::vector<BenchmarkRecord> records;
+    for (const JsonValue& entry : benchmarks->items) {
+        BenchmarkRecord record;
+        record.operation = stringField(entry, "operation");
+        record.rows = static_cast<size_t>(numberField(entry, "rows"));
+        record.cols = static_cast<size_t>(numberField(entry, "cols"));
+        record.dtype = stringField(entry, "dtype");
+        record.threads = static_cast<unsigned>(numberField(entry, "threads"));
+        record.flops = numberField(entry, "flops");
+        record.bytes = numberField(entry, "bytes");
+
+        BenchmarkStats& stats = record.stats;
+        stats.name = stringField(entry, "name");
+        stats.samples = static_cast<size_t>(numberField(entry, "samples"));
+        stats.iterationsPerSample = static_cast<size_t>(numberField(entry, "iterations_per_sample"));
+        stats.minMs = numberField(entry, "min_ms");
+        stats.medianMs = numberField(entry, "median_ms");
+        stats.meanMs = numberField(entry, "mean_ms");
+        stats.p95Ms = numberField(entry, "p95_ms");
+        stats.maxMs = numberField(entry, "max_ms");
+        stats.stddevMs = numberField(entry, "stddev_ms");
+        stats.ciHalfWidthMs = numberField(entry, "ci95_ms");
+        const JsonValue* converged = entry.find("converged");
+        stats.converged = converged && converged->boolean;
+        records.push_back(record);
+    }
+    return records;
+}
+
+// ---------------------------------------------------------------------------
+// Comparison
+// ---------------------------------------------------------------------------
+
+std::vector<BenchmarkComparison> BenchmarkReport::compare(const std::vector<BenchmarkRecord>& baseline,
+                                                          const std::vector<BenchmarkRecord>& current,
+                                                          double threshold) {
+    std::map<std::string, const BenchmarkRecord*> byKey;
+    for (const BenchmarkRecord& record : baseline) byKey[record.key()] = &record;
+
+    std::vector<BenchmarkComparison> comparisons;
+    for (const BenchmarkRecord& record : current) {
+        const auto found = byKey.find(record.key());
+        if (found == byKey.end()) continue;
+        const BenchmarkStats& before = found->second->stats;
+        const BenchmarkStats& after = record.stats;
+
+        BenchmarkComparison comparison;
+        comparison.key = record.key();
+        comparison.baselineMs = before.medianMs;
+        comparison.currentMs = after.medianMs;
+        comparison.ratio = before.medianMs > 0.0 ? after.medianMs / before.medianMs : 1.0;
+
+        // Welch's t-test on the sample means
+        if (before.samples > 1 && after.samples > 1) {
+            const double varianceBefore = before.stddevMs * before.stddevMs / static_cast<double>(before.samples);
+            const double varianceAfter = after.stddevMs * after.stddevMs / static_cast<double>(after.samples);
+            const double standardError = std::sqrt(varianceBefore + varianceAfter);
+            if (standardError > 0.0) {
+                const double t = (after.meanMs - before.meanMs) / standardError;
+                const double degreesOfFreedom = (varianceBefore + varianceAfter) * (varianceBefore + varianceAfter) /
+                    (varianceBefore * varianceBefore / static_cast<double>(before.samples - 1) +
+                     varianceAfter * varianceAfter / static_cast<double>(after.samples - 1));
+                comparison.significant = std::abs(t) > BenchmarkHarness::studentT95(degreesOfFreedom);
+            } else {
+                comparison.significant = after.meanMs != before.meanMs;
+            }
+        }
+
+        comparison.regression = comparison.significant && comparison.ratio > 1.0 + threshold;
+        comparison.improvement = comparison.significant && comparison.ratio < 1.0 - threshold;
+        comparisons.push_back(comparison);
+    }
+    return comparisons;
+}
+
+size_t BenchmarkReport::printComparison(const std::vector<BenchmarkComparison>& comparisons, std::ostream& os) {
+    const std::ios::fmtflags flags = os.flags();
+    const std::streamsize precision = os.precision();
+
+    size_t regressions = 0;
+    os << std::left << std::setw(36) << "Benchmark" << std::right << std::setw(14) << "Baseline ms"
+       << std::setw(14) << "Current ms" << std::setw(10) << "Change" << "  Verdict\n";
+    for (const BenchmarkComparison& comparison : comparisons) {
+        const char* verdict = comparison.regression ? "REGRESSION"
+                            : comparison.improvement ? "improved"
+                            : comparison.significant ? "within threshold"
+                            : "no significant change";
+        if (comparison.regression) ++regressions;
+        os << std::left << std::setw(36) << comparison.key << std::right << std::fixed
+           << std::setprecision(comparison.baselineMs < 1.0 ? 6 : 3)
+           << std::setw(14) << comparison.baselineMs << std::setw(14) << comparison.currentMs
+           << std::setprecision(1) << std::showpos << std::setw(9) << (comparison.ratio - 1.0) * 100.0 << "%"
+           << std::noshowpos << "  " << verdict << "\n";
+    }
+    os << comparisons.size() << " compared, " << regressions << " regression(s)" << std::endl;
+
+    os.flags(flags);
+    os.precision(precision);
+    return regressions;
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include "BenchmarkHarness.h"
+#include "HardwareCounters.h"
+#include <iostream>
+#include <string>
+#include <vector>
+
+// One measured benchmark with enough context to compare it across builds
+// and machines. flops and bytes are per call (0 when not meaningful); bytes
+// is the minimum memory traffic, so gbPerSecond is effective bandwidth.
+struct BenchmarkRecord {
+    std::string operation;   // Short kernel name, e.g. "gemm", "lu", "dot"
+    size_t rows = 0;
+    size_t cols = 0;
+    std::string dtype = "double";
+    unsigned threads = 1;
+    double flops = 0.0;
+    double bytes = 0.0;
+    BenchmarkStats stats;
+    KernelProfile profile;   // Hardware counters, allocations and RSS per call
+
+    // Identifies the same benchmark in a baseline: operation/shape/dtype/threads
+    std::string key() const;
+
+    double gflops() const { return stats.medianMs > 0.0 ? flops / (stats.medianMs * 1e6) : 0.0; }
+    double gbPerSecond() const { return stats.medianMs > 0.0 ? bytes / (stats.medianMs * 1e6) : 0.0; }
+    double arithmeticIntensity() const { return bytes > 0.0 ? flops / bytes : 0.0; }  // flop/byte
+    // Achieved GFLOPS as a percentage of the roofline bound at this intensity
+    double rooflinePercent(const RooflineModel& roofline) const;
+};
+
+// Build and host description written alongside the records
+struct BenchmarkEnvironment {
+    std::string cpuModel;
+    std::string compiler;
+    std::string flags;       // Compiler flags passed by the Makefile
+    std::string isa;         // Vector extensions the build was compiled for
+    unsigned hardwareThreads = 0;
+    RooflineModel roofline;  // Left at zero unless measured (RooflineModel::host())
+    std::string timestamp;   // UTC, ISO 8601
+
+    static BenchmarkEnvironment detect();
+};
+
+// Result of comparing one benchmark with its baseline. A change is
+// significant when Welch's t-test rejects equal means at 95%; it is a
+// regression when it is also slower than the baseline by more than the
+// threshold (relative, on the median).
+struct BenchmarkComparison {
+    std::string key;
+    double baselineMs = 0.0;
+    double currentMs = 0.0;
+    double ratio = 1.0;      // current / baseline median
+    bool significant = false;
+    bool regression = false;
+    bool improvement = false;
+};
+
+// JSON / CSV output of benchmark records and baseline comparison
+class BenchmarkReport {
+public:
+    static void writeJSON(std::ostream& os, const BenchmarkEnvironment& environment,
+                          const std::vector<BenchmarkRecord>& records);
+    static void writeCSV(std::ostream& os, const BenchmarkEnvironment& environment,
+                         const std::vector<BenchmarkRecord>& records);
+
+    // Path-based variants; "-" writes to stdout
+    static void writeJSON(const std::string& path, const BenchmarkEnvironment& environment,
+                          const std::vector<BenchmarkRecord>& records);
+    static void writeCSV(const std::string& path, const BenchmarkEnvironment& environment,
+                         const std::vector<BenchmarkRecord>& records);
+
+    // Reads the records of a file written by writeJSON (raw samples are not
+    // stored, so stats.sampleMs is empty)
+    static std::vector<BenchmarkRecord> readJSON(const std::string& path);
+
+    // Compares every current record that has a baseline with the same key
+    static std::vector<BenchmarkComparison> compare(const std::vector<BenchmarkRecord>& baseline,
+                                                    const std::vector<BenchmarkRecord>& current,
+                                                    double threshold = 0.05);
+
+    // Prints the comparison table; returns the number of regressions
+    static size_t printComparison(const std::vector<BenchmarkComparison>& comparisons,
+                                  std::ostream& os = std::cout);
+};
@@ -0,0 +1,53 @@
+#include "Checksum.h"
+#include <algorithm>
+#include <cstring>
+
+inline Checksum64::Checksum64() : pendingSize(0), totalSize(0) {
+    lanes[0] = P1 + P2;
+    lanes[1] = P2;
+    lanes[2] = 0;
+    lanes[3] = 0 - P1;
+}
+
+inline void Checksum64::block(const uint8_t* bytes) {
+    for (int lane = 0; lane < 4; ++lane) {
+        uint64_t word;
+        std::memcpy(&word, bytes + 8 * lane, 8);
+        lanes[lane] = rotl(lanes[lane] + word * P2, 31) * P1;
+    }
+}
+
+inline void Checksum64::update(const void* input, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(input);
+    totalSize += size;
+
+    if (pendingSize > 0) {
+        const size_t take = std::min(size, sizeof(pending) - pendingSize);
+        std::memcpy(pending + pendingSize, bytes, take);
+        pendingSize += take;
+        bytes += take;
+        size -= take;
+        if (pendingSize < sizeof(pending)) return;
+        block(pending);
+        pendingSize = 0;
+    }
+    for (; size >= 32; bytes += 32, size -= 32) {
+        block(bytes);
+    }
+    std::memcpy(pending, bytes, size);
+    pendingSize = size;
+}
+
+inline uint64_t Checksum64::digest() const {
+    uint64_t hash = rotl(lanes[0], 1) + rotl(lanes[1], 7) + rotl(lanes[2], 12) + rotl(lanes[3], 18);
+    hash += totalSize;
+    for (size_t i = 0; i < pendingSize; ++i) {
+        hash = rotl(hash ^ (pending[i] * P3), 11) * P1;
+    }
+    hash ^= hash >> 33;
+    hash *= P2;
+    hash ^= hash >> 29;
+    hash *= P3;
+    hash ^= hash >> 32;
+    return hash;
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Streaming 64-bit checksum over 32-byte blocks (four independent
+// multiply-rotate lanes, so it runs at memory bandwidth rather than the
+// byte-at-a-time speed of FNV or CRC tables). Used for the payload check of
+// binary matrix files (MatrixIO.h) and the content keys of
+// FactorizationCache; the digest is part of the file format and must not
+// change.
+class Checksum64 {
+private:
+    uint64_t lanes[4];
+    uint8_t pending[32];
+    size_t pendingSize;
+    uint64_t totalSize;
+
+    static constexpr uint64_t P1 = 0x9E3779B185EBCA87ull;
+    static constexpr uint64_t P2 = 0xC2B2AE3D27D4EB4Full;
+    static constexpr uint64_t P3 = 0x165667B19E3779F9ull;
+
+    static uint64_t rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+    void block(const uint8_t* bytes);
+
+public:
+    Checksum64();
+    void update(const void* bytes, size_t size);
+    uint64_t digest() const;
+};
+
+#include "Checksum.cpp"  // Include implementation (header-only library)
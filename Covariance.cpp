@@ -0,0 +1,148 @@
+#include "Covariance.h"
+#include <stdexcept>
+#include <thread>
+
+template<typename T>
+CovarianceAccumulator<T>::CovarianceAccumulator(size_t features) : dimension(0), observations(0) {
+    setWidth(features);
+}
+
+template<typename T>
+void CovarianceAccumulator<T>::setWidth(size_t features) {
+    dimension = features;
+    means.assign(features, T(0));
+    scatter = Matrix<T>(features, features);
+}
+
+template<typename T>
+void CovarianceAccumulator<T>::reset() {
+    observations = 0;
+    std::fill(means.begin(), means.end(), T(0));
+    scatter.fill(T(0));
+}
+
+template<typename T>
+void CovarianceAccumulator<T>::add(const Matrix<T>& X) {
+    add(X, 0, X.getRows());
+}
+
+template<typename T>
+void CovarianceAccumulator<T>::add(const Matrix<T>& X, size_t rowBegin, size_t rowEnd) {
+    LINALG_PROFILE("CovarianceAccumulator::add", rowEnd - rowBegin, X.getCols(),
+                   double(rowEnd - rowBegin) * X.getCols() * (X.getCols() + 1));
+    if (rowBegin > rowEnd || rowEnd > X.getRows()) {
+        throw std::out_of_range("Row range exceeds matrix bounds");
+    }
+    if (dimension == 0 && observations == 0) setWidth(X.getCols());
+    if (X.getCols() != dimension) {
+        throw std::invalid_argument("Observation width does not match the covariance accumulator");
+    }
+    const size_t n = rowEnd - rowBegin;
+    if (n == 0) return;
+
+    // Above the parallel threshold, contiguous row ranges go to partial
+    // accumulators on separate threads, each running a serial herk
+    const KernelTuning& tuning = Tuning::parameters<T>();
+    unsigned workers = tuning.threads ? tuning.threads : std::thread::hardware_concurrency();
+    workers = static_cast<unsigned>(std::min<size_t>(workers, n / BLOCK_ROWS));
+    const double flops = double(n) * dimension * (dimension + 1);
+    if (tuning.parallelMinFlops <= 0.0 || flops < tuning.parallelMinFlops || workers < 2) {
+        addRows(X, rowBegin, rowEnd, 0);
+        return;
+    }
+    std::vector<CovarianceAccumulator<T>> partial(workers, CovarianceAccumulator<T>(dimension));
+    std::vector<std::thread> threads;
+    threads.reserve(workers);
+    const size_t chunk = (n + workers - 1) / workers;
+    for (unsigned w = 0; w < workers; ++w) {
+        const size_t begin = rowBegin + std::min(n, w * chunk);
+        const size_t end = rowBegin + std::min(n, (w + 1) * chunk);
+        threads.emplace_back([&partial, &X, w, begin, end]() {
+            LINALG_PROFILE("CovarianceAccumulator::worker", end - begin, X.getCols());
+            partial[w].addRows(X, begin, end, 1);
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+    for (const CovarianceAccumulator<T>& part : partial) merge(part);
+}
+
+template<typename T>
+void CovarianceAccumulator<T>::addRows(const Matrix<T>& X, size_t rowBegin, size_t rowEnd, unsigned kernelThreads) {
+    std::vector<T> blockMean(dimension);
+    for (size_t b0 = rowBegin; b0 < rowEnd; b0 += BLOCK_ROWS) {
+        const size_t b1 = std::min(b0 + BLOCK_ROWS, rowEnd);
+        const size_t count = b1 - b0;
+
+        std::fill(blockMean.begin(), blockMean.end(), T(0));
+        for (size_t i = b0; i < b1; ++i) {
+            const T* x = X.data[i].data();
+            for (size_t j = 0; j < dimension; ++j) blockMean[j] += x[j];
+        }
+        for (T& value : blockMean) value /= T(count);
+
+        if (centered.getRows() < count || centered.getCols() != dimension) {
+            centered = Matrix<T>(std::min(BLOCK_ROWS, rowEnd - rowBegin), dimension);
+        }
+        for (size_t i = b0; i < b1; ++i) {
+            const T* x = X.data[i].data();
+            T* c = centered.data[i - b0].data();
+            for (size_t j = 0; j < dimension; ++j) c[j] = x[j] - blockMean[j];
+        }
+        Matrix<T>::rankK(TriangleType::Upper, TransposeType::Transpose, true, dimension, count, T(1),
+                         centered, 0, 0, scatter, 0, 0, kernelThreads);
+        combine(count, blockMean);
+    }
+}
+
+// Chan, Golub and LeVeque: with n = n_a + n_b and delta = mean_b - mean_a,
+//   mean    = mean_a + delta * n_b / n
+//   scatter = scatter_a + scatter_b + delta^H delta * n_a * n_b / n
+template<typename T>
+void CovarianceAccumulator<T>::combine(size_t count, const std::vector<T>& otherMean) {
+    const size_t total = observations + count;
+    if (observations > 0) {
+        const T weight = T(double(observations) * double(count) / double(total));
+        std::vector<T> delta(dimension);
+        for (size_t j = 0; j < dimension; ++j) delta[j] = otherMean[j] - means[j];
+        for (size_t i = 0; i < dimension; ++i) {
+            const T scale = weight * matrix_detail::conjugate(delta[i]);
+            T* row = scatter.data[i].data();
+            for (size_t j = i; j < dimension; ++j) row[j] += scale * delta[j];
+        }
+        const T fraction = T(double(count) / double(total));
+        for (size_t j = 0; j < dimension; ++j) means[j] += delta[j] * fraction;
+    } else {
+        means = otherMean;
+    }
+    observations = total;
+}
+
+template<typename T>
+void CovarianceAccumulator<T>::merge(const CovarianceAccumulator& other) {
+    if (other.observations == 0) return;
+    if (dimension == 0 && observations == 0) setWidth(other.dimension);
+    if (other.dimension != dimension) {
+        throw std::invalid_argument("Observation width does not match the covariance accumulator");
+    }
+    for (size_t i = 0; i < dimension; ++i) {
+        for (size_t j = i; j < dimension; ++j) scatter.data[i][j] += other.scatter.data[i][j];
+    }
+    combine(other.observations, other.means);
+}
+
+template<typename T>
+Matrix<T> CovarianceAccumulator<T>::covariance(size_t ddof) const {
+    if (observations <= ddof) {
+        throw std::runtime_error("Covariance needs more observations than ddof");
+    }
+    const T scale = T(1.0 / double(observations - ddof));
+    Matrix<T> result(dimension, dimension);
+    for (size_t i = 0; i < dimension; ++i) {
+        result.data[i][i] = T(std::real(scatter.data[i][i])) * scale;
+        for (size_t j = i + 1; j < dimension; ++j) {
+            result.data[i][j] = scatter.data[i][j] * scale;
+            result.data[j][i] = matrix_detail::conjugate(result.data[i][j]);
+        }
+    }
+    return result;
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include "Matrix.h"
+#include <vector>
+
+// Streaming covariance of observations (rows) that arrive in blocks, for
+// data sets too large to hold at once: feed row blocks from a reader or a
+// tile store and read the covariance at the end. Matrix<T>::covariance()
+// runs one accumulator over a whole matrix.
+//
+// Every block of up to BLOCK_ROWS observations is centered on its own mean
+// while it is copied into a workspace, and its scatter matrix is added to
+// the upper triangle by herk. The block's mean and scatter are then combined
+// with the running ones by the pairwise update of Chan, Golub and LeVeque,
+// which stays accurate when the mean is large compared to the spread. Large
+// inputs are split across threads into partial accumulators that are merged
+// the same way.
+template<typename T = double>
+class CovarianceAccumulator {
+public:
+    static constexpr size_t BLOCK_ROWS = 256;  // Observations centered per herk call
+
+private:
+    size_t dimension;      // Features per observation
+    size_t observations;
+    std::vector<T> means;
+    Matrix<T> scatter;     // Sum of (x - mean)^H (x - mean); upper triangle only
+    Matrix<T> centered;    // Workspace for one centered block
+
+public:
+    // With features == 0 the width is taken from the first block added
+    explicit CovarianceAccumulator(size_t features = 0);
+
+    // Adds rows [rowBegin, rowEnd) of X (all rows by default) as observations
+    void add(const Matrix<T>& X);
+    void add(const Matrix<T>& X, size_t rowBegin, size_t rowEnd);
+    // Adds the observations of another accumulator of the same width
+    void merge(const CovarianceAccumulator& other);
+    void reset();
+
+    size_t features() const { return dimension; }
+    size_t count() const { return observations; }
+    const std::vector<T>& mean() const { return means; }
+    // Scatter divided by count() - ddof (1: sample, 0: population covariance),
+    // with both triangles filled
+    Matrix<T> covariance(size_t ddof = 1) const;
+
+private:
+    void setWidth(size_t features);
+    // Blocks of [rowBegin, rowEnd) on this thread; herk on `kernelThreads`
+    // threads (0 = from the tuning)
+    void addRows(const Matrix<T>& X, size_t rowBegin, size_t rowEnd, unsigned kernelThreads);
+    // Folds in `count` observations with the given mean whose scatter has
+    // already been added
+    void combine(size_t count, const std::vector<T>& otherMean);
+};
+
+#include "Covariance.cpp"  // Include implementation for template class
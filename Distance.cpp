@@ -0,0 +1,297 @@
+#include "Distance.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+
+namespace distance_detail {
+
+// Heap order: a comes before b when it is nearer (lower index on ties), so
+// std::push_heap keeps the farthest kept neighbor at the front
+template<typename T>
+bool nearer(const Neighbor<T>& a, const Neighbor<T>& b) {
+    return a.distance < b.distance || (a.distance == b.distance && a.index < b.index);
+}
+
+// Keeps the k nearest candidates offered to `heap`
+template<typename T>
+void offer(std::vector<Neighbor<T>>& heap, size_t k, const Neighbor<T>& candidate) {
+    if (heap.size() < k) {
+        heap.push_back(candidate);
+        std::push_heap(heap.begin(), heap.end(), nearer<T>);
+    } else if (nearer(candidate, heap.front())) {
+        std::pop_heap(heap.begin(), heap.end(), nearer<T>);
+        heap.back() = candidate;
+        std::push_heap(heap.begin(), heap.end(), nearer<T>);
+    }
+}
+
+// Reallocate only when the shape changes
+template<typename T>
+void ensureSize(Matrix<T>& target, size_t rows, size_t cols) {
+    if (target.getRows() != rows || target.getCols() != cols) {
+        target = Matrix<T>(rows, cols);
+    }
+}
+
+}  // namespace distance_detail
+
+template<typename T>
+PointSet<T>::PointSet(Matrix<T> pointRows, DistanceMetric distanceMetric)
+    : points(std::move(pointRows)), metric(distanceMetric) {
+    if (metric != DistanceMetric::Euclidean && metric != DistanceMetric::SquaredEuclidean &&
+        metric != DistanceMetric::Cosine) {
+        return;
+    }
+    norms.resize(points.getRows());
+    for (size_t i = 0; i < points.getRows(); ++i) {
+        const std::vector<T>& row = points.data[i];
+        T sum = T(0);
+        for (const T& value : row) sum += value * value;
+        if (metric == DistanceMetric::Cosine) {
+            sum = std::sqrt(sum);
+            if (sum == T(0)) {
+                throw std::invalid_argument("Cosine distance is undefined for a zero vector");
+            }
+        }
+        norms[i] = sum;
+    }
+}
+
+template<typename T>
+PointSet<T>::PointSet(const std::vector<Vector<T>>& pointVectors, DistanceMetric distanceMetric)
+    : PointSet(toMatrix(pointVectors), distanceMetric) {}
+
+template<typename T>
+Matrix<T> PointSet<T>::toMatrix(const std::vector<Vector<T>>& vectors) {
+    const size_t d = vectors.empty() ? 0 : vectors.front().size();
+    Matrix<T> result(vectors.size(), d);
+    for (size_t i = 0; i < vectors.size(); ++i) {
+        if (vectors[i].size() != d) {
+            throw std::invalid_argument("Points must all have the same dimension");
+        }
+        std::copy(vectors[i].begin(), vectors[i].end(), result.data[i].begin());
+    }
+    return result;
+}
+
+template<typename T>
+void PointSet<T>::checkQueries(const Matrix<T>& queries) const {
+    if (queries.getCols() != dimension() && queries.getRows() > 0) {
+        throw std::invalid_argument("Query dimension does not match the point set");
+    }
+    // Checked here because the worker threads cannot throw
+    if (metric == DistanceMetric::Cosine) {
+        for (size_t i = 0; i < queries.getRows(); ++i) {
+            const std::vector<T>& row = queries.data[i];
+            if (std::all_of(row.begin(), row.end(), [](const T& value) { return value == T(0); })) {
+                throw std::invalid_argument("Cosine distance is undefined for a zero vector");
+            }
+        }
+    }
+}
+
+// Threads for a batch of queries, from the gemm tuning
+template<typename T>
+unsigned PointSet<T>::workerCount(size_t queries) const {
+    const KernelTuning& tuning = Tuning::parameters<T>();
+    const double flops = 2.0 * queries * size() * dimension();
+    if (tuning.parallelMinFlops <= 0.0 || flops < tuning.parallelMinFlops) return 1;
+    const unsigned workers = tuning.threads ? tuning.threads : std::thread::hardware_concurrency();
+    return std::max(1u, workers);
+}
+
+template<typename T>
+void PointSet<T>::computeBlock(const Matrix<T>& queries, size_t q0, size_t q1, size_t p0, size_t p1,
+                               Matrix<T>& packedPoints, Matrix<T>& block) const {
+    const size_t nb = q1 - q0;
+    const size_t mb = p1 - p0;
+    const size_t d = dimension();
+
+    // Points of the block as columns, so gemm streams them along rows
+    distance_detail::ensureSize(packedPoints, d, POINT_BLOCK);
+    for (size_t j = 0; j < mb; ++j) {
+        const T* point = points.data[p0 + j].data();
+        for (size_t p = 0; p < d; ++p) packedPoints.data[p][j] = point[p];
+    }
+    distance_detail::ensureSize(block, nb, mb);
+    block.fill(T(0));
+    Matrix<T>::gemmThreads(nb, mb, d, T(1), queries, q0, 0, packedPoints, 0, 0, block, 0, 0, 1);
+
+    for (size_t i = 0; i < nb; ++i) {
+        T* out = block.data[i].data();
+        if (metric == DistanceMetric::InnerProduct) {
+            for (size_t j = 0; j < mb; ++j) out[j] = -out[j];
+            continue;
+        }
+        const std::vector<T>& query = queries.data[q0 + i];
+        T queryNorm = T(0);
+        for (const T& value : query) queryNorm += value * value;
+        if (metric == DistanceMetric::Cosine) {
+            queryNorm = std::sqrt(queryNorm);
+            for (size_t j = 0; j < mb; ++j) out[j] = T(1) - out[j] / (queryNorm * norms[p0 + j]);
+        } else {
+            for (size_t j = 0; j < mb; ++j) {
+                const T squared = std::max(T(0), queryNorm + norms[p0 + j] - T(2) * out[j]);
+                out[j] = metric == DistanceMetric::Euclidean ? std::sqrt(squared) : squared;
+            }
+        }
+    }
+}
+
+template<typename T>
+template<typename Visitor>
+void PointSet<T>::forEachBlock(const Matrix<T>& queries, Visitor&& visit) const {
+    checkQueries(queries);
+    const size_t nq = queries.getRows();
+    const size_t blocks = (nq + QUERY_BLOCK - 1) / QUERY_BLOCK;
+
+    auto visitBlocks = [&](size_t b0, size_t b1) {
+        Matrix<T> packedPoints, block;
+        for (size_t b = b0; b < b1; ++b) {
+            const size_t q0 = b * QUERY_BLOCK;
+            const size_t q1 = std::min(q0 + QUERY_BLOCK, nq);
+            for (size_t p0 = 0; p0 < size(); p0 += POINT_BLOCK) {
+                computeBlock(queries, q0, q1, p0, std::min(p0 + POINT_BLOCK, size()), packedPoints, block);
+                visit(q0, p0, static_cast<const Matrix<T>&>(block));
+            }
+        }
+    };
+
+    const size_t workers = std::min<size_t>(workerCount(nq), blocks);
+    if (workers < 2) {
+        visitBlocks(0, blocks);
+        return;
+    }
+    const size_t chunk = (blocks + workers - 1) / workers;
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    for (size_t begin = chunk; begin < blocks; begin += chunk) {
+        const size_t end = std::min(begin + chunk, blocks);
+        threads.emplace_back([&visitBlocks, begin, end]() {
+            LINALG_PROFILE("PointSet::worker", (end - begin) * QUERY_BLOCK, 0);
+            visitBlocks(begin, end);
+        });
+    }
+    visitBlocks(0, std::min(chunk, blocks));
+    for (std::thread& thread : threads) thread.join();
+}
+
+template<typename T>
+Matrix<T> PointSet<T>::distances(const Matrix<T>& queries) const {
+    LINALG_PROFILE("PointSet::distances", queries.getRows(), size(), 2.0 * queries.getRows() * size() * dimension());
+    Matrix<T> result(queries.getRows(), size());
+    forEachBlock(queries, [&result](size_t q0, size_t p0, const Matrix<T>& block) {
+        for (size_t i = 0; i < block.getRows(); ++i) {
+            std::copy(block.data[i].begin(), block.data[i].end(), result.data[q0 + i].begin() + p0);
+        }
+    });
+    return result;
+}
+
+template<typename T>
+Matrix<T> PointSet<T>::distances(const std::vector<Vector<T>>& queries) const {
+    return distances(toMatrix(queries));
+}
+
+template<typename T>
+void PointSet<T>::searchRange(const Matrix<T>& queries, size_t q0, size_t q1, size_t p0, size_t p1, size_t k,
+                              std::vector<std::vector<Neighbor<T>>>& heaps) const {
+    Matrix<T> packedPoints, block;
+    for (size_t qb = q0; qb < q1; qb += QUERY_BLOCK) {
+        const size_t qb_end = std::min(qb + QUERY_BLOCK, q1);
+        for (size_t pb = p0; pb < p1; pb += POINT_BLOCK) {
+            const size_t pb_end = std::min(pb + POINT_BLOCK, p1);
+            computeBlock(queries, qb, qb_end, pb, pb_end, packedPoints, block);
+            for (size_t i = 0; i < qb_end - qb; ++i) {
+                std::vector<Neighbor<T>>& heap = heaps[qb + i];
+                const T* row = block.data[i].data();
+                for (size_t j = 0; j < pb_end - pb; ++j) {
+                    distance_detail::offer(heap, k, Neighbor<T>{pb + j, row[j]});
+                }
+            }
+        }
+    }
+}
+
+// Large query batches are split across threads by query, so every query's
+// heap has a single owner. Small batches against many points are split by
+// point instead; each thread then keeps its own heaps for all queries and
+// they are merged at the end.
+template<typename T>
+std::vector<std::vector<Neighbor<T>>> PointSet<T>::nearest(const Matrix<T>& queries, size_t k) const {
+    LINALG_PROFILE("PointSet::nearest", queries.getRows(), size(), 2.0 * queries.getRows() * size() * dimension());
+    checkQueries(queries);
+    const size_t nq = queries.getRows();
+    const size_t m = size();
+    std::vector<std::vector<Neighbor<T>>> heaps(nq);
+    k = std::min(k, m);
+    if (k == 0) return heaps;
+    for (auto& heap : heaps) heap.reserve(k);
+
+    const unsigned workers = workerCount(nq);
+    const size_t queryBlocks = (nq + QUERY_BLOCK - 1) / QUERY_BLOCK;
+    const size_t pointBlocks = (m + POINT_BLOCK - 1) / POINT_BLOCK;
+    std::vector<std::thread> threads;
+    if (workers < 2 || (queryBlocks < workers && pointBlocks < 2)) {
+        searchRange(queries, 0, nq, 0, m, k, heaps);
+    } else if (queryBlocks >= workers) {
+        const size_t chunk = (queryBlocks + workers - 1) / workers * QUERY_BLOCK;
+        for (size_t begin = 0; begin < nq; begin += chunk) {
+            const size_t end = std::min(begin + chunk, nq);
+            threads.emplace_back([this, &queries, &heaps, begin, end, m, k]() {
+                LINALG_PROFILE("PointSet::worker", end - begin, m);
+                searchRange(queries, begin, end, 0, m, k, heaps);
+            });
+        }
+        for (std::thread& thread : threads) thread.join();
+    } else {
+        const size_t parts = std::min<size_t>(workers, pointBlocks);
+        const size_t chunk = (pointBlocks + parts - 1) / parts * POINT_BLOCK;
+        std::vector<std::vector<std::vector<Neighbor<T>>>> partial;
+        for (size_t begin = 0; begin < m; begin += chunk) partial.emplace_back(nq);
+        for (size_t part = 0; part < partial.size(); ++part) {
+            const size_t begin = part * chunk;
+            const size_t end = std::min(begin + chunk, m);
+            threads.emplace_back([this, &queries, &partial, part, begin, end, nq, k]() {
+                LINALG_PROFILE("PointSet::worker", nq, end - begin);
+                searchRange(queries, 0, nq, begin, end, k, partial[part]);
+            });
+        }
+        for (std::thread& thread : threads) thread.join();
+        for (const auto& local : partial) {
+            for (size_t q = 0; q < nq; ++q) {
+                for (const Neighbor<T>& candidate : local[q]) distance_detail::offer(heaps[q], k, candidate);
+            }
+        }
+    }
+
+    for (auto& heap : heaps) std::sort_heap(heap.begin(), heap.end(), distance_detail::nearer<T>);
+    return heaps;
+}
+
+template<typename T>
+std::vector<std::vector<Neighbor<T>>> PointSet<T>::nearest(const std::vector<Vector<T>>& queries, size_t k) const {
+    return nearest(toMatrix(queries), k);
+}
+
+template<typename T>
+std::vector<Neighbor<T>> PointSet<T>::nearest(const Vector<T>& query, size_t k) const {
+    return nearest(std::vector<Vector<T>>{query}, k).front();
+}
+
+template<typename T>
+Matrix<T> pairwiseDistances(const Matrix<T>& X, const Matrix<T>& Y, DistanceMetric metric) {
+    return PointSet<T>(Y, metric).distances(X);
+}
+
+template<typename T>
+Matrix<T> pairwiseDistances(const std::vector<Vector<T>>& X, const std::vector<Vector<T>>& Y, DistanceMetric metric) {
+    return PointSet<T>(Y, metric).distances(X);
+}
+
+template<typename T>
+std::vector<std::vector<Neighbor<T>>> nearestNeighbors(const Matrix<T>& queries, const Matrix<T>& points, size_t k,
+                                                       DistanceMetric metric) {
+    return PointSet<T>(points, metric).nearest(queries, k);
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include "Matrix.h"
+#include "Vector.h"
+#include <vector>
+
+// Batch distances between point sets and k-nearest-neighbor search.
+//
+// Distances come from the gemm expansion ||x - y||^2 = ||x||^2 + ||y||^2 -
+// 2 x.y: a block of queries is multiplied against a block of points by the
+// blocked gemm kernel and the block of inner products is turned into
+// distances with the cached norms. Vector<T>::distance does the same work
+// one pair at a time. Query blocks run on separate threads; the search
+// keeps a bounded heap per query and never holds more than one block of
+// distances per thread, so the full queries x points matrix is never formed.
+//
+// Every metric is a distance in the sense that smaller means nearer, so the
+// inner product metric is its negation. Squared Euclidean distances are
+// clamped at zero, since the expansion can round a tiny distance below it.
+enum class DistanceMetric {
+    Euclidean,         // ||x - y||
+    SquaredEuclidean,  // ||x - y||^2
+    Cosine,            // 1 - x.y / (||x|| ||y||)
+    InnerProduct       // -x.y
+};
+
+template<typename T>
+struct Neighbor {
+    size_t index;  // Row of the point in the PointSet
+    T distance;
+};
+
+// Stored points (rows) with their norms, searched by many query batches
+template<typename T = double>
+class PointSet {
+public:
+    static constexpr size_t QUERY_BLOCK = 256;   // Queries per gemm block
+    static constexpr size_t POINT_BLOCK = 1024;  // Points per gemm block
+
+private:
+    Matrix<T> points;
+    DistanceMetric metric;
+    std::vector<T> norms;  // Squared norms (Euclidean), norms (Cosine), unused otherwise
+
+public:
+    explicit PointSet(Matrix<T> points, DistanceMetric metric = DistanceMetric::Euclidean);
+    explicit PointSet(const std::vector<Vector<T>>& points, DistanceMetric metric = DistanceMetric::Euclidean);
+
+    size_t size() const { return points.getRows(); }
+    size_t dimension() const { return points.getCols(); }
+    DistanceMetric getMetric() const { return metric; }
+
+    // Full queries x points distance matrix (rows of `queries` are queries)
+    Matrix<T> distances(const Matrix<T>& queries) const;
+    Matrix<T> distances(const std::vector<Vector<T>>& queries) const;
+
+    // Hands the distance matrix over block by block without storing it:
+    // visit(queryBegin, pointBegin, block), where block holds the distances
+    // of up to QUERY_BLOCK queries (rows) to up to POINT_BLOCK points
+    // (columns) and is only valid during the call. Different query blocks
+    // are visited concurrently from several threads.
+    template<typename Visitor>
+    void forEachBlock(const Matrix<T>& queries, Visitor&& visit) const;
+
+    // The k nearest points of every query, nearest first (fewer when the
+    // set has fewer than k points). Ties are broken by the lower index.
+    std::vector<std::vector<Neighbor<T>>> nearest(const Matrix<T>& queries, size_t k) const;
+    std::vector<std::vector<Neighbor<T>>> nearest(const std::vector<Vector<T>>& queries, size_t k) const;
+    std::vector<Neighbor<T>> nearest(const Vector<T>& query, size_t k) const;
+
+private:
+    static Matrix<T> toMatrix(const std::vector<Vector<T>>& vectors);
+    void checkQueries(const Matrix<T>& queries) const;
+    unsigned workerCount(size_t queries) const;
+
+    // Distances of queries [q0, q1) to points [p0, p1) into block
+    // (q1 - q0 x p1 - p0); packedPoints is workspace. gemm runs serially.
+    void computeBlock(const Matrix<T>& queries, size_t q0, size_t q1, size_t p0, size_t p1,
+                      Matrix<T>& packedPoints, Matrix<T>& block) const;
+    // Offers points [p0, p1) to the heaps of queries [q0, q1)
+    void searchRange(const Matrix<T>& queries, size_t q0, size_t q1, size_t p0, size_t p1, size_t k,
+                     std::vector<std::vector<Neighbor<T>>>& heaps) const;
+};
+
+// One-shot forms; build a PointSet to search the same points repeatedly
+template<typename T>
+Matrix<T> pairwiseDistances(const Matrix<T>& X, const Matrix<T>& Y,
+                            DistanceMetric metric = DistanceMetric::Euclidean);
+template<typename T>
+Matrix<T> pairwiseDistances(const std::vector<Vector<T>>& X, const std::vector<Vector<T>>& Y,
+                            DistanceMetric metric = DistanceMetric::Euclidean);
+template<typename T>
+std::vector<std::vector<Neighbor<T>>> nearestNeighbors(const Matrix<T>& queries, const Matrix<T>& points, size_t k,
+                                                       DistanceMetric metric = DistanceMetric::Euclidean);
+
+#include "Distance.cpp"  // Include implementation for template class
@@ -0,0 +1,905 @@
+#include "ExactArithmetic.h"
+
+// BigInt
+
+template<typename I, typename>
+BigInt::BigInt(I value) {
+    uint64_t bits;
+    if constexpr (std::is_signed<I>::value) {
+        negative = value < 0;
+        bits = negative ? 0 - static_cast<uint64_t>(static_cast<int64_t>(value)) : static_cast<uint64_t>(value);
+    } else {
+        bits = static_cast<uint64_t>(value);
+    }
+    for (; bits; bits >>= 32) magnitude.push_back(static_cast<uint32_t>(bits));
+}
+
+inline void BigInt::trim() {
+    while (!magnitude.empty() && magnitude.back() == 0) magnitude.pop_back();
+    if (magnitude.empty()) negative = false;
+}
+
+inline size_t BigInt::bitLength() const {
+    if (magnitude.empty()) return 0;
+    size_t bits = 32 * (magnitude.size() - 1);
+    for (uint32_t top = magnitude.back(); top; top >>= 1) ++bits;
+    return bits;
+}
+
+template<typename I>
+bool BigInt::fits() const {
+    static_assert(std::is_integral<I>::value, "BigInt converts to integer types only");
+    return BigInt(std::numeric_limits<I>::min()) <= *this && *this <= BigInt(std::numeric_limits<I>::max());
+}
+
+template<typename I>
+I BigInt::to() const {
+    if (!fits<I>()) {
+        throw std::overflow_error("Integer does not fit the target type");
+    }
+    uint64_t bits = 0;
+    for (size_t i = magnitude.size(); i-- > 0;) bits = (bits << 32) | magnitude[i];
+    return static_cast<I>(negative ? 0 - bits : bits);
+}
+
+inline double BigInt::toDouble() const {
+    // The top three limbs hold more than the 53 bits of a double
+    double value = 0.0;
+    const size_t size = magnitude.size();
+    const size_t low = size > 3 ? size - 3 : 0;
+    for (size_t i = size; i-- > low;) value = value * 4294967296.0 + magnitude[i];
+    value = std::ldexp(value, static_cast<int>(std::min<size_t>(32 * low, 1 << 20)));
+    return negative ? -value : value;
+}
+
+inline std::string BigInt::toString() const {
+    if (magnitude.empty()) return "0";
+    // Base 10^9 digits, least significant first
+    BigInt rest = *this;
+    std::vector<uint32_t> chunks;
+    while (!rest.isZero()) chunks.push_back(rest.divideSmall(1000000000u));
+    std::string text = negative ? "-" : "";
+    text += std::to_string(chunks.back());
+    for (size_t i = chunks.size() - 1; i-- > 0;) {
+        const std::string digits = std::to_string(chunks[i]);
+        text.append(9 - digits.size(), '0');
+        text += digits;
+    }
+    return text;
+}
+
+inline int BigInt::compareMagnitude(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+    if (a.size() != b.size()) return a.size() < b.size() ? -1 : 1;
+    for (size_t i = a.size(); i-- > 0;) {
+        if (a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+inline void BigInt::addMagnitude(std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+    if (a.size() < b.size()) a.resize(b.size(), 0);
+    uint64_t carry = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (i >= b.size() && carry == 0) break;
+        const uint64_t sum = static_cast<uint64_t>(a[i]) + (i < b.size() ? b[i] : 0) + carry;
+        a[i] = static_cast<uint32_t>(sum);
+        carry = sum >> 32;
+    }
+    if (carry) a.push_back(static_cast<uint32_t>(carry));
+}
+
+inline void BigInt::subtractMagnitude(std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+    int64_t borrow = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (i >= b.size() && borrow == 0) break;
+        const int64_t difference = static_cast<int64_t>(a[i]) - (i < b.size() ? b[i] : 0) - borrow;
+        a[i] = static_cast<uint32_t>(difference);  // + 2^32 when negative
+        borrow = difference < 0 ? 1 : 0;
+    }
+}
+
+inline uint32_t BigInt::divideSmall(uint32_t divisor) {
+    uint64_t remainder = 0;
+    for (size_t i = magnitude.size(); i-- > 0;) {
+        const uint64_t current = (remainder << 32) | magnitude[i];
+        magnitude[i] = static_cast<uint32_t>(current / divisor);
+        remainder = current % divisor;
+    }
+    trim();
+    return static_cast<uint32_t>(remainder);
+}
+
+// Long division of magnitudes (Knuth, TAOCP vol. 2, 4.3.1, algorithm D):
+// one quotient limb per step, estimated from the top two limbs of the
+// remainder and the normalized divisor, which is at most 2 too large
+inline void BigInt::divideMagnitude(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b,
+                                    std::vector<uint32_t>& quotient, std::vector<uint32_t>& remainder) {
+    if (compareMagnitude(a, b) < 0) {
+        quotient.clear();
+        remainder = a;
+        return;
+    }
+    if (b.size() == 1) {
+        BigInt q;
+        q.magnitude = a;
+        const uint32_t r = q.divideSmall(b[0]);
+        quotient = std::move(q.magnitude);
+        remainder.assign(r ? 1 : 0, r);
+        return;
+    }
+
+    // Shift so that the top limb of the divisor has its high bit set
+    unsigned shift = 0;
+    for (uint32_t top = b.back(); !(top & 0x80000000u); top <<= 1) ++shift;
+    auto shifted = [shift](const std::vector<uint32_t>& x, size_t extra) {
+        std::vector<uint32_t> result(x.size() + extra, 0);
+        for (size_t i = 0; i < x.size(); ++i) {
+            const uint64_t wide = static_cast<uint64_t>(x[i]) << shift;
+            result[i] |= static_cast<uint32_t>(wide);
+            if (i + 1 < result.size()) result[i + 1] |= static_cast<uint32_t>(wide >> 32);
+        }
+        return result;
+    };
+    const std::vector<uint32_t> v = shifted(b, 0);
+    std::vector<uint32_t> u = shifted(a, 1);
+    const size_t n = v.size();
+    const size_t m = a.size() - n;
+    constexpr uint64_t BASE = uint64_t(1) << 32;
+
+    quotient.assign(m + 1, 0);
+    for (size_t j = m + 1; j-- > 0;) {
+        const uint64_t top = (static_cast<uint64_t>(u[j + n]) << 32) | u[j + n - 1];
+        uint64_t qhat = top / v[n - 1];
+        uint64_t rhat = top % v[n - 1];
+        while (qhat >= BASE || qhat * v[n - 2] > ((rhat << 32) | u[j + n - 2])) {
+            --qhat;
+            rhat += v[n - 1];
+            if (rhat >= BASE) break;
+        }
+
+        // u[j .. j + n] -= qhat * v
+        int64_t borrow = 0;
+        uint64_t carry = 0;
+        for (size_t i = 0; i < n; ++i) {
+            const uint64_t product = qhat * v[i] + carry;
+            carry = product >> 32;
+            const int64_t difference = static_cast<int64_t>(u[i + j]) - borrow - static_cast<int64_t>(product & 0xffffffffu);
+            u[i + j] = static_cast<uint32_t>(difference);
+            borrow = difference < 0 ? 1 : 0;
+        }
+        const int64_t difference = static_cast<int64_t>(u[j + n]) - borrow - static_cast<int64_t>(carry);
+        u[j + n] = static_cast<uint32_t>(difference);
+
+        // qhat was one too large: add v back
+        if (difference < 0) {
+            --qhat;
+            uint64_t sumCarry = 0;
+            for (size_t i = 0; i < n; ++i) {
+                const uint64_t sum = static_cast<uint64_t>(u[i + j]) + v[i] + sumCarry;
+                u[i + j] = static_cast<uint32_t>(sum);
+                sumCarry = sum >> 32;
+            }
+            u[j + n] += static_cast<uint32_t>(sumCarry);
+        }
+        quotient[j] = static_cast<uint32_t>(qhat);
+    }
+
+    // The remainder is u[0 .. n) shifted back
+    remainder.assign(n, 0);
+    for (size_t i = 0; i < n; ++i) {
+        remainder[i] = shift ? (u[i] >> shift) | static_cast<uint32_t>(static_cast<uint64_t>(u[i + 1]) << (32 - shift)) : u[i];
+    }
+    while (!quotient.empty() && quotient.back() == 0) quotient.pop_back();
+    while (!remainder.empty() && remainder.back() == 0) remainder.pop_back();
+}
+
+inline BigInt BigInt::operator-() const {
+    BigInt result = *this;
+    if (!result.isZero()) result.negative = !result.negative;
+    return result;
+}
+
+inline BigInt& BigInt::operator+=(const BigInt& other) {
+    if (this == &other) return *this <<= 1;
+    if (negative == other.negative) {
+        addMagnitude(magnitude, other.magnitude);
+    } else if (compareMagnitude(magnitude, other.magnitude) >= 0) {
+        subtractMagnitude(magnitude, other.magnitude);
+    } else {
+        std::vector<uint32_t> result = other.magnitude;
+        subtractMagnitude(result, magnitude);
+        magnitude.swap(result);
+        negative = other.negative;
+    }
+    trim();
+    return *this;
+}
+
+inline BigInt& BigInt::operator-=(const BigInt& other) {
+    return *this += -other;
+}
+
+inline BigInt& BigInt::operator*=(const BigInt& other) {
+    if (isZero() || other.isZero()) {
+        magnitude.clear();
+        negative = false;
+        return *this;
+    }
+    const std::vector<uint32_t>& a = magnitude;
+    const std::vector<uint32_t>& b = other.magnitude;
+    std::vector<uint32_t> result(a.size() + b.size(), 0);
+    for (size_t i = 0; i < a.size(); ++i) {
+        uint64_t carry = 0;
+        for (size_t j = 0; j < b.size(); ++j) {
+            const uint64_t current = static_cast<uint64_t>(a[i]) * b[j] + result[i + j] + carry;
+            result[i + j] = static_cast<uint32_t>(current);
+            carry = current >> 32;
+        }
+        result[i + b.size()] = static_cast<uint32_t>(carry);
+    }
+    negative = negative != other.negative;
+    magnitude.swap(result);
+    trim();
+    return *this;
+}
+
+inline void BigInt::divide(const BigInt& a, const BigInt& b, BigInt& quotient, BigInt& remainder) {
+    if (b.isZero()) {
+        throw std::domain_error("Division by zero");
+    }
+    BigInt q, r;
+    divideMagnitude(a.magnitude, b.magnitude, q.magnitude, r.magnitude);
+    q.negative = a.negative != b.negative;
+    r.negative = a.negative;
+    q.trim();
+    r.trim();
+    quotient = std::move(q);
+    remainder = std::move(r);
+}
+
+inline BigInt& BigInt::operator/=(const BigInt& other) {
+    BigInt remainder;
+    divide(*this, other, *this, remainder);
+    return *this;
+}
+
+inline BigInt& BigInt::operator%=(const BigInt& other) {
+    BigInt quotient;
+    divide(*this, other, quotient, *this);
+    return *this;
+}
+
+inline BigInt& BigInt::operator<<=(size_t bits) {
+    if (isZero()) return *this;
+    const unsigned shift = static_cast<unsigned>(bits % 32);
+    if (shift) {
+        uint32_t carry = 0;
+        for (uint32_t& limb : magnitude) {
+            const uint32_t next = limb >> (32 - shift);
+            limb = (limb << shift) | carry;
+            carry = next;
+        }
+        if (carry) magnitude.push_back(carry);
+    }
+    magnitude.insert(magnitude.begin(), bits / 32, 0);
+    return *this;
+}
+
+inline BigInt& BigInt::operator>>=(size_t bits) {
+    const size_t limbs = bits / 32;
+    if (limbs >= magnitude.size()) {
+        magnitude.clear();
+        negative = false;
+        return *this;
+    }
+    magnitude.erase(magnitude.begin(), magnitude.begin() + limbs);
+    const unsigned shift = static_cast<unsigned>(bits % 32);
+    if (shift) {
+        for (size_t i = 0; i < magnitude.size(); ++i) {
+            const uint32_t high = i + 1 < magnitude.size() ? magnitude[i + 1] << (32 - shift) : 0;
+            magnitude[i] = (magnitude[i] >> shift) | high;
+        }
+    }
+    trim();
+    return *this;
+}
+
+inline bool operator<(const BigInt& a, const BigInt& b) {
+    if (a.negative != b.negative) return a.negative;
+    const int order = BigInt::compareMagnitude(a.magnitude, b.magnitude);
+    return a.negative ? order > 0 : order < 0;
+}
+
+inline BigInt operator+(BigInt a, const BigInt& b) { return a += b; }
+inline BigInt operator-(BigInt a, const BigInt& b) { return a -= b; }
+inline BigInt operator*(const BigInt& a, const BigInt& b) { BigInt result = a; return result *= b; }
+inline BigInt operator/(const BigInt& a, const BigInt& b) { BigInt result = a; return result /= b; }
+inline BigInt operator%(const BigInt& a, const BigInt& b) { BigInt result = a; return result %= b; }
+inline BigInt operator<<(BigInt a, size_t bits) { return a <<= bits; }
+inline BigInt operator>>(BigInt a, size_t bits) { return a >>= bits; }
+
+inline BigInt gcd(BigInt a, BigInt b) {
+    if (a.isNegative()) a = -a;
+    if (b.isNegative()) b = -b;
+    while (!b.isZero()) {
+        BigInt remainder = a % b;
+        a = std::move(b);
+        b = std::move(remainder);
+    }
+    return a;
+}
+
+inline std::ostream& operator<<(std::ostream& os, const BigInt& value) {
+    return os << value.toString();
+}
+
+// Rational
+
+inline Rational::Rational(BigInt numerator, BigInt denominator) : num(std::move(numerator)), den(std::move(denominator)) {
+    if (den.isZero()) {
+        throw std::invalid_argument("Rational denominator must be nonzero");
+    }
+    if (den.isNegative()) {
+        num = -num;
+        den = -den;
+    }
+    const BigInt divisor = gcd(num, den);
+    if (divisor != BigInt(1)) {
+        num /= divisor;
+        den /= divisor;
+    }
+}
+
+inline double Rational::toDouble() const {
+    if (num.isZero()) return 0.0;
+    // Scale to a quotient of 64 or 65 bits, then back with ldexp
+    const long shift = static_cast<long>(num.bitLength()) - static_cast<long>(den.bitLength()) - 64;
+    BigInt a = num, b = den;
+    if (shift > 0) {
+        b <<= static_cast<size_t>(shift);
+    } else {
+        a <<= static_cast<size_t>(-shift);
+    }
+    return std::ldexp((a / b).toDouble(), static_cast<int>(std::max<long>(std::min<long>(shift, 1 << 20), -(1 << 20))));
+}
+
+inline std::string Rational::toString() const {
+    return isInteger() ? num.toString() : num.toString() + "/" + den.toString();
+}
+
+inline std::ostream& operator<<(std::ostream& os, const Rational& value) {
+    return os << value.toString();
+}
+
+namespace exact_detail {
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef __int128 Int128;
+#endif
+
+// Moduli are primes below 2^30, so that a sum of two residues and the
+// [0, 2p) result of a Shoup product stay below 2^32
+constexpr uint32_t MODULUS_LIMIT = uint32_t(1) << 30;
+
+// log2 of the norm of every row (columns = false) or column of A; -inf for
+// a zero one. The product of the row norms, and that of the column norms,
+// bound |det A| (Hadamard).
+template<typename T>
+std::vector<double> normBits(const Matrix<T>& A, bool columns) {
+    std::vector<double> squares(columns ? A.getCols() : A.getRows(), 0.0);
+    for (size_t i = 0; i < A.getRows(); ++i) {
+        const std::vector<T>& row = A[i];
+        for (size_t j = 0; j < A.getCols(); ++j) {
+            const double value = static_cast<double>(row[j]);
+            squares[columns ? j : i] += value * value;
+        }
+    }
+    for (double& bits : squares) bits = 0.5 * std::log2(bits);
+    return squares;
+}
+
+inline double sum(const std::vector<double>& values) {
+    double total = 0.0;
+    for (double value : values) total += value;
+    return total;
+}
+
+template<typename T>
+double hadamardBits(const Matrix<T>& A) {
+    return std::min(sum(normBits(A, false)), sum(normBits(A, true)));
+}
+
+inline uint32_t multiplyModulo(uint32_t a, uint32_t b, uint32_t p) {
+    return static_cast<uint32_t>(static_cast<uint64_t>(a) * b % p);
+}
+
+inline uint32_t powerModulo(uint32_t base, uint32_t exponent, uint32_t p) {
+    uint32_t result = 1;
+    for (; exponent; exponent >>= 1) {
+        if (exponent & 1) result = multiplyModulo(result, base, p);
+        base = multiplyModulo(base, base, p);
+    }
+    return result;
+}
+
+inline uint32_t inverseModulo(uint32_t a, uint32_t p) {
+    return powerModulo(a, p - 2, p);
+}
+
+// Miller-Rabin with the bases 2, 7 and 61, exact below 2^32
+inline bool isPrime(uint32_t n) {
+    if (n < 2) return false;
+    for (uint32_t small : {2u, 3u, 5u, 7u, 11u, 13u, 61u}) {
+        if (n % small == 0) return n == small;
+    }
+    uint32_t odd = n - 1;
+    int twos = 0;
+    for (; !(odd & 1); odd >>= 1) ++twos;
+    for (uint32_t base : {2u, 7u, 61u}) {
+        uint32_t x = powerModulo(base, odd, n);
+        if (x == 1 || x == n - 1) continue;
+        bool composite = true;
+        for (int r = 1; r < twos && composite; ++r) {
+            x = multiplyModulo(x, x, n);
+            composite = x != n - 1;
+        }
+        if (composite) return false;
+    }
+    return true;
+}
+
+// Appends the next primes below the last one (or below MODULUS_LIMIT)
+// until their product has `bits` more bits
+inline void addPrimes(std::vector<uint32_t>& primes, double bits) {
+    uint32_t candidate = primes.empty() ? MODULUS_LIMIT : primes.back();
+    for (double covered = 0.0; covered < bits;) {
+        do {
+            candidate -= candidate == MODULUS_LIMIT ? 1 : 2;
+        } while (!isPrime(candidate));
+        primes.push_back(candidate);
+        covered += std::log2(static_cast<double>(candidate));
+    }
+}
+
+#if defined(__AVX2__)
+// High halves of the 32 x 32-bit products of eight lanes by m
+inline __m256i multiplyHigh(__m256i a, __m256i m) {
+    const __m256i even = _mm256_srli_epi64(_mm256_mul_epu32(a, m), 32);
+    const __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), m);
+    return _mm256_blend_epi32(even, odd, 0xAA);
+}
+#endif
+
+// y[0 .. count) += factor * x mod p. Shoup's precomputed quotient
+// floor(factor * 2^32 / p) replaces the division: q = (quotient * x) >> 32
+// is floor(factor * x / p) or one less, so factor * x - q * p, computed
+// mod 2^32, lies in [0, 2p). Only 32 x 32-bit products remain; with AVX2
+// they run eight at a time (compilers widen the portable loop to 64-bit
+// multiplies).
+inline void axpyModulo(uint32_t* __restrict y, const uint32_t* __restrict x, size_t count, uint32_t factor, uint32_t p) {
+    const uint64_t quotient = (static_cast<uint64_t>(factor) << 32) / p;
+    size_t j = 0;
+#if defined(__AVX2__)
+    const __m256i factors = _mm256_set1_epi32(static_cast<int>(factor));
+    const __m256i quotients = _mm256_set1_epi32(static_cast<int>(quotient));
+    const __m256i modulus = _mm256_set1_epi32(static_cast<int>(p));
+    for (; j + 8 <= count; j += 8) {
+        const __m256i xs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + j));
+        __m256i product = _mm256_sub_epi32(_mm256_mullo_epi32(factors, xs),
+                                           _mm256_mullo_epi32(multiplyHigh(xs, quotients), modulus));
+        product = _mm256_min_epu32(product, _mm256_sub_epi32(product, modulus));
+        const __m256i total = _mm256_add_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + j)), product);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(y + j), _mm256_min_epu32(total, _mm256_sub_epi32(total, modulus)));
+    }
+#endif
+    for (; j < count; ++j) {
+        uint32_t product = factor * x[j] - static_cast<uint32_t>((quotient * x[j]) >> 32) * p;
+        product = std::min(product, product - p);
+        const uint32_t total = y[j] + product;
+        y[j] = std::min(total, total - p);
+    }
+}
+
+// y[0 .. count) *= factor mod p, the same way
+inline void scaleModulo(uint32_t* y, size_t count, uint32_t factor, uint32_t p) {
+    const uint64_t quotient = (static_cast<uint64_t>(factor) << 32) / p;
+    for (size_t j = 0; j < count; ++j) {
+        const uint32_t product = factor * y[j] - static_cast<uint32_t>((quotient * y[j]) >> 32) * p;
+        y[j] = std::min(product, product - p);
+    }
+}
+
+template<typename T>
+uint32_t residue(T value, uint32_t p) {
+    if constexpr (std::is_signed<T>::value) {
+        const int64_t r = static_cast<int64_t>(value) % static_cast<int64_t>(p);
+        return static_cast<uint32_t>(r < 0 ? r + p : r);
+    } else {
+        return static_cast<uint32_t>(static_cast<uint64_t>(value) % p);
+    }
+}
+
+// [A | B] mod p into the row-major n x (n + m) array a (B may be null)
+template<typename T>
+void loadResidues(const Matrix<T>& A, const Matrix<T>* B, uint32_t p, std::vector<uint32_t>& a) {
+    const size_t n = A.getRows();
+    const size_t m = B ? B->getCols() : 0;
+    const size_t width = n + m;
+    a.resize(n * width);
+    for (size_t i = 0; i < n; ++i) {
+        const std::vector<T>& row = A[i];
+        for (size_t j = 0; j < n; ++j) a[i * width + j] = residue(row[j], p);
+        for (size_t j = 0; j < m; ++j) a[i * width + n + j] = residue((*B)(i, j), p);
+    }
+}
+
+// Gaussian elimination mod p of the first n columns of the n x width array
+// a; returns det mod p, 0 (and stops) when the matrix is singular mod p
+inline uint32_t eliminateModulo(std::vector<uint32_t>& a, size_t n, size_t width, uint32_t p) {
+    uint32_t det = 1;
+    for (size_t k = 0; k < n; ++k) {
+        size_t pivotRow = k;
+        while (pivotRow < n && a[pivotRow * width + k] == 0) ++pivotRow;
+        if (pivotRow == n) return 0;
+        if (pivotRow != k) {
+            std::swap_ranges(a.begin() + k * width + k, a.begin() + (k + 1) * width, a.begin() + pivotRow * width + k);
+            det = p - det;
+        }
+        const uint32_t pivot = a[k * width + k];
+        det = multiplyModulo(det, pivot, p);
+        const uint32_t inverse = inverseModulo(pivot, p);
+        const uint32_t* pivotTail = &a[k * width + k + 1];
+        for (size_t i = k + 1; i < n; ++i) {
+            const uint32_t below = a[i * width + k];
+            if (below == 0) continue;
+            axpyModulo(&a[i * width + k + 1], pivotTail, width - k - 1, p - multiplyModulo(below, inverse, p), p);
+        }
+    }
+    return det;
+}
+
+template<typename T>
+uint32_t determinantModulo(const Matrix<T>& A, uint32_t p, std::vector<uint32_t>& work) {
+    loadResidues<T>(A, nullptr, p, work);
+    return eliminateModulo(work, A.getRows(), A.getRows(), p);
+}
+
+// det A mod p and, unless that is 0, det A * X mod p (n x m, row-major)
+// with A * X = B
+template<typename T>
+uint32_t solveModulo(const Matrix<T>& A, const Matrix<T>& B, uint32_t p, std::vector<uint32_t>& work,
+                     std::vector<uint32_t>& scaled) {
+    const size_t n = A.getRows();
+    const size_t m = B.getCols();
+    const size_t width = n + m;
+    loadResidues(A, &B, p, work);
+    const uint32_t det = eliminateModulo(work, n, width, p);
+    if (det == 0) return 0;
+
+    // Back substitution on the right-hand sides, which become X
+    for (size_t i = n; i-- > 0;) {
+        uint32_t* x = &work[i * width + n];
+        for (size_t j = i + 1; j < n; ++j) {
+            const uint32_t coefficient = work[i * width + j];
+            if (coefficient) axpyModulo(x, &work[j * width + n], m, p - coefficient, p);
+        }
+        scaleModulo(x, m, inverseModulo(work[i * width + i], p), p);
+    }
+    scaled.resize(n * m);
+    for (size_t i = 0; i < n; ++i) {
+        scaleModulo(&work[i * width + n], m, det, p);
+        std::copy(&work[i * width + n], &work[i * width + n] + m, &scaled[i * m]);
+    }
+    return det;
+}
+
+// Chinese remaindering over a fixed set of primes: Garner's mixed-radix
+// digits, then Horner's rule in BigInt, then the representative of least
+// absolute value
+class CrtBasis {
+public:
+    explicit CrtBasis(std::vector<uint32_t> moduli) : primes(std::move(moduli)), inverses(primes.size()), product(1) {
+        for (size_t i = 0; i < primes.size(); ++i) {
+            inverses[i].resize(i);
+            for (size_t j = 0; j < i; ++j) inverses[i][j] = inverseModulo(primes[j] % primes[i], primes[i]);
+            product *= BigInt(primes[i]);
+        }
+    }
+
+    BigInt combine(const std::vector<uint32_t>& residues) const {
+        const size_t count = primes.size();
+        std::vector<uint32_t> digits(count);
+        for (size_t i = 0; i < count; ++i) {
+            const uint32_t p = primes[i];
+            uint32_t x = residues[i];
+            for (size_t j = 0; j < i; ++j) {
+                const uint32_t digit = digits[j] % p;
+                x = multiplyModulo(x >= digit ? x - digit : x + p - digit, inverses[i][j], p);
+            }
+            digits[i] = x;
+        }
+        BigInt value;
+        for (size_t i = count; i-- > 0;) {
+            value *= BigInt(primes[i]);
+            value += BigInt(digits[i]);
+        }
+        if ((value << 1) > product) value -= product;
+        return value;
+    }
+
+private:
+    std::vector<uint32_t> primes;
+    std::vector<std::vector<uint32_t>> inverses;  // [i][j] = primes[j]^-1 mod primes[i], j < i
+    BigInt product;
+};
+
+// Where a fraction-free elimination stopped: the step (pivot column), and
+// within it the next row to update (0 before the pivot is chosen)
+struct BareissProgress {
+    size_t step = 0;
+    size_t row = 0;
+    int sign = 1;          // (-1)^(row swaps)
+    bool singular = false;  // A pivot column was zero
+};
+
+// Bareiss elimination of the first n columns of the n x width row-major
+// array a. With pivot a_kk and the previous pivot d, step k sets
+// a_ij = (a_kk * a_ij - a_ik * a_kj) / d for i, j > k, an exact division
+// whose result is a minor of the input. combine(a_kk, a_ij, a_ik, a_kj, d,
+// out) returns false when the result does not fit Int; the elimination
+// then stops with that row unchanged and `progress` set to resume from.
+template<typename Int, typename Combine>
+bool bareiss(std::vector<Int>& a, size_t n, size_t width, BareissProgress& progress, const Combine& combine) {
+    std::vector<Int> updated(width);
+    for (; progress.step < n; ++progress.step, progress.row = 0) {
+        const size_t k = progress.step;
+        if (progress.row == 0) {
+            size_t pivotRow = k;
+            while (pivotRow < n && a[pivotRow * width + k] == Int(0)) ++pivotRow;
+            if (pivotRow == n) {
+                progress.singular = true;
+                return true;
+            }
+            if (pivotRow != k) {
+                std::swap_ranges(a.begin() + k * width, a.begin() + (k + 1) * width, a.begin() + pivotRow * width);
+                progress.sign = -progress.sign;
+            }
+            progress.row = k + 1;
+        }
+        const Int& pivot = a[k * width + k];
+        const Int previous = k ? a[(k - 1) * width + k - 1] : Int(1);
+        for (; progress.row < n; ++progress.row) {
+            const size_t i = progress.row;
+            const Int& below = a[i * width + k];
+            for (size_t j = k + 1; j < width; ++j) {
+                if (!combine(pivot, a[i * width + j], below, a[k * width + j], previous, updated[j])) return false;
+            }
+            for (size_t j = k + 1; j < width; ++j) std::swap(a[i * width + j], updated[j]);
+            a[i * width + k] = Int(0);
+        }
+    }
+    return true;
+}
+
+// Bareiss on [A | B] (B may be null), in 64-bit entries with 128-bit
+// products while they fit and in BigInt from the first overflow on.
+// Returns the eliminated array.
+template<typename T>
+std::vector<BigInt> bareissEliminate(const Matrix<T>& A, const Matrix<T>* B, BareissProgress& progress,
+                                     bool& fallback) {
+    const size_t n = A.getRows();
+    const size_t m = B ? B->getCols() : 0;
+    const size_t width = n + m;
+    auto entry = [&](size_t i, size_t j) { return j < n ? A[i][j] : (*B)(i, j - n); };
+
+    fallback = true;
+#if defined(__SIZEOF_INT128__)
+    bool small = true;
+    std::vector<int64_t> narrow(n * width);
+    for (size_t i = 0; i < n && small; ++i) {
+        for (size_t j = 0; j < width && small; ++j) {
+            const T value = entry(i, j);
+            small = !(std::is_unsigned<T>::value && sizeof(T) >= sizeof(int64_t)) ||
+                    static_cast<uint64_t>(value) <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+            narrow[i * width + j] = static_cast<int64_t>(value);
+        }
+    }
+    if (small) {
+        auto combine64 = [](int64_t pivot, int64_t aij, int64_t below, int64_t akj, int64_t previous, int64_t& out) {
+            // Each product is below 2^126 in magnitude, so the difference cannot overflow
+            Int128 value = static_cast<Int128>(pivot) * aij - static_cast<Int128>(below) * akj;
+            if (previous != 1) value /= previous;
+            if (value > std::numeric_limits<int64_t>::max() || value < std::numeric_limits<int64_t>::min()) return false;
+            out = static_cast<int64_t>(value);
+            return true;
+        };
+        fallback = !bareiss(narrow, n, width, progress, combine64);
+        if (!fallback) return std::vector<BigInt>(narrow.begin(), narrow.end());
+    }
+    std::vector<BigInt> wide = small ? std::vector<BigInt>(narrow.begin(), narrow.end()) : std::vector<BigInt>();
+#else
+    std::vector<BigInt> wide;
+#endif
+    if (wide.empty()) {
+        wide.reserve(n * width);
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < width; ++j) wide.push_back(BigInt(entry(i, j)));
+        }
+    }
+    auto combineBig = [](const BigInt& pivot, const BigInt& aij, const BigInt& below, const BigInt& akj,
+                         const BigInt& previous, BigInt& out) {
+        out = pivot * aij - below * akj;
+        if (previous != BigInt(1)) out /= previous;
+        return true;
+    };
+    bareiss(wide, n, width, progress, combineBig);
+    return wide;
+}
+
+inline KernelTuning exactTuning(KernelTuning tuning, const ExactOptions& options) {
+    if (options.threads) tuning.threads = options.threads;
+    return tuning;
+}
+
+template<typename T>
+BigInt modularDeterminant(const Matrix<T>& A, double bits, const KernelTuning& tuning, ExactStats& stats) {
+    const size_t n = A.getRows();
+    // Twice the bound, for the sign, and a bit of margin for the rounding of `bits`
+    std::vector<uint32_t> primes;
+    addPrimes(primes, bits + 2.0);
+    std::vector<uint32_t> residues(primes.size());
+    parallelFor(primes.size(), n * n, tuning, [&](size_t begin, size_t end) {
+        std::vector<uint32_t> work;
+        for (size_t q = begin; q < end; ++q) residues[q] = determinantModulo(A, primes[q], work);
+    });
+    stats.primes = primes.size();
+    return CrtBasis(primes).combine(residues);
+}
+
+template<typename T>
+Matrix<Rational> modularSolve(const Matrix<T>& A, const Matrix<T>& B, double bits, const KernelTuning& tuning,
+                              ExactStats& stats) {
+    const size_t n = A.getRows();
+    const size_t m = B.getCols();
+    std::vector<uint32_t> primes;
+    std::vector<uint32_t> determinants;
+    std::vector<std::vector<uint32_t>> solutions;
+    BigInt det;
+    double covered = 0.0;  // Bits of the primes that do not divide det A
+
+    // Primes that divide det A give no solution; they are rare, and replaced
+    // by further ones until the rest cover the bound
+    while (covered < bits + 2.0) {
+        const size_t first = primes.size();
+        addPrimes(primes, bits + 2.0 - covered);
+        determinants.resize(primes.size());
+        solutions.resize(primes.size());
+        parallelFor(primes.size() - first, n * (n + m), tuning, [&](size_t begin, size_t end) {
+            std::vector<uint32_t> work;
+            for (size_t q = first + begin; q < first + end; ++q) {
+                determinants[q] = solveModulo(A, B, primes[q], work, solutions[q]);
+            }
+        });
+        if (first == 0) {
+            // The first primes cover the bound on det A too
+            det = CrtBasis(primes).combine(determinants);
+            if (det.isZero()) {
+                throw std::runtime_error("Matrix is singular - exact solve failed");
+            }
+        }
+        for (size_t q = first; q < primes.size(); ++q) {
+            if (determinants[q]) covered += std::log2(static_cast<double>(primes[q]));
+        }
+    }
+    stats.primes = primes.size();
+
+    std::vector<uint32_t> lucky;
+    std::vector<size_t> luckyIndex;
+    for (size_t q = 0; q < primes.size(); ++q) {
+        if (determinants[q]) {
+            lucky.push_back(primes[q]);
+            luckyIndex.push_back(q);
+        }
+    }
+    const CrtBasis basis(lucky);
+    Matrix<Rational> X(n, m);
+    std::vector<uint32_t> residues(lucky.size());
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < m; ++j) {
+            for (size_t q = 0; q < lucky.size(); ++q) residues[q] = solutions[luckyIndex[q]][i * m + j];
+            X(i, j) = Rational(basis.combine(residues), det);
+        }
+    }
+    return X;
+}
+
+}  // namespace exact_detail
+
+template<typename T>
+BigInt exactDeterminant(const Matrix<T>& A, const ExactOptions& options) {
+    using namespace exact_detail;
+    static_assert(std::is_integral<T>::value, "Exact determinants need an integer element type");
+    const size_t n = A.getRows();
+    LINALG_PROFILE("exactDeterminant", n, A.getCols());
+    if (n != A.getCols()) {
+        throw std::invalid_argument("Determinant can only be calculated for square matrices");
+    }
+
+    ExactStats stats;
+    stats.hadamardBits = n ? hadamardBits(A) : 0.0;
+    stats.method = options.method != ExactMethod::Auto ? options.method
+                 : stats.hadamardBits <= 62.0 ? ExactMethod::Bareiss : ExactMethod::Modular;
+    BigInt det;
+    if (n == 0) {
+        det = BigInt(1);
+    } else if (std::isinf(stats.hadamardBits)) {
+        // A zero row or column
+    } else if (stats.method == ExactMethod::Bareiss) {
+        BareissProgress progress;
+        const std::vector<BigInt> a = bareissEliminate<T>(A, nullptr, progress, stats.bigIntFallback);
+        if (!progress.singular) det = progress.sign > 0 ? a.back() : -a.back();
+    } else {
+        det = modularDeterminant(A, stats.hadamardBits, exactTuning(Tuning::parameters<T>(), options), stats);
+    }
+    if (options.stats) *options.stats = stats;
+    return det;
+}
+
+template<typename T>
+Matrix<Rational> exactSolve(const Matrix<T>& A, const Matrix<T>& B, const ExactOptions& options) {
+    using namespace exact_detail;
+    static_assert(std::is_integral<T>::value, "Exact solves need an integer element type");
+    const size_t n = A.getRows();
+    const size_t m = B.getCols();
+    LINALG_PROFILE("exactSolve", n, m);
+    if (n != A.getCols()) {
+        throw std::invalid_argument("Solve requires a square coefficient matrix");
+    }
+    if (B.getRows() != n) {
+        throw std::invalid_argument("Right-hand side rows must match matrix size");
+    }
+    if (n == 0) return Matrix<Rational>(0, m);
+
+    // Every entry of det A * X is a determinant of A with one column
+    // replaced by one of B (Cramer), and so are all Bareiss intermediates
+    ExactStats stats;
+    const double detBits = hadamardBits(A);
+    if (std::isinf(detBits)) {
+        throw std::runtime_error("Matrix is singular - exact solve failed");
+    }
+    const std::vector<double> columnsB = normBits(B, true);
+    const double largestB = columnsB.empty() ? 0.0 : *std::max_element(columnsB.begin(), columnsB.end());
+    stats.hadamardBits = std::max(detBits, sum(normBits(A, true)) + largestB);
+    stats.method = options.method != ExactMethod::Auto ? options.method
+                 : stats.hadamardBits <= 62.0 ? ExactMethod::Bareiss : ExactMethod::Modular;
+
+    Matrix<Rational> X;
+    if (stats.method == ExactMethod::Bareiss) {
+        BareissProgress progress;
+        const std::vector<BigInt> a = bareissEliminate(A, &B, progress, stats.bigIntFallback);
+        if (progress.singular) {
+            throw std::runtime_error("Matrix is singular - exact solve failed");
+        }
+        // Fraction-free back substitution for Y = D * X with D the last
+        // pivot: row i reads a_ii x_i + sum_j>i a_ij x_j = b_i, so
+        // a_ii y_i = D b_i - sum_j>i a_ij y_j, divisible since Y is integral
+        const size_t width = n + m;
+        const BigInt& D = a[(n - 1) * width + n - 1];
+        std::vector<BigInt> Y(n * m);
+        for (size_t i = n; i-- > 0;) {
+            for (size_t c = 0; c < m; ++c) {
+                BigInt value = D * a[i * width + n + c];
+                for (size_t j = i + 1; j < n; ++j) value -= a[i * width + j] * Y[j * m + c];
+                Y[i * m + c] = value / a[i * width + i];
+            }
+        }
+        X = Matrix<Rational>(n, m);
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t c = 0; c < m; ++c) X(i, c) = Rational(Y[i * m + c], D);
+        }
+    } else {
+        X = modularSolve(A, B, stats.hadamardBits, exactTuning(Tuning::parameters<T>(), options), stats);
+    }
+    if (options.stats) *options.stats = stats;
+    return X;
+}
@@ -0,0 +1,151 @@
+#pragma once
+#include "Matrix.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// Exact determinants and linear solves of integer matrices.
+//
+// Floating-point LU cannot give exact results for integer matrices, and
+// integer LU truncates its divisions. This module has two exact methods:
+//
+// - Bareiss: fraction-free elimination. Every division is exact and every
+//   intermediate entry is a minor of A. Entries are kept in 64 bits, with
+//   128-bit products and an overflow check. After the first entry that
+//   does not fit, the elimination continues in BigInt from where it
+//   stopped.
+// - Modular: the determinant modulo many 30-bit primes, each an
+//   O(n^3) elimination on 32-bit words, vectorized with AVX2. The
+//   primes run in parallel (ParallelFor.h). Their product covers twice the
+//   Hadamard bound, so the Chinese remainder theorem recovers the exact
+//   value. The cost grows with the bit size of the result rather than
+//   with BigInt multiplies inside the O(n^3) loop, which makes this the
+//   method for large matrices.
+//
+// Auto picks Bareiss when the Hadamard bound fits 62 bits, since the
+// elimination then cannot overflow, and Modular otherwise. Solves return
+// reduced fractions, computed from det(A) * X, which is integral by
+// Cramer's rule.
+
+// Signed integer of any size: sign and magnitude in base 2^32 limbs
+class BigInt {
+public:
+    BigInt() = default;
+    template<typename I, typename = typename std::enable_if<std::is_integral<I>::value>::type>
+    BigInt(I value);
+
+    bool isZero() const { return magnitude.empty(); }
+    bool isNegative() const { return negative; }
+    int signum() const { return isZero() ? 0 : (negative ? -1 : 1); }
+    size_t bitLength() const;  // Of the magnitude; 0 for zero
+
+    // Conversion to an integer type; to() throws std::overflow_error when
+    // the value is out of its range
+    template<typename I>
+    bool fits() const;
+    template<typename I>
+    I to() const;
+    double toDouble() const;  // Rounded; +-inf beyond the double range
+    std::string toString() const;
+
+    BigInt operator-() const;
+    BigInt& operator+=(const BigInt& other);
+    BigInt& operator-=(const BigInt& other);
+    BigInt& operator*=(const BigInt& other);
+    BigInt& operator/=(const BigInt& other);  // Truncates toward zero, as for built-in integers
+    BigInt& operator%=(const BigInt& other);  // Has the sign of the dividend
+    BigInt& operator<<=(size_t bits);         // Shifts the magnitude; the sign is kept
+    BigInt& operator>>=(size_t bits);
+
+    // quotient = a / b and remainder = a % b in one long division
+    static void divide(const BigInt& a, const BigInt& b, BigInt& quotient, BigInt& remainder);
+
+    friend bool operator==(const BigInt& a, const BigInt& b) { return a.negative == b.negative && a.magnitude == b.magnitude; }
+    friend bool operator<(const BigInt& a, const BigInt& b);
+
+private:
+    std::vector<uint32_t> magnitude;  // Least significant limb first, no leading zero limbs
+    bool negative = false;            // Never set for zero
+
+    void trim();
+    static int compareMagnitude(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b);
+    static void addMagnitude(std::vector<uint32_t>& a, const std::vector<uint32_t>& b);
+    static void subtractMagnitude(std::vector<uint32_t>& a, const std::vector<uint32_t>& b);  // Needs |a| >= |b|
+    static void divideMagnitude(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b,
+                                std::vector<uint32_t>& quotient, std::vector<uint32_t>& remainder);
+    uint32_t divideSmall(uint32_t divisor);  // In place on the magnitude; returns the remainder
+};
+
+inline bool operator!=(const BigInt& a, const BigInt& b) { return !(a == b); }
+inline bool operator>(const BigInt& a, const BigInt& b) { return b < a; }
+inline bool operator<=(const BigInt& a, const BigInt& b) { return !(b < a); }
+inline bool operator>=(const BigInt& a, const BigInt& b) { return !(a < b); }
+BigInt operator+(BigInt a, const BigInt& b);
+BigInt operator-(BigInt a, const BigInt& b);
+BigInt operator*(const BigInt& a, const BigInt& b);
+BigInt operator/(const BigInt& a, const BigInt& b);
+BigInt operator%(const BigInt& a, const BigInt& b);
+BigInt operator<<(BigInt a, size_t bits);
+BigInt operator>>(BigInt a, size_t bits);
+BigInt gcd(BigInt a, BigInt b);  // Non-negative
+std::ostream& operator<<(std::ostream& os, const BigInt& value);
+
+// Fraction in lowest terms with a positive denominator
+class Rational {
+public:
+    Rational(BigInt numerator = BigInt(), BigInt denominator = BigInt(1));
+
+    const BigInt& numerator() const { return num; }
+    const BigInt& denominator() const { return den; }
+    bool isInteger() const { return den == BigInt(1); }
+    double toDouble() const;      // Correct for numerators and denominators beyond the double range
+    std::string toString() const; // "p/q", or "p" for an integer
+
+    friend bool operator==(const Rational& a, const Rational& b) { return a.num == b.num && a.den == b.den; }
+    friend bool operator!=(const Rational& a, const Rational& b) { return !(a == b); }
+
+private:
+    BigInt num;
+    BigInt den;
+};
+
+std::ostream& operator<<(std::ostream& os, const Rational& value);
+
+enum class ExactMethod {
+    Auto,     // Bareiss when the Hadamard bound fits 62 bits, else Modular
+    Bareiss,  // Fraction-free elimination, 64-bit then BigInt entries
+    Modular   // Residues modulo 30-bit primes in parallel, combined by the CRT
+};
+
+struct ExactStats {
+    ExactMethod method = ExactMethod::Auto;  // The method that ran
+    double hadamardBits = 0.0;  // log2 of the bound on |det A| (and on det(A) * X for solves)
+    size_t primes = 0;          // Modular: primes used, including unlucky ones that divide det A
+    bool bigIntFallback = false;  // Bareiss: an entry outgrew 64 bits
+};
+
+struct ExactOptions {
+    ExactMethod method = ExactMethod::Auto;
+    unsigned threads = 0;            // Modular: 0 = KernelTuning::threads, else hardware concurrency
+    ExactStats* stats = nullptr;     // Receives the statistics of the call when set
+};
+
+// det A of a square integer matrix
+template<typename T>
+BigInt exactDeterminant(const Matrix<T>& A, const ExactOptions& options = ExactOptions());
+
+// X with A * X = B as reduced fractions; throws std::runtime_error when A
+// is singular
+template<typename T>
+Matrix<Rational> exactSolve(const Matrix<T>& A, const Matrix<T>& B, const ExactOptions& options = ExactOptions());
+
+#include "ExactArithmetic.cpp"  // Include implementation (header-only library)
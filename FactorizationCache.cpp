@@ -0,0 +1,229 @@
+#include "FactorizationCache.h"
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+
+template<typename T>
+FactorizationCache<T>::FactorizationCache(size_t capacityBytes)
+    : capacityBytes(capacityBytes), usedBytes(0), hits(0), misses(0), evictions(0) {}
+
+// Checksum64 (the binary file checksum) over the shape and then the bytes
+// of every row
+template<typename T>
+uint64_t FactorizationCache<T>::hash(const Matrix<T>& A) {
+    const size_t rows = A.getRows();
+    const size_t cols = A.getCols();
+    LINALG_PROFILE("FactorizationCache::hash", rows, cols, 0.0, double(rows) * cols * sizeof(T));
+
+    const uint64_t shape[3] = {rows, cols, sizeof(T)};
+    Checksum64 checksum;
+    checksum.update(shape, sizeof(shape));
+    const size_t rowBytes = cols * sizeof(T);
+    for (size_t i = 0; i < rows; ++i) {
+        checksum.update(A[i].data(), rowBytes);
+    }
+    return checksum.digest();
+}
+
+template<typename T>
+bool FactorizationCache<T>::sameContents(const Matrix<T>& A, const Matrix<T>& B) {
+    if (A.getRows() != B.getRows() || A.getCols() != B.getCols()) return false;
+    const size_t rowBytes = A.getCols() * sizeof(T);
+    for (size_t i = 0; i < A.getRows(); ++i) {
+        if (std::memcmp(A[i].data(), B[i].data(), rowBytes) != 0) return false;
+    }
+    return true;
+}
+
+template<typename T>
+size_t FactorizationCache<T>::matrixBytes(size_t rows, size_t cols) {
+    return rows * (cols * sizeof(T) + sizeof(std::vector<T>));
+}
+
+template<typename T>
+typename FactorizationCache<T>::EntryList::iterator
+FactorizationCache<T>::find(const Matrix<T>& A, uint64_t key) {
+    auto range = index.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (sameContents(it->second->key, A)) return it->second;
+    }
+    return entries.end();
+}
+
+template<typename T>
+void FactorizationCache<T>::erase(typename EntryList::iterator entry) {
+    auto range = index.equal_range(entry->hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == entry) {
+            index.erase(it);
+            break;
+        }
+    }
+    usedBytes -= entry->bytes;
+    entries.erase(entry);
+}
+
+template<typename T>
+void FactorizationCache<T>::evict(typename EntryList::iterator keep) {
+    while (usedBytes > capacityBytes && !entries.empty() && std::prev(entries.end()) != keep) {
+        erase(std::prev(entries.end()));
+        ++evictions;
+    }
+}
+
+template<typename T>
+template<typename Result, typename Factor>
+std::shared_ptr<const Result> FactorizationCache<T>::lookup(Kind kind, const Matrix<T>& A, uint64_t key,
+                                                            size_t bytes, Factor factor) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto entry = find(A, key);
+        if (entry != entries.end() && entry->results[kind]) {
+            ++hits;
+            entries.splice(entries.begin(), entries, entry);
+            return std::static_pointer_cast<const Result>(entry->results[kind]);
+        }
+        ++misses;
+    }
+
+    std::shared_ptr<const Result> result = std::make_shared<Result>(factor());
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto entry = find(A, key);
+    if (entry == entries.end()) {
+        const size_t keyBytes = matrixBytes(A.getRows(), A.getCols());
+        if (keyBytes + bytes > capacityBytes) return result;
+        entries.push_front(Entry{key, A, {}, keyBytes});
+        entry = entries.begin();
+        index.emplace(key, entry);
+        usedBytes += keyBytes;
+    } else {
+        entries.splice(entries.begin(), entries, entry);
+        if (entry->results[kind]) {
+            // Another thread factored the same matrix meanwhile
+            return std::static_pointer_cast<const Result>(entry->results[kind]);
+        }
+        if (entry->bytes + bytes > capacityBytes) return result;
+    }
+    entry->results[kind] = result;
+    entry->bytes += bytes;
+    usedBytes += bytes;
+    evict(entry);
+    return result;
+}
+
+template<typename T>
+std::shared_ptr<const LUFactorization<T>> FactorizationCache<T>::lu(const Matrix<T>& A) {
+    const size_t n = A.getRows();
+    return lookup<LUFactorization<T>>(LU, A, hash(A), matrixBytes(n, n) + n * sizeof(size_t),
+                                      [&]() { return LUFactorization<T>(A); });
+}
+
+template<typename T>
+std::shared_ptr<const CholeskyFactorization<T>> FactorizationCache<T>::cholesky(const Matrix<T>& A) {
+    const size_t n = A.getRows();
+    return lookup<CholeskyFactorization<T>>(Cholesky, A, hash(A), matrixBytes(n, n),
+                                            [&]() { return CholeskyFactorization<T>(A); });
+}
+
+template<typename T>
+std::shared_ptr<const QRFactorization<T>> FactorizationCache<T>::qr(const Matrix<T>& A) {
+    const size_t m = A.getRows();
+    const size_t k = std::min(m, A.getCols());
+    return lookup<QRFactorization<T>>(QR, A, hash(A), matrixBytes(m, k) + matrixBytes(k, A.getCols()),
+                                      [&]() { return QRFactorization<T>(A); });
+}
+
+template<typename T>
+std::shared_ptr<const typename FactorizationCache<T>::EigenDecomposition>
+FactorizationCache<T>::eigen(const Matrix<T>& A) {
+    const size_t n = A.getRows();
+    return lookup<EigenDecomposition>(Eigen, A, hash(A), n * sizeof(T) + matrixBytes(n, n),
+                                      [&]() { return A.eigenDecomposition(); });
+}
+
+template<typename T>
+T FactorizationCache<T>::determinant(const Matrix<T>& A) {
+    if (A.getRows() != A.getCols()) {
+        throw std::invalid_argument("Determinant can only be calculated for square matrices");
+    }
+    // Integer matrices have no LU to reuse; take Matrix's exact path
+    if constexpr (std::is_integral<T>::value) {
+        return A.determinant();
+    }
+    return lu(A)->determinant();
+}
+
+template<typename T>
+Matrix<T> FactorizationCache<T>::inverse(const Matrix<T>& A) {
+    const size_t n = A.getRows();
+    if (A.getCols() != n) {
+        throw std::invalid_argument("Only square matrices can be inverted");
+    }
+    const uint64_t key = hash(A);
+    auto result = lookup<Matrix<T>>(Inverse, A, key, matrixBytes(n, n), [&]() {
+        auto factors = lookup<LUFactorization<T>>(LU, A, key, matrixBytes(n, n) + n * sizeof(size_t),
+                                                  [&]() { return LUFactorization<T>(A); });
+        if (factors->isSingular()) {
+            throw std::runtime_error("Matrix is singular and cannot be inverted");
+        }
+        return factors->inverse();
+    });
+    return *result;
+}
+
+template<typename T>
+Matrix<T> FactorizationCache<T>::solve(const Matrix<T>& A, const Matrix<T>& B) {
+    if (A.getRows() != A.getCols()) {
+        throw std::invalid_argument("Solve requires a square coefficient matrix");
+    }
+    if (B.getRows() != A.getRows()) {
+        throw std::invalid_argument("Right-hand side rows must match matrix size");
+    }
+    if constexpr (std::is_integral<T>::value) {
+        return A.solve(B);
+    }
+    return lu(A)->solve(B);
+}
+
+template<typename T>
+FactorizationCacheStats FactorizationCache<T>::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    FactorizationCacheStats result;
+    result.hits = hits;
+    result.misses = misses;
+    result.evictions = evictions;
+    result.entries = entries.size();
+    result.bytes = usedBytes;
+    result.capacityBytes = capacityBytes;
+    return result;
+}
+
+template<typename T>
+void FactorizationCache<T>::resetStats() {
+    std::lock_guard<std::mutex> lock(mutex);
+    hits = 0;
+    misses = 0;
+    evictions = 0;
+}
+
+template<typename T>
+void FactorizationCache<T>::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    index.clear();
+    entries.clear();
+    usedBytes = 0;
+}
+
+template<typename T>
+size_t FactorizationCache<T>::capacity() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return capacityBytes;
+}
+
+template<typename T>
+void FactorizationCache<T>::setCapacity(size_t capacityBytes) {
+    std::lock_guard<std::mutex> lock(mutex);
+    this->capacityBytes = capacityBytes;
+    evict(entries.end());
+}
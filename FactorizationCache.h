@@ -0,0 +1,113 @@
+#pragma once
+#include "Matrix.h"
+#include "Checksum.h"
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Counters since construction or the last resetStats(). A lookup that has
+// to factor counts as a miss, also when the matrix is already held for
+// another kind of result.
+struct FactorizationCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;   // Matrices dropped to stay within the capacity
+    size_t entries = 0;       // Matrices currently held
+    size_t bytes = 0;         // Estimated memory of the held matrices and results
+    size_t capacityBytes = 0;
+
+    double hitRate() const {
+        const uint64_t lookups = hits + misses;
+        return lookups ? static_cast<double>(hits) / static_cast<double>(lookups) : 0.0;
+    }
+};
+
+// Opt-in cache of factorizations for services that see the same
+// coefficient matrices again and again. Matrices are looked up by a 64-bit
+// content hash of their shape and elements and then compared bit for bit,
+// so a hash collision can never return another matrix's factors; a hit costs
+// O(m * n) for hashing and comparing, against O(n^3) for factoring again.
+//
+// Every matrix seen is held once, together with whichever of its LU,
+// Cholesky, QR, symmetric eigen and inverse results have been asked for.
+// Matrices are evicted in least-recently-used order when the estimated
+// memory would exceed the capacity; a matrix whose results alone exceed it
+// is returned uncached.
+//
+// All methods may be called from several threads. Factoring happens outside
+// the lock, so concurrent misses on different matrices run in parallel
+// (two threads missing on the same matrix both factor it and the first
+// result is kept). Results are shared immutable objects and stay valid after
+// eviction.
+template<typename T = double>
+class FactorizationCache {
+public:
+    using EigenDecomposition = std::pair<std::vector<T>, Matrix<T>>;
+
+    explicit FactorizationCache(size_t capacityBytes = size_t(256) << 20);
+
+    FactorizationCache(const FactorizationCache&) = delete;
+    FactorizationCache& operator=(const FactorizationCache&) = delete;
+
+    // Cached factorizations; construction errors (e.g. a non-square matrix
+    // for LU) propagate and nothing is stored
+    std::shared_ptr<const LUFactorization<T>> lu(const Matrix<T>& A);
+    std::shared_ptr<const CholeskyFactorization<T>> cholesky(const Matrix<T>& A);
+    std::shared_ptr<const QRFactorization<T>> qr(const Matrix<T>& A);
+    std::shared_ptr<const EigenDecomposition> eigen(const Matrix<T>& A);  // A.eigenDecomposition()
+
+    // Cached counterparts of A.determinant(), A.inverse() and A.solve(B),
+    // with the same errors; for integer T determinant and solve forward to
+    // Matrix's exact versions and are not cached
+    T determinant(const Matrix<T>& A);
+    Matrix<T> inverse(const Matrix<T>& A);
+    Matrix<T> solve(const Matrix<T>& A, const Matrix<T>& B);
+
+    FactorizationCacheStats stats() const;
+    void resetStats();  // Zeroes hits, misses and evictions
+    void clear();       // Drops every entry (not counted as evictions)
+
+    size_t capacity() const;
+    void setCapacity(size_t capacityBytes);  // Evicts down to the new capacity
+
+    // Content hash of the shape and the bytes of the elements
+    static uint64_t hash(const Matrix<T>& A);
+
+private:
+    enum Kind { LU, Cholesky, QR, Eigen, Inverse, KIND_COUNT };
+
+    struct Entry {
+        uint64_t hash;
+        Matrix<T> key;
+        std::shared_ptr<const void> results[KIND_COUNT];
+        size_t bytes;
+    };
+    using EntryList = std::list<Entry>;  // Most recently used first
+
+    mutable std::mutex mutex;
+    EntryList entries;
+    std::unordered_multimap<uint64_t, typename EntryList::iterator> index;
+    size_t capacityBytes;
+    size_t usedBytes;
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+
+    // Result of `kind` for A, from the cache or from factor(); `bytes` is the
+    // result's estimated size
+    template<typename Result, typename Factor>
+    std::shared_ptr<const Result> lookup(Kind kind, const Matrix<T>& A, uint64_t key, size_t bytes, Factor factor);
+
+    typename EntryList::iterator find(const Matrix<T>& A, uint64_t key);
+    void evict(typename EntryList::iterator keep);  // Caller holds the lock
+    void erase(typename EntryList::iterator entry);
+
+    static bool sameContents(const Matrix<T>& A, const Matrix<T>& B);
+    static size_t matrixBytes(size_t rows, size_t cols);
+};
+
+#include "FactorizationCache.cpp"  // Include implementation (header-only library)
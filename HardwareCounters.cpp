@@ -0,0 +1,317 @@
+#include "HardwareCounters.h"
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__AVX512F__) || defined(__FMA__)
+#include <immintrin.h>
+#endif
+
+// ---------------------------------------------------------------------------
+// Allocation counting: replacement global operator new / delete. The array
+// and nothrow forms forward to these by default, so every heap allocation
+// made through new is counted.
+// ---------------------------------------------------------------------------
+
+static std::atomic<uint64_t> allocationCounter{0};
+static std::atomic<uint64_t> allocatedByteCounter{0};
+
+void* operator new(std::size_t size) {
+    allocationCounter.fetch_add(1, std::memory_order_relaxed);
+    allocatedByteCounter.fetch_add(size, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    allocationCounter.fetch_add(1, std::memory_order_relaxed);
+    allocatedByteCounter.fetch_add(size, std::memory_order_relaxed);
+    const std::size_t align = static_cast<std::size_t>(alignment);
+    const std::size_t rounded = (std::max<std::size_t>(size, 1) + align - 1) / align * align;
+    if (void* pointer = std::aligned_alloc(align, rounded)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept { std::free(pointer); }
+
+uint64_t MemoryStats::allocationCount() {
+    return allocationCounter.load(std::memory_order_relaxed);
+}
+
+uint64_t MemoryStats::allocatedBytes() {
+    return allocatedByteCounter.load(std::memory_order_relaxed);
+}
+
+// ---------------------------------------------------------------------------
+// Resident set size
+// ---------------------------------------------------------------------------
+
+// Value in bytes of a "Name:   1234 kB" line of /proc/self/status
+static size_t procStatusBytes(const char* field) {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    const size_t length = std::strlen(field);
+    while (std::getline(status, line)) {
+        if (line.compare(0, length, field) == 0) {
+            return static_cast<size_t>(std::strtoull(line.c_str() + length, nullptr, 10)) * 1024;
+        }
+    }
+    return 0;
+}
+
+size_t MemoryStats::currentRss() {
+    return procStatusBytes("VmRSS:");
+}
+
+size_t MemoryStats::peakRss() {
+    const size_t peak = procStatusBytes("VmHWM:");
+#ifdef __linux__
+    if (peak == 0) {
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) == 0) return static_cast<size_t>(usage.ru_maxrss) * 1024;
+    }
+#endif
+    return peak;
+}
+
+bool MemoryStats::resetPeakRss() {
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    clearRefs << "5";
+    clearRefs.flush();
+    return static_cast<bool>(clearRefs);
+}
+
+// ---------------------------------------------------------------------------
+// perf_event counters
+// ---------------------------------------------------------------------------
+
+#ifdef __linux__
+static int openCounter(uint32_t type, uint64_t config) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.inherit = 1;  // Threads started while open add their counts when they exit
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+static bool isIntel() {
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+        if (line.compare(0, 9, "vendor_id") == 0) return line.find("GenuineIntel") != std::string::npos;
+    }
+    return false;
+}
+#endif
+
+PerfCounters::PerfCounters() {
+    for (int& fd : fds) fd = -1;
+#ifdef __linux__
+    fds[CYCLES] = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    if (fds[CYCLES] < 0) return;  // No perf_event access at all
+    fds[INSTRUCTIONS] = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    fds[CACHE_MISSES] = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    if (isIntel()) {
+        // FP_ARITH_INST_RETIRED (event 0xC7): scalar, 128-, 256- and 512-bit packed double
+        fds[FP_SCALAR] = openCounter(PERF_TYPE_RAW, 0xC7 | (0x01 << 8));
+        fds[FP_128] = openCounter(PERF_TYPE_RAW, 0xC7 | (0x04 << 8));
+        fds[FP_256] = openCounter(PERF_TYPE_RAW, 0xC7 | (0x10 << 8));
+        fds[FP_512] = openCounter(PERF_TYPE_RAW, 0xC7 | (0x40 << 8));
+    }
+#endif
+}
+
+PerfCounters::~PerfCounters() {
+#ifdef __linux__
+    for (int fd : fds) {
+        if (fd >= 0) close(fd);
+    }
+#endif
+}
+
+PerfCounters& PerfCounters::forThisThread() {
+    thread_local PerfCounters counters;
+    return counters;
+}
+
+void PerfCounters::start() {
+#ifdef __linux__
+    for (int fd : fds) {
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+#endif
+}
+
+void PerfCounters::stop() {
+#ifdef __linux__
+    for (int fd : fds) {
+        if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+#endif
+}
+
+double PerfCounters::value(Event event) const {
+    const double missing = std::numeric_limits<double>::quiet_NaN();
+#ifdef __linux__
+    if (fds[event] < 0) return missing;
+    uint64_t values[3];  // count, time enabled, time running
+    if (::read(fds[event], values, sizeof(values)) != static_cast<ssize_t>(sizeof(values)) || values[2] == 0) {
+        return missing;
+    }
+    // Multiplexed events ran only part of the time; extrapolate
+    return static_cast<double>(values[0]) * static_cast<double>(values[1]) / static_cast<double>(values[2]);
+#else
+    (void)event;
+    return missing;
+#endif
+}
+
+double PerfCounters::flops() const {
+    const double scalar = value(FP_SCALAR);
+    if (std::isnan(scalar)) return scalar;
+    // Unsupported widths (e.g. no AVX-512) count as zero
+    auto packed = [this](Event event, double lanes) {
+        const double count = value(event);
+        return std::isnan(count) ? 0.0 : count * lanes;
+    };
+    return scalar + packed(FP_128, 2.0) + packed(FP_256, 4.0) + packed(FP_512, 8.0);
+}
+
+#ifdef __linux__
+static double cpuSeconds(int who) {
+    struct rusage usage;
+    if (getrusage(who, &usage) != 0) return 0.0;
+    return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+           static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1e-6;
+}
+#endif
+
+double PerfCounters::processCpuSeconds() {
+#ifdef __linux__
+    return cpuSeconds(RUSAGE_SELF);
+#else
+    return 0.0;
+#endif
+}
+
+double PerfCounters::threadCpuSeconds() {
+#ifdef __linux__
+    return cpuSeconds(RUSAGE_THREAD);
+#else
+    return 0.0;
+#endif
+}
+
+// ---------------------------------------------------------------------------
+// Roofline
+// ---------------------------------------------------------------------------
+
+// Independent FMA chains, enough to cover FMA latency on both ports, in the
+// widest vector type the build targets
+#if defined(__GNUC__) || defined(__clang__)
+#if defined(__AVX512F__)
+typedef double PeakVector __attribute__((vector_size(64)));
+#elif defined(__AVX__)
+typedef double PeakVector __attribute__((vector_size(32)));
+#else
+typedef double PeakVector __attribute__((vector_size(16)));
+#endif
+static constexpr size_t PEAK_LANES = sizeof(PeakVector) / sizeof(double);
+#else
+typedef double PeakVector;
+static constexpr size_t PEAK_LANES = 1;
+#endif
+static constexpr size_t PEAK_CHAINS = 12;
+static constexpr size_t PEAK_ITERATIONS = 100000;
+
+// Explicit FMA: -std=c++17 disables contraction of a * b + c
+static inline PeakVector fusedMultiplyAdd(PeakVector a, PeakVector b, PeakVector c) {
+#if defined(__AVX512F__)
+    return _mm512_fmadd_pd(a, b, c);
+#elif defined(__FMA__)
+    return _mm256_fmadd_pd(a, b, c);
+#else
+    return a * b + c;
+#endif
+}
+
+static void peakFlopsKernel(PeakVector* accumulators, PeakVector multiplier, PeakVector addend) {
+    PeakVector a[PEAK_CHAINS];
+    for (size_t k = 0; k < PEAK_CHAINS; ++k) a[k] = accumulators[k];
+    for (size_t i = 0; i < PEAK_ITERATIONS; ++i) {
+        for (size_t k = 0; k < PEAK_CHAINS; ++k) a[k] = fusedMultiplyAdd(a[k], multiplier, addend);
+    }
+    for (size_t k = 0; k < PEAK_CHAINS; ++k) accumulators[k] = a[k];
+}
+
+RooflineModel RooflineModel::measure() {
+    RooflineModel model;
+    BenchmarkConfig config;
+    config.maxTimeMs = 300.0;
+    config.targetRelativeCI = 0.01;
+
+    const PeakVector zero = {};
+    PeakVector accumulators[PEAK_CHAINS];
+    for (PeakVector& accumulator : accumulators) accumulator = zero + 1.0;
+    const PeakVector multiplier = zero + 0.9999999;
+    const PeakVector addend = zero + 1e-7;
+    const BenchmarkStats peak = BenchmarkHarness::run("peak flops", [&]() {
+        peakFlopsKernel(accumulators, multiplier, addend);
+        doNotOptimize(accumulators);
+    }, config);
+    const double peakFlops = 2.0 * PEAK_LANES * PEAK_CHAINS * PEAK_ITERATIONS;
+    model.peakGflops = peakFlops / (peak.minMs * 1e6);
+
+    // STREAM triad on arrays well beyond the last-level cache
+    size_t arrayBytes = size_t(64) << 20;
+#ifdef _SC_LEVEL3_CACHE_SIZE
+    const long l3 = sysconf(_SC_LEVEL3_CACHE_SIZE);
+    if (l3 > 0) arrayBytes = std::max(arrayBytes, std::min(size_t(4) * static_cast<size_t>(l3), size_t(256) << 20));
+#endif
+    const size_t n = arrayBytes / sizeof(double);
+    std::vector<double> a(n, 0.0), b(n, 1.0), c(n, 2.0);
+    const double scalar = 3.0;
+    const BenchmarkStats triad = BenchmarkHarness::run("stream triad", [&]() {
+        double* __restrict out = a.data();
+        const double* __restrict x = b.data();
+        const double* __restrict y = c.data();
+        for (size_t i = 0; i < n; ++i) out[i] = x[i] + scalar * y[i];
+        doNotOptimize(a.data());
+    }, config);
+    model.bandwidthGBs = 3.0 * sizeof(double) * n / (triad.minMs * 1e6);
+    return model;
+}
+
+const RooflineModel& RooflineModel::host() {
+    static const RooflineModel model = measure();
+    return model;
+}
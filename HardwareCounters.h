@@ -0,0 +1,136 @@
+#pragma once
+#include "BenchmarkHarness.h"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+// Hardware and memory instrumentation for the benchmark suite: Linux
+// perf_event counters, resident set size, heap allocation counts and a
+// measured roofline of the host.
+
+// Per-call counter values of one kernel. Counters the host does not expose
+// (no perf_event access, unsupported event) are NaN, and so are all the
+// perf counters of kernels that hand work to other threads.
+struct KernelProfile {
+    double cycles = std::numeric_limits<double>::quiet_NaN();
+    double instructions = std::numeric_limits<double>::quiet_NaN();
+    double cacheMisses = std::numeric_limits<double>::quiet_NaN();   // Last-level cache
+    double fpOps = std::numeric_limits<double>::quiet_NaN();         // Retired double-precision flops
+    double allocations = 0.0;       // operator new calls per call
+    double allocatedBytes = 0.0;
+    size_t peakRssBytes = 0;        // Process peak RSS while the kernel ran
+
+    double ipc() const { return instructions / cycles; }
+};
+
+// Hardware counters of the calling thread, and of threads it starts while
+// the counters are open once those exit, via perf_event_open. Each event
+// is opened on its own (not as a group) so the kernel can multiplex them
+// when there are fewer physical counters than events; values are scaled by
+// enabled/running time. FP events use the Intel FP_ARITH_INST_RETIRED
+// encodings and are only opened on Intel CPUs.
+class PerfCounters {
+public:
+    enum Event { CYCLES, INSTRUCTIONS, CACHE_MISSES, FP_SCALAR, FP_128, FP_256, FP_512, EVENT_COUNT };
+
+    PerfCounters();
+    ~PerfCounters();
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    // Counters of the calling thread, opened on first use
+    static PerfCounters& forThisThread();
+
+    // True when at least the cycle counter could be opened
+    bool available() const { return fds[CYCLES] >= 0; }
+
+    void start();
+    void stop();
+
+    // Scaled count since the last start(); NaN when the event is not open
+    double value(Event event) const;
+
+    // Double-precision flops from the FP events (FMA counts as two)
+    double flops() const;
+
+    // User + system CPU seconds of the whole process and of the calling
+    // thread; 0 where getrusage cannot report them
+    static double processCpuSeconds();
+    static double threadCpuSeconds();
+
+private:
+    int fds[EVENT_COUNT];
+};
+
+// Resident set size and heap allocation counters. The allocation counters
+// come from the replaceable global operator new in HardwareCounters.cpp and
+// cover every allocation in the process.
+class MemoryStats {
+public:
+    static size_t currentRss();
+    static size_t peakRss();
+    // Restarts peak tracking at the current RSS (Linux /proc/self/clear_refs);
+    // returns false when the kernel does not support it
+    static bool resetPeakRss();
+
+    static uint64_t allocationCount();
+    static uint64_t allocatedBytes();
+};
+
+// Single-core roofline of the host: peak FMA throughput and STREAM triad
+// bandwidth, both measured with BenchmarkHarness (best sample). A kernel
+// with arithmetic intensity I flop/byte can at best reach
+// min(peak, I * bandwidth).
+struct RooflineModel {
+    double peakGflops = 0.0;
+    double bandwidthGBs = 0.0;
+
+    double ridgePoint() const { return peakGflops / bandwidthGBs; }
+    double attainableGflops(double intensity) const {
+        return std::min(peakGflops, intensity * bandwidthGBs);
+    }
+
+    static RooflineModel measure();
+    static const RooflineModel& host();  // measure(), once per process
+};
+
+// Runs func `calls` times with perf counters, allocation counters and peak
+// RSS tracking around it and returns per-call values. Kept apart from the
+// timed samples so that reading counters does not perturb the timings.
+template<typename Func>
+KernelProfile profileKernel(Func&& func, size_t calls) {
+    PerfCounters& counters = PerfCounters::forThisThread();
+    KernelProfile profile;
+    calls = std::max<size_t>(calls, 1);
+
+    const bool peakReset = MemoryStats::resetPeakRss();
+    const uint64_t allocationsBefore = MemoryStats::allocationCount();
+    const uint64_t bytesBefore = MemoryStats::allocatedBytes();
+    const double processBefore = PerfCounters::processCpuSeconds();
+    const double threadBefore = PerfCounters::threadCpuSeconds();
+    counters.start();
+    for (size_t i = 0; i < calls; ++i) {
+        func();
+        clobberMemory();
+    }
+    counters.stop();
+    const double threadCpu = PerfCounters::threadCpuSeconds() - threadBefore;
+    const double otherCpu = PerfCounters::processCpuSeconds() - processBefore - threadCpu;
+    const uint64_t allocationsAfter = MemoryStats::allocationCount();
+    const uint64_t bytesAfter = MemoryStats::allocatedBytes();
+
+    const double perCall = 1.0 / static_cast<double>(calls);
+    // Persistent helpers (parallelFor, ThreadPool) are not counted, so the
+    // counts would cover only part of a multi-threaded kernel
+    if (otherCpu <= 0.05 * threadCpu + 1e-4) {
+        profile.cycles = counters.value(PerfCounters::CYCLES) * perCall;
+        profile.instructions = counters.value(PerfCounters::INSTRUCTIONS) * perCall;
+        profile.cacheMisses = counters.value(PerfCounters::CACHE_MISSES) * perCall;
+        profile.fpOps = counters.flops() * perCall;
+    }
+    profile.allocations = static_cast<double>(allocationsAfter - allocationsBefore) * perCall;
+    profile.allocatedBytes = static_cast<double>(bytesAfter - bytesBefore) * perCall;
+    profile.peakRssBytes = peakReset ? MemoryStats::peakRss() : 0;
+    return profile;
+}
@@ -1,159 +1,683 @@
 #include "Matrix.h"
-#include <random>
 #include <chrono>
 
 // Addition operator
 template<typename T>
-Matrix<T> Matrix<T>::operator+(const Matrix<T>& other) const {
+Matrix<T> Matrix<T>::operator+(const Matrix<T>& other) const & {
+    LINALG_PROFILE("Matrix::add", rows, cols, double(rows) * cols, 3.0 * rows * cols * sizeof(T));
     if (rows != other.rows || cols != other.cols) {
         throw std::invalid_argument("Matrix dimensions must match for addition");
     }
     
-    Matrix<T> result(rows, cols);
-    for (size_t i = 0; i < rows; ++i) {
-        for (size_t j = 0; j < cols; ++j) {
-            result.data[i][j] = data[i][j] + other.data[i][j];
+    Matrix<T> result = unsizedRows(rows, cols);
+    parallelFor(rows, cols, Tuning::parameters<T>(), [&](size_t i0, size_t i1) {
+        for (size_t i = i0; i < i1; ++i) {
+            const T* a = data[i].data();
+            const T* b = other.data[i].data();
+            std::vector<T>& out = result.data[i];
+            out.resize(cols);
+            for (size_t j = 0; j < cols; ++j) out[j] = a[j] + b[j];
         }
-    }
+    });
     return result;
 }
 
+// Addition into an expiring left operand
+template<typename T>
+Matrix<T> Matrix<T>::operator+(const Matrix<T>& other) && {
+    *this += other;
+    return std::move(*this);
+}
+
 // Subtraction operator
 template<typename T>
-Matrix<T> Matrix<T>::operator-(const Matrix<T>& other) const {
+Matrix<T> Matrix<T>::operator-(const Matrix<T>& other) const & {
+    LINALG_PROFILE("Matrix::subtract", rows, cols, double(rows) * cols, 3.0 * rows * cols * sizeof(T));
     if (rows != other.rows || cols != other.cols) {
         throw std::invalid_argument("Matrix dimensions must match for subtraction");
     }
     
-    Matrix<T> result(rows, cols);
-    for (size_t i = 0; i < rows; ++i) {
-        for (size_t j = 0; j < cols; ++j) {
-            result.data[i][j] = data[i][j] - other.data[i][j];
+    Matrix<T> result = unsizedRows(rows, cols);
+    parallelFor(rows, cols, Tuning::parameters<T>(), [&](size_t i0, size_t i1) {
+        for (size_t i = i0; i < i1; ++i) {
+            const T* a = data[i].data();
+            const T* b = other.data[i].data();
+            std::vector<T>& out = result.data[i];
+            out.resize(cols);
+            for (size_t j = 0; j < cols; ++j) out[j] = a[j] - b[j];
         }
-    }
+    });
     return result;
 }
 
+// Subtraction into an expiring left operand
+template<typename T>
+Matrix<T> Matrix<T>::operator-(const Matrix<T>& other) && {
+    *this -= other;
+    return std::move(*this);
+}
+
 // Optimized matrix multiplication using cache-friendly approach
 template<typename T>
 Matrix<T> Matrix<T>::operator*(const Matrix<T>& other) const {
+    LINALG_PROFILE("Matrix::multiply", rows, other.cols, 2.0 * rows * cols * other.cols,
+                   double(rows * cols + other.rows * other.cols + rows * other.cols) * sizeof(T));
     if (cols != other.rows) {
         throw std::invalid_argument("Invalid matrix dimensions for multiplication");
     }
     
     Matrix<T> result(rows, other.cols);
+    const size_t strassenCutoff = Tuning::parameters<T>().strassenCutoff;
+    if (strassenCutoff > 0 && std::min({rows, cols, other.cols}) >= strassenCutoff) {
+        strassen(rows, other.cols, cols, *this, 0, 0, other, 0, 0, result, 0, 0, strassenCutoff);
+    } else {
+        gemm(rows, other.cols, cols, T(1), *this, 0, 0, other, 0, 0, result, 0, 0);
+    }
+    return result;
+}
+
+namespace matrix_detail {
+
+// gemm micro-kernel: rows [i0, i1) of the C block, columns [j0, j1) and
+// depth [p0, p1). ROWS rows of C are updated per pass over a row of B, so
+// each loaded element of B is used ROWS times.
+template<size_t ROWS, typename T>
+void gemmRows(size_t i0, size_t i1, size_t j0, size_t j1, size_t p0, size_t p1, const T& alpha,
+              const std::vector<std::vector<T>>& A, size_t ai, size_t aj,
+              const std::vector<std::vector<T>>& B, size_t bi, size_t bj,
+              std::vector<std::vector<T>>& C, size_t ci, size_t cj) {
+    size_t i = i0;
+    for (; i + ROWS <= i1; i += ROWS) {
+        const T* a_row[ROWS];
+        T* c_row[ROWS];
+        for (size_t r = 0; r < ROWS; ++r) {
+            a_row[r] = A[ai + i + r].data() + aj;
+            c_row[r] = C[ci + i + r].data() + cj;
+        }
+        for (size_t p = p0; p < p1; ++p) {
+            T a[ROWS];
+            for (size_t r = 0; r < ROWS; ++r) a[r] = alpha * a_row[r][p];
+            // Skipping zero multipliers would turn 0 * Inf and 0 * NaN from B
+            // into 0, so only integer types take the shortcut
+            if constexpr (std::is_integral<T>::value) {
+                bool all_zero = true;
+                for (size_t r = 0; r < ROWS; ++r) all_zero = all_zero && a[r] == T(0);
+                if (all_zero) continue;
+            }
+            const T* b_row = B[bi + p].data() + bj;
+            for (size_t j = j0; j < j1; ++j) {
+                const T b = b_row[j];
+                for (size_t r = 0; r < ROWS; ++r) c_row[r][j] += a[r] * b;
+            }
+        }
+    }
+    if (ROWS > 1 && i < i1) {
+        gemmRows<1>(i, i1, j0, j1, p0, p1, alpha, A, ai, aj, B, bi, bj, C, ci, cj);
+    }
+}
+
+}  // namespace matrix_detail
+
+// Blocked multiply-accumulate on sub-blocks:
+//   C[ci.., cj..] (m x n) += alpha * A[ai.., aj..] (m x k) * B[bi.., bj..] (k x n)
+// The innermost loop streams a row of B into a row of C, so it vectorizes
+// on row-major storage. A, B and C may be the same matrix as long as the
+// C block does not overlap the A or B blocks.
+template<typename T>
+void Matrix<T>::gemm(size_t m, size_t n, size_t k, const T& alpha,
+                     const Matrix<T>& A, size_t ai, size_t aj,
+                     const Matrix<T>& B, size_t bi, size_t bj,
+                     Matrix<T>& C, size_t ci, size_t cj) {
+    LINALG_PROFILE("Matrix::gemm", m, n, 2.0 * m * n * k, double(m * k + k * n + 2 * m * n) * sizeof(T));
+    gemmThreads(m, n, k, alpha, A, ai, aj, B, bi, bj, C, ci, cj, 0);
+}
+
+template<typename T>
+void Matrix<T>::gemmThreads(size_t m, size_t n, size_t k, const T& alpha,
+                            const Matrix<T>& A, size_t ai, size_t aj,
+                            const Matrix<T>& B, size_t bi, size_t bj,
+                            Matrix<T>& C, size_t ci, size_t cj, unsigned workers) {
+    if (ai + m > A.rows || aj + k > A.cols || bi + k > B.rows || bj + n > B.cols ||
+        ci + m > C.rows || cj + n > C.cols) {
+        throw std::out_of_range("Matrix block exceeds matrix bounds");
+    }
+    if (m == 0 || n == 0 || k == 0) return;
     
-    // Cache-friendly blocked matrix multiplication for large matrices
-    const size_t BLOCK_SIZE = 64; // Optimal for most modern CPUs
-    
-    if (rows > BLOCK_SIZE || cols > BLOCK_SIZE || other.cols > BLOCK_SIZE) {
-        // Blocked multiplication for large matrices
-        for (size_t ii = 0; ii < rows; ii += BLOCK_SIZE) {
-            for (size_t jj = 0; jj < other.cols; jj += BLOCK_SIZE) {
-                for (size_t kk = 0; kk < cols; kk += BLOCK_SIZE) {
-                    // Process block
-                    size_t i_end = std::min(ii + BLOCK_SIZE, rows);
-                    size_t j_end = std::min(jj + BLOCK_SIZE, other.cols);
-                    size_t k_end = std::min(kk + BLOCK_SIZE, cols);
-                    
-                    for (size_t i = ii; i < i_end; ++i) {
-                        for (size_t j = jj; j < j_end; ++j) {
-                            T sum = T(0);
-                            for (size_t k = kk; k < k_end; ++k) {
-                                sum += data[i][k] * other.data[k][j];
-                            }
-                            result.data[i][j] += sum;
-                        }
+    // Block sizes, micro-kernel and threading threshold come from the host's
+    // tuning (Tuning.h)
+    const KernelTuning& tuning = Tuning::parameters<T>();
+    const size_t BLOCK_SIZE = tuning.gemmBlockK;
+    const size_t COL_BLOCK = tuning.gemmBlockN;
+    const size_t MICRO_ROWS = tuning.gemmMicroRows;
+    
+    auto multiplyRows = [&](size_t i0, size_t i1) {
+        for (size_t kk = 0; kk < k; kk += BLOCK_SIZE) {
+            size_t k_end = std::min(kk + BLOCK_SIZE, k);
+            for (size_t jj = 0; jj < n; jj += COL_BLOCK) {
+                size_t j_end = std::min(jj + COL_BLOCK, n);
+                if (MICRO_ROWS == 4) {
+                    matrix_detail::gemmRows<4>(i0, i1, jj, j_end, kk, k_end, alpha, A.data, ai, aj, B.data, bi, bj, C.data, ci, cj);
+                } else if (MICRO_ROWS == 2) {
+                    matrix_detail::gemmRows<2>(i0, i1, jj, j_end, kk, k_end, alpha, A.data, ai, aj, B.data, bi, bj, C.data, ci, cj);
+                } else {
+                    matrix_detail::gemmRows<1>(i0, i1, jj, j_end, kk, k_end, alpha, A.data, ai, aj, B.data, bi, bj, C.data, ci, cj);
+                }
+            }
+        }
+    };
+    
+    // Large products split the rows of C across threads; every thread
+    // writes disjoint rows and only reads A and B
+    if (workers == 0) {
+        workers = tuning.threads ? tuning.threads : std::thread::hardware_concurrency();
+        if (tuning.parallelMinFlops <= 0.0 || 2.0 * m * n * k < tuning.parallelMinFlops) workers = 1;
+    }
+    workers = static_cast<unsigned>(std::min<size_t>(workers, m / MICRO_ROWS));
+    if (workers < 2) {
+        multiplyRows(0, m);
+        return;
+    }
+    // ceil(m / workers) rounded up to whole micro-tiles, so that there are
+    // never more chunks than workers
+    const size_t perWorker = (m + workers - 1) / workers;
+    const size_t chunk = (perWorker + MICRO_ROWS - 1) / MICRO_ROWS * MICRO_ROWS;
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    for (size_t begin = chunk; begin < m; begin += chunk) {
+        const size_t end = std::min(begin + chunk, m);
+        threads.emplace_back([&multiplyRows, begin, end, n]() {
+            LINALG_PROFILE("Matrix::gemm.worker", end - begin, n);
+            multiplyRows(begin, end);
+        });
+    }
+    multiplyRows(0, std::min(chunk, m));
+    for (std::thread& thread : threads) thread.join();
+}
+
+// Strassen's algorithm on blocks: C (m x n) += A (m x k) * B (k x n).
+// One level splits each operand into quadrants and forms the seven
+// products
+//   M1 = (A11 + A22)(B11 + B22)   M5 = (A11 + A12) B22
+//   M2 = (A21 + A22) B11          M6 = (A21 - A11)(B11 + B12)
+//   M3 = A11 (B12 - B22)          M7 = (A12 - A22)(B21 + B22)
+//   M4 = A22 (B21 - B11)
+// recursively until a dimension drops below the cutoff, where gemm takes
+// over. Odd dimensions are handled by peeling the last row, column or
+// depth slice into gemm calls. Each product is accumulated into C as soon
+// as it is formed, so a level needs three half-size temporaries.
+template<typename T>
+void Matrix<T>::strassen(size_t m, size_t n, size_t k,
+                         const Matrix<T>& A, size_t ai, size_t aj,
+                         const Matrix<T>& B, size_t bi, size_t bj,
+                         Matrix<T>& C, size_t ci, size_t cj, size_t cutoff) {
+    if (std::min({m, n, k}) < std::max<size_t>(cutoff, 2)) {
+        gemm(m, n, k, T(1), A, ai, aj, B, bi, bj, C, ci, cj);
+        return;
+    }
+    const size_t m2 = m / 2, n2 = n / 2, k2 = k / 2;
+    
+    // S <- X + sign * Y on r x c blocks (Y may be omitted)
+    auto combine = [](Matrix<T>& S, size_t r, size_t c, const Matrix<T>& X, size_t xi, size_t xj,
+                      const Matrix<T>* Y, size_t yi, size_t yj, T sign) {
+        for (size_t i = 0; i < r; ++i) {
+            const T* x = X.data[xi + i].data() + xj;
+            T* s = S.data[i].data();
+            if (Y) {
+                const T* y = Y->data[yi + i].data() + yj;
+                for (size_t j = 0; j < c; ++j) s[j] = x[j] + sign * y[j];
+            } else {
+                for (size_t j = 0; j < c; ++j) s[j] = x[j];
+            }
+        }
+    };
+    // C block at (ri, rj) += sign * P
+    auto accumulate = [&C, m2, n2](const Matrix<T>& P, size_t ri, size_t rj, T sign) {
+        for (size_t i = 0; i < m2; ++i) {
+            const T* p = P.data[i].data();
+            T* c = C.data[ri + i].data() + rj;
+            for (size_t j = 0; j < n2; ++j) c[j] += sign * p[j];
+        }
+    };
+    
+    Matrix<T> SA(m2, k2), SB(k2, n2), P(m2, n2);
+    const T plus = T(1), minus = T(-1);
+    auto product = [&](const Matrix<T>& X, size_t xi, size_t xj, const Matrix<T>& Y, size_t yi, size_t yj) {
+        P.fill(T(0));
+        strassen(m2, n2, k2, X, xi, xj, Y, yi, yj, P, 0, 0, cutoff);
+    };
+    const size_t A12j = aj + k2, A21i = ai + m2, B12j = bj + n2, B21i = bi + k2;
+    const size_t C12j = cj + n2, C21i = ci + m2;
+    
+    combine(SA, m2, k2, A, ai, aj, &A, A21i, A12j, plus);         // A11 + A22
+    combine(SB, k2, n2, B, bi, bj, &B, B21i, B12j, plus);         // B11 + B22
+    product(SA, 0, 0, SB, 0, 0);                                  // M1
+    accumulate(P, ci, cj, plus);
+    accumulate(P, C21i, C12j, plus);
+    
+    combine(SA, m2, k2, A, A21i, aj, &A, A21i, A12j, plus);       // A21 + A22
+    product(SA, 0, 0, B, bi, bj);                                 // M2
+    accumulate(P, C21i, cj, plus);
+    accumulate(P, C21i, C12j, minus);
+    
+    combine(SB, k2, n2, B, bi, B12j, &B, B21i, B12j, minus);      // B12 - B22
+    product(A, ai, aj, SB, 0, 0);                                 // M3
+    accumulate(P, ci, C12j, plus);
+    accumulate(P, C21i, C12j, plus);
+    
+    combine(SB, k2, n2, B, B21i, bj, &B, bi, bj, minus);          // B21 - B11
+    product(A, A21i, A12j, SB, 0, 0);                             // M4
+    accumulate(P, ci, cj, plus);
+    accumulate(P, C21i, cj, plus);
+    
+    combine(SA, m2, k2, A, ai, aj, &A, ai, A12j, plus);           // A11 + A12
+    product(SA, 0, 0, B, B21i, B12j);                             // M5
+    accumulate(P, ci, cj, minus);
+    accumulate(P, ci, C12j, plus);
+    
+    combine(SA, m2, k2, A, A21i, aj, &A, ai, aj, minus);          // A21 - A11
+    combine(SB, k2, n2, B, bi, bj, &B, bi, B12j, plus);           // B11 + B12
+    product(SA, 0, 0, SB, 0, 0);                                  // M6
+    accumulate(P, C21i, C12j, plus);
+    
+    combine(SA, m2, k2, A, ai, A12j, &A, A21i, A12j, minus);      // A12 - A22
+    combine(SB, k2, n2, B, B21i, bj, &B, B21i, B12j, plus);       // B21 + B22
+    product(SA, 0, 0, SB, 0, 0);                                  // M7
+    accumulate(P, ci, cj, plus);
+    
+    // Peel the odd depth slice, last column and last row
+    if (k > 2 * k2) {
+        gemm(2 * m2, 2 * n2, k - 2 * k2, T(1), A, ai, aj + 2 * k2, B, bi + 2 * k2, bj, C, ci, cj);
+    }
+    if (n > 2 * n2) {
+        gemm(m, n - 2 * n2, k, T(1), A, ai, aj, B, bi, bj + 2 * n2, C, ci, cj + 2 * n2);
+    }
+    if (m > 2 * m2) {
+        gemm(m - 2 * m2, 2 * n2, k, T(1), A, ai + 2 * m2, aj, B, bi, bj, C, ci + 2 * m2, cj);
+    }
+}
+
+namespace matrix_detail {
+
+// Complex conjugate that keeps real types real (std::conj of a double is a
+// std::complex)
+template<typename T>
+T conjugate(const T& value) { return value; }
+
+template<typename T>
+std::complex<T> conjugate(const std::complex<T>& value) { return std::conj(value); }
+
+}  // namespace matrix_detail
+
+template<typename T>
+void Matrix<T>::syrk(TriangleType uplo, TransposeType trans, size_t n, size_t k, const T& alpha,
+                     const Matrix<T>& A, size_t ai, size_t aj, Matrix<T>& C, size_t ci, size_t cj) {
+    LINALG_PROFILE("Matrix::syrk", n, n, double(n) * (n + 1) * k, double(n * k + n * (n + 1)) * sizeof(T));
+    rankK(uplo, trans, false, n, k, alpha, A, ai, aj, C, ci, cj, 0);
+}
+
+template<typename T>
+void Matrix<T>::herk(TriangleType uplo, TransposeType trans, size_t n, size_t k, const T& alpha,
+                     const Matrix<T>& A, size_t ai, size_t aj, Matrix<T>& C, size_t ci, size_t cj) {
+    LINALG_PROFILE("Matrix::herk", n, n, double(n) * (n + 1) * k, double(n * k + n * (n + 1)) * sizeof(T));
+    rankK(uplo, trans, true, n, k, alpha, A, ai, aj, C, ci, cj, 0);
+}
+
+// Rank-k update through the gemm micro-kernel:
+//   C[i][j] += alpha * sum_p X[i][p] * Y[p][j],  X = op(A), Y = X^T (or X^H)
+// One of X and Y is A itself. The other is packed one depth panel at a time,
+// and only for the rows (Transpose) or columns (NoTranspose) of C that are
+// in the triangle, so the flop count is half that of the general product.
+// Tiles left of (upper) or below (lower) the diagonal run the multi-row
+// micro-kernel; diagonal tiles are updated row by row up to the diagonal.
+template<typename T>
+void Matrix<T>::rankK(TriangleType uplo, TransposeType trans, bool conjugate, size_t n, size_t k, const T& alpha,
+                      const Matrix<T>& A, size_t ai, size_t aj, Matrix<T>& C, size_t ci, size_t cj, unsigned workers) {
+    const bool upper = (uplo == TriangleType::Upper);
+    const bool transposed = (trans == TransposeType::Transpose);
+    const size_t aRows = transposed ? k : n;
+    const size_t aCols = transposed ? n : k;
+    if (ai + aRows > A.rows || aj + aCols > A.cols || ci + n > C.rows || cj + n > C.cols) {
+        throw std::out_of_range("Matrix block exceeds matrix bounds");
+    }
+    if (n == 0) return;
+    
+    const KernelTuning& tuning = Tuning::parameters<T>();
+    const size_t BLOCK_SIZE = tuning.gemmBlockK;
+    const size_t COL_BLOCK = tuning.gemmBlockN;
+    const size_t MICRO_ROWS = tuning.gemmMicroRows;
+    
+    auto updateRows = [&](size_t r0, size_t r1) {
+        // Columns of C in the triangle for these rows
+        const size_t c0 = upper ? r0 : 0;
+        const size_t c1 = upper ? n : r1;
+        std::vector<std::vector<T>> packed(transposed ? n : std::min(BLOCK_SIZE, k));
+        for (size_t kk = 0; kk < k; kk += BLOCK_SIZE) {
+            const size_t kb = std::min(BLOCK_SIZE, k - kk);
+            const std::vector<std::vector<T>>* X = &packed;
+            const std::vector<std::vector<T>>* Y = &packed;
+            size_t xi = 0, xj = 0, yi = 0, yj = 0;
+            if (transposed) {
+                // X[i][p] = A[kk + p][i]; Y is the panel of A
+                for (size_t i = r0; i < r1; ++i) packed[i].resize(kb);
+                for (size_t p = 0; p < kb; ++p) {
+                    const T* a_row = A.data[ai + kk + p].data() + aj;
+                    for (size_t i = r0; i < r1; ++i) {
+                        packed[i][p] = conjugate ? matrix_detail::conjugate(a_row[i]) : a_row[i];
+                    }
+                }
+                Y = &A.data;
+                yi = ai + kk;
+                yj = aj;
+            } else {
+                // X is the panel of A; Y[p][j] = A[j][kk + p]
+                for (size_t p = 0; p < kb; ++p) packed[p].resize(n);
+                for (size_t j = c0; j < c1; ++j) {
+                    const T* a_row = A.data[ai + j].data() + aj + kk;
+                    for (size_t p = 0; p < kb; ++p) {
+                        packed[p][j] = conjugate ? matrix_detail::conjugate(a_row[p]) : a_row[p];
+                    }
+                }
+                X = &A.data;
+                xi = ai;
+                xj = aj + kk;
+            }
+            
+            auto tile = [&](size_t i0, size_t i1, size_t j0, size_t j1) {
+                if (MICRO_ROWS == 4) {
+                    matrix_detail::gemmRows<4>(i0, i1, j0, j1, 0, kb, alpha, *X, xi, xj, *Y, yi, yj, C.data, ci, cj);
+                } else if (MICRO_ROWS == 2) {
+                    matrix_detail::gemmRows<2>(i0, i1, j0, j1, 0, kb, alpha, *X, xi, xj, *Y, yi, yj, C.data, ci, cj);
+                } else {
+                    matrix_detail::gemmRows<1>(i0, i1, j0, j1, 0, kb, alpha, *X, xi, xj, *Y, yi, yj, C.data, ci, cj);
+                }
+            };
+            for (size_t jj = c0; jj < c1; jj += COL_BLOCK) {
+                const size_t j_end = std::min(jj + COL_BLOCK, c1);
+                const size_t diag_begin = std::max(r0, jj);
+                const size_t diag_end = std::min(r1, j_end);
+                if (upper) {
+                    tile(r0, std::min(r1, jj), jj, j_end);
+                    for (size_t i = diag_begin; i < diag_end; ++i) {
+                        matrix_detail::gemmRows<1>(i, i + 1, i, j_end, 0, kb, alpha, *X, xi, xj, *Y, yi, yj, C.data, ci, cj);
+                    }
+                } else {
+                    for (size_t i = diag_begin; i < diag_end; ++i) {
+                        matrix_detail::gemmRows<1>(i, i + 1, jj, i + 1, 0, kb, alpha, *X, xi, xj, *Y, yi, yj, C.data, ci, cj);
                     }
+                    tile(std::max(r0, j_end), r1, jj, j_end);
                 }
             }
         }
+        if (conjugate) {
+            // x^H x is real; drop the rounding left in the imaginary parts
+            for (size_t i = r0; i < r1; ++i) C.data[ci + i][cj + i] = T(std::real(C.data[ci + i][cj + i]));
+        }
+    };
+    
+    // Like gemm, large updates split the rows of C across threads, here at
+    // boundaries that give every thread the same share of the triangle
+    if (workers == 0) {
+        workers = tuning.threads ? tuning.threads : std::thread::hardware_concurrency();
+        if (tuning.parallelMinFlops <= 0.0 || double(n) * (n + 1) * k < tuning.parallelMinFlops) workers = 1;
+    }
+    workers = static_cast<unsigned>(std::min<size_t>(workers, n / MICRO_ROWS));
+    if (workers < 2) {
+        updateRows(0, n);
+        return;
+    }
+    std::vector<size_t> bounds = {0};
+    const double share = n * (n + 1) / 2.0 / workers;
+    double area = 0.0;
+    for (size_t i = 0; i < n && bounds.size() < workers; ++i) {
+        area += upper ? double(n - i) : double(i + 1);
+        if (area >= share * bounds.size()) bounds.push_back(i + 1);
+    }
+    bounds.push_back(n);
+    std::vector<std::thread> threads;
+    threads.reserve(bounds.size() - 2);
+    for (size_t w = 1; w + 1 < bounds.size(); ++w) {
+        const size_t begin = bounds[w], end = bounds[w + 1];
+        threads.emplace_back([&updateRows, begin, end, n]() {
+            LINALG_PROFILE("Matrix::rankK.worker", end - begin, n);
+            updateRows(begin, end);
+        });
+    }
+    updateRows(bounds[0], bounds[1]);
+    for (std::thread& thread : threads) thread.join();
+}
+
+// Triangular matrix multiply in place, recursively split so that the
+// off-diagonal work goes through gemm. Only the referenced triangle of Tri
+// is read (and its diagonal only for DiagonalType::NonUnit), so Tri may share
+// storage with another packed factor.
+template<typename T>
+void Matrix<T>::trmm(MatrixSide side, TriangleType uplo, DiagonalType diag, size_t m, size_t n,
+                     const Matrix<T>& Tri, size_t ti, size_t tj, Matrix<T>& X, size_t xi, size_t xj) {
+    LINALG_PROFILE("Matrix::trmm", m, n, double(m) * n * (side == MatrixSide::Left ? m : n));
+    const size_t BLOCK_SIZE = Tuning::parameters<T>().recursionCutoff;
+    const bool left = (side == MatrixSide::Left);
+    const bool upper = (uplo == TriangleType::Upper);
+    const bool unit = (diag == DiagonalType::Unit);
+    const size_t t = left ? m : n;
+    if (m == 0 || n == 0) return;
+    
+    if (t > BLOCK_SIZE) {
+        const size_t t1 = t / 2;
+        const size_t t2 = t - t1;
+        if (left && upper) {
+            trmm(side, uplo, diag, t1, n, Tri, ti, tj, X, xi, xj);
+            gemm(t1, n, t2, T(1), Tri, ti, tj + t1, X, xi + t1, xj, X, xi, xj);
+            trmm(side, uplo, diag, t2, n, Tri, ti + t1, tj + t1, X, xi + t1, xj);
+        } else if (left) {
+            trmm(side, uplo, diag, t2, n, Tri, ti + t1, tj + t1, X, xi + t1, xj);
+            gemm(t2, n, t1, T(1), Tri, ti + t1, tj, X, xi, xj, X, xi + t1, xj);
+            trmm(side, uplo, diag, t1, n, Tri, ti, tj, X, xi, xj);
+        } else if (upper) {
+            trmm(side, uplo, diag, m, t2, Tri, ti + t1, tj + t1, X, xi, xj + t1);
+            gemm(m, t2, t1, T(1), X, xi, xj, Tri, ti, tj + t1, X, xi, xj + t1);
+            trmm(side, uplo, diag, m, t1, Tri, ti, tj, X, xi, xj);
+        } else {
+            trmm(side, uplo, diag, m, t1, Tri, ti, tj, X, xi, xj);
+            gemm(m, t1, t2, T(1), X, xi, xj + t1, Tri, ti + t1, tj, X, xi, xj);
+            trmm(side, uplo, diag, m, t2, Tri, ti + t1, tj + t1, X, xi, xj + t1);
+        }
+        return;
+    }
+    
+    if (left) {
+        // Row i of the result combines rows of X that are still unmodified
+        for (size_t step = 0; step < m; ++step) {
+            const size_t i = upper ? step : m - 1 - step;
+            T* x_i = X.data[xi + i].data() + xj;
+            const T* t_row = Tri.data[ti + i].data() + tj;
+            if (!unit) {
+                const T d = t_row[i];
+                for (size_t j = 0; j < n; ++j) x_i[j] *= d;
+            }
+            const size_t k_begin = upper ? i + 1 : 0;
+            const size_t k_end = upper ? m : i;
+            for (size_t k = k_begin; k < k_end; ++k) {
+                const T a = t_row[k];
+                if (std::is_integral<T>::value && a == T(0)) continue;  // As in gemmRows
+                const T* x_k = X.data[xi + k].data() + xj;
+                for (size_t j = 0; j < n; ++j) x_i[j] += a * x_k[j];
+            }
+        }
     } else {
-        // Standard multiplication for smaller matrices
-        for (size_t i = 0; i < rows; ++i) {
-            for (size_t j = 0; j < other.cols; ++j) {
-                T sum = T(0);
-                for (size_t k = 0; k < cols; ++k) {
-                    sum += data[i][k] * other.data[k][j];
-                }
-                result.data[i][j] = sum;
+        // Each row of X is multiplied by Tri through a scratch row
+        std::vector<T> tmp(n);
+        for (size_t r = 0; r < m; ++r) {
+            T* x = X.data[xi + r].data() + xj;
+            std::fill(tmp.begin(), tmp.end(), T(0));
+            for (size_t k = 0; k < n; ++k) {
+                const T a = x[k];
+                if (std::is_integral<T>::value && a == T(0)) continue;
+                const T* t_row = Tri.data[ti + k].data() + tj;
+                tmp[k] += unit ? a : a * t_row[k];
+                const size_t j_begin = upper ? k + 1 : 0;
+                const size_t j_end = upper ? n : k;
+                for (size_t j = j_begin; j < j_end; ++j) tmp[j] += a * t_row[j];
             }
+            std::copy(tmp.begin(), tmp.end(), x);
         }
     }
+}
+
+// Recursive triangular inverse:
+//   inv([A11 A12; 0 A22]) = [inv(A11), -inv(A11) * A12 * inv(A22); 0, inv(A22)]
+// and the analogous form for lower triangles.
+template<typename T>
+void Matrix<T>::trtri(TriangleType uplo, DiagonalType diag, size_t n, Matrix<T>& A, size_t offset) {
+    LINALG_PROFILE("Matrix::trtri", n, n, double(n) * n * n / 3.0);
+    const size_t BLOCK_SIZE = Tuning::parameters<T>().recursionCutoff;
+    const bool upper = (uplo == TriangleType::Upper);
+    const bool unit = (diag == DiagonalType::Unit);
+    const size_t o = offset;
     
-    return result;
+    if (n > BLOCK_SIZE) {
+        const size_t n1 = n / 2;
+        const size_t n2 = n - n1;
+        trtri(uplo, diag, n1, A, o);
+        trtri(uplo, diag, n2, A, o + n1);
+        
+        const size_t xi = upper ? o : o + n1;
+        const size_t xj = upper ? o + n1 : o;
+        const size_t m = upper ? n1 : n2;
+        const size_t w = upper ? n2 : n1;
+        trmm(MatrixSide::Left, uplo, diag, m, w, A, upper ? o : o + n1, upper ? o : o + n1, A, xi, xj);
+        trmm(MatrixSide::Right, uplo, diag, m, w, A, upper ? o + n1 : o, upper ? o + n1 : o, A, xi, xj);
+        for (size_t i = 0; i < m; ++i) {
+            T* x = A.data[xi + i].data() + xj;
+            for (size_t j = 0; j < w; ++j) x[j] = -x[j];
+        }
+        return;
+    }
+    
+    // Column-by-column inversion of a small triangle
+    for (size_t step = 0; step < n; ++step) {
+        const size_t j = upper ? step : n - 1 - step;
+        T d = T(1);
+        if (!unit) {
+            T& ajj = A.data[o + j][o + j];
+            if (ajj == T(0)) {
+                throw std::runtime_error("Matrix is singular and cannot be inverted");
+            }
+            ajj = T(1) / ajj;
+            d = ajj;
+        }
+        
+        // Column j outside the diagonal <- -d * inv(triangle already done) * column j
+        if (upper) {
+            for (size_t i = 0; i < j; ++i) {
+                const T* a_i = A.data[o + i].data() + o;
+                T sum = unit ? A.data[o + i][o + j] : a_i[i] * A.data[o + i][o + j];
+                for (size_t k = i + 1; k < j; ++k) sum += a_i[k] * A.data[o + k][o + j];
+                A.data[o + i][o + j] = -d * sum;
+            }
+        } else {
+            for (size_t i = n; i-- > j + 1;) {
+                const T* a_i = A.data[o + i].data() + o;
+                T sum = unit ? A.data[o + i][o + j] : a_i[i] * A.data[o + i][o + j];
+                for (size_t k = j + 1; k < i; ++k) sum += a_i[k] * A.data[o + k][o + j];
+                A.data[o + i][o + j] = -d * sum;
+            }
+        }
+    }
 }
 
 // Scalar multiplication
 template<typename T>
-Matrix<T> Matrix<T>::operator*(const T& scalar) const {
-    Matrix<T> result(rows, cols);
-    for (size_t i = 0; i < rows; ++i) {
-        for (size_t j = 0; j < cols; ++j) {
-            result.data[i][j] = data[i][j] * scalar;
+Matrix<T> Matrix<T>::operator*(const T& scalar) const & {
+    LINALG_PROFILE("Matrix::scale", rows, cols, double(rows) * cols, 2.0 * rows * cols * sizeof(T));
+    Matrix<T> result = unsizedRows(rows, cols);
+    parallelFor(rows, cols, Tuning::parameters<T>(), [&](size_t i0, size_t i1) {
+        for (size_t i = i0; i < i1; ++i) {
+            const T* a = data[i].data();
+            std::vector<T>& out = result.data[i];
+            out.resize(cols);
+            for (size_t j = 0; j < cols; ++j) out[j] = a[j] * scalar;
         }
-    }
+    });
     return result;
 }
 
+// Scalar multiplication of an expiring matrix, in place
+template<typename T>
+Matrix<T> Matrix<T>::operator*(const T& scalar) && {
+    *this *= scalar;
+    return std::move(*this);
+}
+
 // Addition assignment
 template<typename T>
 Matrix<T>& Matrix<T>::operator+=(const Matrix<T>& other) {
+    LINALG_PROFILE("Matrix::addAssign", rows, cols, double(rows) * cols, 3.0 * rows * cols * sizeof(T));
     if (rows != other.rows || cols != other.cols) {
         throw std::invalid_argument("Matrix dimensions must match for addition");
     }
     
-    for (size_t i = 0; i < rows; ++i) {
-        for (size_t j = 0; j < cols; ++j) {
-            data[i][j] += other.data[i][j];
+    parallelFor(rows, cols, Tuning::parameters<T>(), [&](size_t i0, size_t i1) {
+        for (size_t i = i0; i < i1; ++i) {
+            T* a = data[i].data();
+            const T* b = other.data[i].data();
+            for (size_t j = 0; j < cols; ++j) a[j] += b[j];
         }
-    }
+    });
     return *this;
 }
 
 // Subtraction assignment
 template<typename T>
 Matrix<T>& Matrix<T>::operator-=(const Matrix<T>& other) {
+    LINALG_PROFILE("Matrix::subtractAssign", rows, cols, double(rows) * cols, 3.0 * rows * cols * sizeof(T));
     if (rows != other.rows || cols != other.cols) {
         throw std::invalid_argument("Matrix dimensions must match for subtraction");
     }
     
-    for (size_t i = 0; i < rows; ++i) {
-        for (size_t j = 0; j < cols; ++j) {
-            data[i][j] -= other.data[i][j];
+    parallelFor(rows, cols, Tuning::parameters<T>(), [&](size_t i0, size_t i1) {
+        for (size_t i = i0; i < i1; ++i) {
+            T* a = data[i].data();
+            const T* b = other.data[i].data();
+            for (size_t j = 0; j < cols; ++j) a[j] -= b[j];
         }
-    }
+    });
     return *this;
 }
 
 // Scalar multiplication assignment
 template<typename T>
 Matrix<T>& Matrix<T>::operator*=(const T& scalar) {
-    for (size_t i = 0; i < rows; ++i) {
-        for (size_t j = 0; j < cols; ++j) {
-            data[i][j] *= scalar;
+    LINALG_PROFILE("Matrix::scaleAssign", rows, cols, double(rows) * cols, 2.0 * rows * cols * sizeof(T));
+    parallelFor(rows, cols, Tuning::parameters<T>(), [&](size_t i0, size_t i1) {
+        for (size_t i = i0; i < i1; ++i) {
+            T* a = data[i].data();
+            for (size_t j = 0; j < cols; ++j) a[j] *= scalar;
         }
-    }
+    });
     return *this;
 }
 
 // Equality comparison
 template<typename T>
 bool Matrix<T>::operator==(const Matrix<T>& other) const {
+    LINALG_PROFILE("Matrix::equals", rows, cols, 0.0, 2.0 * rows * cols * sizeof(T));
     if (rows != other.rows || cols != other.cols) return false;
     
     const T EPSILON = std::numeric_limits<T>::epsilon() * 10;
-    for (size_t i = 0; i < rows; ++i) {
-        for (size_t j = 0; j < cols; ++j) {
-            if (std::abs(data[i][j] - other.data[i][j]) > EPSILON) return false;
+    return parallelReduce<bool>(rows, cols, Tuning::parameters<T>(), [&](size_t i0, size_t i1) {
+        for (size_t i = i0; i < i1; ++i) {
+            for (size_t j = 0; j < cols; ++j) {
+                if (std::abs(data[i][j] - other.data[i][j]) > EPSILON) return false;
+            }
         }
-    }
-    return true;
+        return true;
+    }, [](bool a, bool b) { return a && b; });
 }
 
 // Transpose
 template<typename T>
-Matrix<T> Matrix<T>::transpose() const {
+Matrix<T> Matrix<T>::transpose() const & {
+    LINALG_PROFILE("Matrix::transpose", rows, cols, 0.0, 2.0 * rows * cols * sizeof(T));
     Matrix<T> result(cols, rows);
     for (size_t i = 0; i < rows; ++i) {
         for (size_t j = 0; j < cols; ++j) {
@@ -163,13 +687,34 @@ Matrix<T> Matrix<T>::transpose() const {
     return result;
 }
 
+// Transpose of an expiring matrix. Square storage is transposed in place;
+// other shapes need rows of a different length and are copied.
+template<typename T>
+Matrix<T> Matrix<T>::transpose() && {
+    if (rows != cols) return static_cast<const Matrix<T>&>(*this).transpose();
+    LINALG_PROFILE("Matrix::transposeInPlace", rows, cols, 0.0, 2.0 * rows * cols * sizeof(T));
+    for (size_t i = 0; i < rows; ++i) {
+        for (size_t j = i + 1; j < cols; ++j) {
+            std::swap(data[i][j], data[j][i]);
+        }
+    }
+    return std::move(*this);
+}
+
 // Optimized determinant calculation using LU decomposition for large matrices
 template<typename T>
 T Matrix<T>::determinant() const {
+    LINALG_PROFILE("Matrix::determinant", rows, cols, 2.0 / 3.0 * rows * rows * rows, double(rows) * cols * sizeof(T));
     if (rows != cols) {
         throw std::invalid_argument("Determinant can only be calculated for square matrices");
     }
     
+    // Integer matrices take the exact path, which throws
+    // std::overflow_error when the determinant does not fit T
+    if constexpr (std::is_integral<T>::value) {
+        return exactDeterminant(*this).template to<T>();
+    }
+    
     if (rows == 1) return data[0][0];
     if (rows == 2) return data[0][0] * data[1][1] - data[0][1] * data[1][0];
     if (rows == 3) {
@@ -185,20 +730,34 @@ T Matrix<T>::determinant() const {
 // LU decomposition based determinant (more efficient for large matrices)
 template<typename T>
 T Matrix<T>::determinantLU() const {
-    Matrix<T> L, U;
-    std::tie(L, U) = luDecomposition();
+    return LUFactorization<T>(*this).determinant();
+}
+
+// Sign and log of |det| without forming the product of the pivots, so
+// large matrices do not overflow to inf or underflow to 0. Symmetric input
+// tries Cholesky first (half the flops of LU); otherwise a pivoted LU is
+// computed in a single working copy. A singular matrix gives (0, -inf).
+template<typename T>
+std::pair<T, T> Matrix<T>::logAbsDeterminant() const {
+    LINALG_PROFILE("Matrix::logAbsDeterminant", rows, cols, 2.0 / 3.0 * rows * rows * rows, double(rows) * cols * sizeof(T));
+    if (rows != cols) {
+        throw std::invalid_argument("Determinant can only be calculated for square matrices");
+    }
     
-    T det = T(1);
-    for (size_t i = 0; i < rows; ++i) {
-        det *= U.data[i][i];
+    if (isSymmetric()) {
+        CholeskyFactorization<T> chol(*this);
+        if (chol.isPositiveDefinite()) {
+            return std::make_pair(T(1), chol.logDeterminant());
+        }
     }
     
-    return det;
+    return LUFactorization<T>(*this).logAbsDeterminant();
 }
 
 // LU Decomposition
 template<typename T>
 std::pair<Matrix<T>, Matrix<T>> Matrix<T>::luDecomposition() const {
+    LINALG_PROFILE("Matrix::luDecomposition", rows, cols, 2.0 / 3.0 * rows * rows * rows, 3.0 * rows * cols * sizeof(T));
     if (rows != cols) {
         throw std::invalid_argument("LU decomposition requires a square matrix");
     }
@@ -227,6 +786,7 @@ std::pair<Matrix<T>, Matrix<T>> Matrix<T>::luDecomposition() const {
 // QR Decomposition using Gram-Schmidt process
 template<typename T>
 std::pair<Matrix<T>, Matrix<T>> Matrix<T>::qrDecomposition() const {
+    LINALG_PROFILE("Matrix::qrDecomposition", rows, cols, 4.0 / 3.0 * rows * rows * rows, 3.0 * rows * cols * sizeof(T));
     Matrix<T> Q(rows, cols);
     Matrix<T> R(cols, cols);
     
@@ -268,75 +828,161 @@ std::pair<Matrix<T>, Matrix<T>> Matrix<T>::qrDecomposition() const {
     return std::make_pair(Q, R);
 }
 
-// Matrix inverse using Gauss-Jordan elimination
+// Solve A * X = B using a partial-pivoted LU factorization
 template<typename T>
-Matrix<T> Matrix<T>::inverse() const {
+Matrix<T> Matrix<T>::solve(const Matrix<T>& B) const {
+    LINALG_PROFILE("Matrix::solve", rows, B.cols, 2.0 / 3.0 * rows * rows * rows + 2.0 * rows * rows * B.cols);
     if (rows != cols) {
-        throw std::invalid_argument("Only square matrices can be inverted");
+        throw std::invalid_argument("Solve requires a square coefficient matrix");
     }
-    
-    T det = determinant();
-    if (std::abs(det) < std::numeric_limits<T>::epsilon()) {
-        throw std::runtime_error("Matrix is singular and cannot be inverted");
+    if (B.rows != rows) {
+        throw std::invalid_argument("Right-hand side rows must match matrix size");
     }
     
-    // Create augmented matrix [A|I]
-    Matrix<T> augmented(rows, 2 * cols);
-    for (size_t i = 0; i < rows; ++i) {
-        for (size_t j = 0; j < cols; ++j) {
-            augmented.data[i][j] = data[i][j];
-            augmented.data[i][j + cols] = (i == j) ? T(1) : T(0);
+    if constexpr (std::is_integral<T>::value) {
+        const auto exact = exactSolve(*this, B);
+        Matrix<T> X(rows, B.cols);
+        for (size_t i = 0; i < rows; ++i) {
+            for (size_t j = 0; j < B.cols; ++j) {
+                if (!exact(i, j).isInteger()) {
+                    throw std::domain_error("Solution is not integral - use exactSolve for rational results");
+                }
+                X.data[i][j] = exact(i, j).numerator().template to<T>();
+            }
         }
+        return X;
     }
     
-    // Gauss-Jordan elimination
-    for (size_t i = 0; i < rows; ++i) {
-        // Find pivot
-        size_t pivot_row = i;
-        for (size_t k = i + 1; k < rows; ++k) {
-            if (std::abs(augmented.data[k][i]) > std::abs(augmented.data[pivot_row][i])) {
-                pivot_row = k;
+    return LUFactorization<T>(*this).solve(B);
+}
+
+// Matrix functions
+template<typename T>
+Matrix<T> Matrix<T>::expm() const {
+    LINALG_PROFILE("Matrix::expm", rows, cols);
+    return MatrixFunctionWorkspace<T>().expm(*this);
+}
+
+template<typename T>
+Matrix<T> Matrix<T>::logm() const {
+    LINALG_PROFILE("Matrix::logm", rows, cols);
+    return MatrixFunctionWorkspace<T>().logm(*this);
+}
+
+template<typename T>
+Matrix<T> Matrix<T>::sqrtm() const {
+    LINALG_PROFILE("Matrix::sqrtm", rows, cols);
+    return MatrixFunctionWorkspace<T>().sqrtm(*this);
+}
+
+template<typename T>
+Matrix<T> Matrix<T>::pow(int exponent) const {
+    LINALG_PROFILE("Matrix::pow", rows, cols);
+    return MatrixFunctionWorkspace<T>().pow(*this, exponent);
+}
+
+// Maximum absolute column sum
+template<typename T>
+T Matrix<T>::norm1() const {
+    LINALG_PROFILE("Matrix::norm1", rows, cols, double(rows) * cols, double(rows) * cols * sizeof(T));
+    const std::vector<T> colSums = parallelReduce<std::vector<T>>(rows, cols, Tuning::parameters<T>(),
+        [&](size_t i0, size_t i1) {
+            std::vector<T> sums(cols, T(0));
+            for (size_t i = i0; i < i1; ++i) {
+                for (size_t j = 0; j < cols; ++j) sums[j] += std::abs(data[i][j]);
             }
-        }
-        
-        // Swap rows if needed
-        if (pivot_row != i) {
-            for (size_t j = 0; j < 2 * cols; ++j) {
-                std::swap(augmented.data[i][j], augmented.data[pivot_row][j]);
+            return sums;
+        },
+        [](std::vector<T> a, const std::vector<T>& b) {
+            for (size_t j = 0; j < a.size(); ++j) a[j] += b[j];
+            return a;
+        });
+    return colSums.empty() ? T(0) : *std::max_element(colSums.begin(), colSums.end());
+}
+
+// Maximum absolute row sum
+template<typename T>
+T Matrix<T>::normInf() const {
+    LINALG_PROFILE("Matrix::normInf", rows, cols, double(rows) * cols, double(rows) * cols * sizeof(T));
+    return parallelReduce<T>(rows, cols, Tuning::parameters<T>(), [&](size_t i0, size_t i1) {
+        T result = T(0);
+        for (size_t i = i0; i < i1; ++i) {
+            T rowSum = T(0);
+            for (size_t j = 0; j < cols; ++j) {
+                rowSum += std::abs(data[i][j]);
             }
+            result = std::max(result, rowSum);
         }
-        
-        // Scale pivot row
-        T pivot = augmented.data[i][i];
-        for (size_t j = 0; j < 2 * cols; ++j) {
-            augmented.data[i][j] /= pivot;
-        }
-        
-        // Eliminate column
-        for (size_t k = 0; k < rows; ++k) {
-            if (k != i) {
-                T factor = augmented.data[k][i];
-                for (size_t j = 0; j < 2 * cols; ++j) {
-                    augmented.data[k][j] -= factor * augmented.data[i][j];
-                }
+        return result;
+    }, [](T a, T b) { return std::max(a, b); });
+}
+
+template<typename T>
+T Matrix<T>::normFrobenius() const {
+    LINALG_PROFILE("Matrix::normFrobenius", rows, cols, 2.0 * rows * cols, double(rows) * cols * sizeof(T));
+    const T sum = parallelReduce<T>(rows, cols, Tuning::parameters<T>(), [&](size_t i0, size_t i1) {
+        T partial = T(0);
+        for (size_t i = i0; i < i1; ++i) {
+            for (size_t j = 0; j < cols; ++j) {
+                partial += data[i][j] * data[i][j];
             }
         }
+        return partial;
+    }, [](T a, T b) { return a + b; });
+    return static_cast<T>(std::sqrt(sum));
+}
+
+// Element type conversion
+template<typename T>
+template<typename U>
+Matrix<U> Matrix<T>::cast() const {
+    LINALG_PROFILE("Matrix::cast", rows, cols, 0.0, double(rows) * cols * (sizeof(T) + sizeof(U)));
+    Matrix<U> result = Matrix<U>::unsizedRows(rows, cols);
+    parallelFor(rows, cols, Tuning::parameters<T>(), [&](size_t i0, size_t i1) {
+        for (size_t i = i0; i < i1; ++i) {
+            const T* a = data[i].data();
+            std::vector<U>& out = result.data[i];
+            out.resize(cols);
+            for (size_t j = 0; j < cols; ++j) out[j] = static_cast<U>(a[j]);
+        }
+    });
+    return result;
+}
+
+// Matrix inverse from a single pivoted LU factorization (see LUFactorization::inverse)
+template<typename T>
+Matrix<T> Matrix<T>::inverse() const {
+    LINALG_PROFILE("Matrix::inverse", rows, cols, 2.0 * rows * rows * rows, 2.0 * rows * cols * sizeof(T));
+    if (rows != cols) {
+        throw std::invalid_argument("Only square matrices can be inverted");
     }
     
-    // Extract inverse matrix
-    Matrix<T> result(rows, cols);
-    for (size_t i = 0; i < rows; ++i) {
-        for (size_t j = 0; j < cols; ++j) {
-            result.data[i][j] = augmented.data[i][j + cols];
-        }
+    LUFactorization<T> lu(*this);
+    if (lu.isSingular()) {
+        throw std::runtime_error("Matrix is singular and cannot be inverted");
+    }
+    return lu.inverse();
+}
+
+// Inverse of a symmetric positive definite matrix via Cholesky
+template<typename T>
+Matrix<T> Matrix<T>::inverseSPD() const {
+    LINALG_PROFILE("Matrix::inverseSPD", rows, cols, double(rows) * rows * rows, 2.0 * rows * cols * sizeof(T));
+    if (rows != cols) {
+        throw std::invalid_argument("Only square matrices can be inverted");
     }
     
-    return result;
+    CholeskyFactorization<T> chol(*this);
+    if (!chol.isPositiveDefinite()) {
+        throw std::runtime_error("Matrix is not positive definite - Cholesky inverse failed");
+    }
+    return chol.inverse();
 }
 
 // Trace (sum of diagonal elements)
 template<typename T>
 T Matrix<T>::trace() const {
+    LINALG_PROFILE("Matrix::trace", rows, cols);
     if (rows != cols) {
         throw std::invalid_argument("Trace can only be calculated for square matrices");
     }
@@ -348,9 +994,132 @@ T Matrix<T>::trace() const {
     return tr;
 }
 
+// Gram matrix A^H * A: herk fills the upper triangle, which is mirrored
+template<typename T>
+Matrix<T> Matrix<T>::gram() const {
+    LINALG_PROFILE("Matrix::gram", cols, cols, double(cols) * (cols + 1) * rows);
+    Matrix<T> result(cols, cols);
+    herk(TriangleType::Upper, TransposeType::Transpose, cols, rows, T(1), *this, 0, 0, result, 0, 0);
+    for (size_t i = 0; i < cols; ++i) {
+        for (size_t j = 0; j < i; ++j) {
+            result.data[i][j] = matrix_detail::conjugate(result.data[j][i]);
+        }
+    }
+    return result;
+}
+
+template<typename T>
+Matrix<T> Matrix<T>::covariance() const {
+    LINALG_PROFILE("Matrix::covariance", cols, cols, double(cols) * (cols + 1) * rows);
+    CovarianceAccumulator<T> accumulator(cols);
+    accumulator.add(*this);
+    return accumulator.covariance();
+}
+
+// Exact (tolerance 0) or approximate symmetry check
+template<typename T>
+bool Matrix<T>::isSymmetric(const T& tolerance) const {
+    LINALG_PROFILE("Matrix::isSymmetric", rows, cols);
+    if (rows != cols) return false;
+    
+    for (size_t i = 0; i < rows; ++i) {
+        for (size_t j = 0; j < i; ++j) {
+            if (std::abs(data[i][j] - data[j][i]) > tolerance) return false;
+        }
+    }
+    return true;
+}
+
+// Symmetric eigendecomposition by cyclic Jacobi rotations (Golub & Van Loan,
+// 8.5): eigenvalues ascending, eigenvectors in the matching columns. Input
+// that is not symmetric to within n * epsilon * ||A||_F is rejected.
+template<typename T>
+std::pair<std::vector<T>, Matrix<T>> Matrix<T>::eigenDecomposition() const {
+    LINALG_PROFILE("Matrix::eigenDecomposition", rows, cols);
+    if (rows != cols) {
+        throw std::invalid_argument("Eigendecomposition can only be calculated for square matrices");
+    }
+
+    const size_t n = rows;
+    Matrix<T> A = *this;
+    Matrix<T> V = Matrix<T>::identity(n);
+    const int MAX_SWEEPS = 100;
+    const T TOLERANCE = std::numeric_limits<T>::epsilon() * std::numeric_limits<T>::epsilon();
+
+    T total = T(0);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            total += A.data[i][j] * A.data[i][j];
+        }
+    }
+    if (!isSymmetric(static_cast<T>(n) * std::numeric_limits<T>::epsilon() * std::sqrt(total))) {
+        throw std::invalid_argument("Eigendecomposition requires a symmetric matrix");
+    }
+
+    for (int sweep = 0; sweep < MAX_SWEEPS; ++sweep) {
+        T off = T(0);
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = i + 1; j < n; ++j) {
+                off += A.data[i][j] * A.data[i][j];
+            }
+        }
+        if (off <= TOLERANCE * total) break;
+
+        for (size_t p = 0; p + 1 < n; ++p) {
+            for (size_t q = p + 1; q < n; ++q) {
+                const T apq = A.data[p][q];
+                if (apq == T(0)) continue;
+
+                // J = [c s; -s c] in rows and columns p, q zeroes A(p, q) of J^T A J
+                const T theta = (A.data[q][q] - A.data[p][p]) / (T(2) * apq);
+                const T t = (theta >= T(0) ? T(1) : T(-1)) / (std::abs(theta) + std::sqrt(theta * theta + T(1)));
+                const T c = T(1) / std::sqrt(t * t + T(1));
+                const T s = t * c;
+
+                for (size_t k = 0; k < n; ++k) {
+                    std::vector<T>& ak = A.data[k];
+                    const T akp = ak[p];
+                    const T akq = ak[q];
+                    ak[p] = c * akp - s * akq;
+                    ak[q] = s * akp + c * akq;
+
+                    std::vector<T>& vk = V.data[k];
+                    const T vkp = vk[p];
+                    const T vkq = vk[q];
+                    vk[p] = c * vkp - s * vkq;
+                    vk[q] = s * vkp + c * vkq;
+                }
+                std::vector<T>& ap = A.data[p];
+                std::vector<T>& aq = A.data[q];
+                for (size_t k = 0; k < n; ++k) {
+                    const T apk = ap[k];
+                    const T aqk = aq[k];
+                    ap[k] = c * apk - s * aqk;
+                    aq[k] = s * apk + c * aqk;
+                }
+            }
+        }
+    }
+
+    std::vector<size_t> order(n);
+    for (size_t i = 0; i < n; ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return A.data[a][a] < A.data[b][b]; });
+
+    std::vector<T> values(n);
+    Matrix<T> vectors(n, n);
+    for (size_t j = 0; j < n; ++j) {
+        values[j] = A.data[order[j]][order[j]];
+        for (size_t i = 0; i < n; ++i) {
+            vectors.data[i][j] = V.data[i][order[j]];
+        }
+    }
+    return {values, vectors};
+}
+
 // Eigenvalue computation for symmetric matrices using QR algorithm
 template<typename T>
 std::vector<std::complex<T>> Matrix<T>::eigenvalues() const {
+    LINALG_PROFILE("Matrix::eigenvalues", rows, cols);
     if (rows != cols) {
         throw std::invalid_argument("Eigenvalues can only be calculated for square matrices");
     }
@@ -419,24 +1188,103 @@ std::vector<std::complex<T>> Matrix<T>::eigenvalues() const {
 // Utility functions
 template<typename T>
 void Matrix<T>::fill(const T& value) {
-    for (size_t i = 0; i < rows; ++i) {
-        for (size_t j = 0; j < cols; ++j) {
-            data[i][j] = value;
+    LINALG_PROFILE("Matrix::fill", rows, cols, 0.0, double(rows) * cols * sizeof(T));
+    parallelFor(rows, cols, Tuning::parameters<T>(), [&](size_t i0, size_t i1) {
+        for (size_t i = i0; i < i1; ++i) {
+            std::fill(data[i].begin(), data[i].end(), value);
         }
-    }
+    });
 }
 
 template<typename T>
 void Matrix<T>::fillRandom(T min, T max) {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<T> dis(min, max);
-    
-    for (size_t i = 0; i < rows; ++i) {
-        for (size_t j = 0; j < cols; ++j) {
-            data[i][j] = dis(gen);
+    fillRandom(min, max, randomSeed());
+}
+
+template<typename T>
+void Matrix<T>::fillRandom(T min, T max, uint64_t seed) {
+    LINALG_PROFILE("Matrix::fillRandom", rows, cols, 0.0, double(rows) * cols * sizeof(T));
+    generateRows([&](T* row, uint64_t first) { randomUniform(row, cols, first, min, max, seed); });
+}
+
+template<typename T>
+void Matrix<T>::fillNormal(T mean, T stddev) {
+    fillNormal(mean, stddev, randomSeed());
+}
+
+template<typename T>
+void Matrix<T>::fillNormal(T mean, T stddev, uint64_t seed) {
+    LINALG_PROFILE("Matrix::fillNormal", rows, cols, 0.0, double(rows) * cols * sizeof(T));
+    generateRows([&](T* row, uint64_t first) { ::randomNormal(row, cols, first, mean, stddev, seed); });
+}
+
+template<typename T>
+template<typename Generate>
+void Matrix<T>::generateRows(const Generate& generate) {
+    parallelFor(rows, cols, Tuning::parameters<T>(), [&](size_t i0, size_t i1) {
+        for (size_t i = i0; i < i1; ++i) {
+            data[i].resize(cols);
+            generate(data[i].data(), static_cast<uint64_t>(i) * cols);
         }
+    });
+}
+
+template<typename T>
+Matrix<T> Matrix<T>::subMatrix(size_t startRow, size_t endRow, size_t startCol, size_t endCol) const & {
+    LINALG_PROFILE("Matrix::subMatrix", endRow - startRow, endCol - startCol);
+    if (startRow > endRow || endRow > rows || startCol > endCol || endCol > cols) {
+        throw std::out_of_range("Submatrix range exceeds matrix bounds");
     }
+    
+    Matrix<T> result;
+    result.rows = endRow - startRow;
+    result.cols = endCol - startCol;
+    result.data.reserve(result.rows);
+    for (size_t i = startRow; i < endRow; ++i) {
+        result.data.emplace_back(data[i].begin() + startCol, data[i].begin() + endCol);
+    }
+    return result;
+}
+
+// Submatrix of an expiring matrix: the kept rows are moved and trimmed in
+// place, so no element storage is allocated
+template<typename T>
+Matrix<T> Matrix<T>::subMatrix(size_t startRow, size_t endRow, size_t startCol, size_t endCol) && {
+    LINALG_PROFILE("Matrix::subMatrixInPlace", endRow - startRow, endCol - startCol);
+    if (startRow > endRow || endRow > rows || startCol > endCol || endCol > cols) {
+        throw std::out_of_range("Submatrix range exceeds matrix bounds");
+    }
+    
+    data.erase(data.begin() + endRow, data.end());
+    data.erase(data.begin(), data.begin() + startRow);
+    for (auto& row : data) {
+        row.erase(row.begin() + endCol, row.end());
+        row.erase(row.begin(), row.begin() + startCol);
+    }
+    rows = endRow - startRow;
+    cols = endCol - startCol;
+    return std::move(*this);
+}
+
+// Existing entries keep their positions; new ones are fillValue
+template<typename T>
+void Matrix<T>::resize(size_t newRows, size_t newCols, const T& fillValue) {
+    LINALG_PROFILE("Matrix::resize", newRows, newCols);
+    data.resize(newRows);
+    for (auto& row : data) {
+        row.resize(newCols, fillValue);
+    }
+    rows = newRows;
+    cols = newCols;
+}
+
+template<typename T>
+Matrix<T> Matrix<T>::unsizedRows(size_t rows, size_t cols) {
+    Matrix<T> result;
+    result.rows = rows;
+    result.cols = cols;
+    result.data.resize(rows);
+    return result;
 }
 
 // Static factory methods
@@ -461,8 +1309,26 @@ Matrix<T> Matrix<T>::ones(size_t rows, size_t cols) {
 
 template<typename T>
 Matrix<T> Matrix<T>::random(size_t rows, size_t cols, T min, T max) {
-    Matrix<T> result(rows, cols);
-    result.fillRandom(min, max);
+    return random(rows, cols, min, max, randomSeed());
+}
+
+// The rows are allocated by the threads that fill them
+template<typename T>
+Matrix<T> Matrix<T>::random(size_t rows, size_t cols, T min, T max, uint64_t seed) {
+    Matrix<T> result = unsizedRows(rows, cols);
+    result.fillRandom(min, max, seed);
+    return result;
+}
+
+template<typename T>
+Matrix<T> Matrix<T>::randomNormal(size_t rows, size_t cols, T mean, T stddev) {
+    return randomNormal(rows, cols, mean, stddev, randomSeed());
+}
+
+template<typename T>
+Matrix<T> Matrix<T>::randomNormal(size_t rows, size_t cols, T mean, T stddev, uint64_t seed) {
+    Matrix<T> result = unsizedRows(rows, cols);
+    result.fillNormal(mean, stddev, seed);
     return result;
 }
 
@@ -496,6 +1362,47 @@ Matrix<T> operator*(const T& scalar, const Matrix<T>& matrix) {
     return matrix * scalar;
 }
 
+template<typename T>
+Matrix<T> operator*(const T& scalar, Matrix<T>&& matrix) {
+    return std::move(matrix) * scalar;
+}
+
+// Right operand expiring: addition commutes, so it accumulates the left one
+template<typename T>
+Matrix<T> operator+(const Matrix<T>& lhs, Matrix<T>&& rhs) {
+    rhs += lhs;
+    return std::move(rhs);
+}
+
+template<typename T>
+Matrix<T> operator+(Matrix<T>&& lhs, Matrix<T>&& rhs) {
+    return std::move(lhs) + rhs;
+}
+
+// rhs <- lhs - rhs, element by element
+template<typename T>
+Matrix<T> operator-(const Matrix<T>& lhs, Matrix<T>&& rhs) {
+    LINALG_PROFILE("Matrix::subtractInto", lhs.rows, lhs.cols, double(lhs.rows) * lhs.cols,
+                   3.0 * lhs.rows * lhs.cols * sizeof(T));
+    if (lhs.rows != rhs.rows || lhs.cols != rhs.cols) {
+        throw std::invalid_argument("Matrix dimensions must match for subtraction");
+    }
+    
+    parallelFor(lhs.rows, lhs.cols, Tuning::parameters<T>(), [&](size_t i0, size_t i1) {
+        for (size_t i = i0; i < i1; ++i) {
+            const T* a = lhs.data[i].data();
+            T* b = rhs.data[i].data();
+            for (size_t j = 0; j < lhs.cols; ++j) b[j] = a[j] - b[j];
+        }
+    });
+    return std::move(rhs);
+}
+
+template<typename T>
+Matrix<T> operator-(Matrix<T>&& lhs, Matrix<T>&& rhs) {
+    return std::move(lhs) - rhs;
+}
+
 template<typename T>
 std::ostream& operator<<(std::ostream& os, const Matrix<T>& matrix) {
     matrix.print(os);
@@ -7,6 +7,25 @@
 #include <algorithm>
 #include <complex>
 #include <memory>
+#include <thread>
+#include "Profiler.h"
+#include "Tuning.h"
+#include "ParallelFor.h"
+#include "Random.h"
+
+// Triangular block kernel options
+enum class MatrixSide { Left, Right };
+enum class TriangleType { Upper, Lower };
+enum class DiagonalType { NonUnit, Unit };
+enum class TransposeType { NoTranspose, Transpose };
+
+// Factorization types (defined in Solvers.h)
+template<typename T> class LUFactorization;
+template<typename T> class CholeskyFactorization;
+template<typename T> class MatrixFunctionWorkspace;
+template<typename T> class CovarianceAccumulator;
+template<typename T> class PointSet;
+template<typename T> struct TileKernels;
 
 template<typename T = double>
 class Matrix {
@@ -59,11 +78,15 @@ public:
         return data[i];
     }
 
-    // Basic operations
-    Matrix operator+(const Matrix& other) const;
-    Matrix operator-(const Matrix& other) const;
+    // Basic operations. The && overloads compute in the storage of an expiring
+    // left operand, so (A + B) * 2.0 - C allocates a single result.
+    Matrix operator+(const Matrix& other) const &;
+    Matrix operator+(const Matrix& other) &&;
+    Matrix operator-(const Matrix& other) const &;
+    Matrix operator-(const Matrix& other) &&;
     Matrix operator*(const Matrix& other) const;
-    Matrix operator*(const T& scalar) const;
+    Matrix operator*(const T& scalar) const &;
+    Matrix operator*(const T& scalar) &&;
     Matrix& operator+=(const Matrix& other);
     Matrix& operator-=(const Matrix& other);
     Matrix& operator*=(const T& scalar);
@@ -73,42 +96,114 @@ public:
     bool operator!=(const Matrix& other) const { return !(*this == other); }
 
     // Matrix operations
-    Matrix transpose() const;
-    T determinant() const;
+    Matrix transpose() const &;
+    Matrix transpose() &&;  // In place when square
+    T determinant() const;  // Exact for integer T (ExactArithmetic.h)
+    std::pair<T, T> logAbsDeterminant() const;  // (sign, log|det|), safe from overflow
     Matrix inverse() const;
+    Matrix inverseSPD() const;  // Inverse of a symmetric positive definite matrix via Cholesky
     T trace() const;
+    Matrix gram() const;        // A^H * A through herk (symmetric / Hermitian, both triangles)
+    Matrix covariance() const;  // Sample covariance of the rows as observations (see Covariance.h)
+    bool isSymmetric(const T& tolerance = T(0)) const;
     Matrix adjugate() const;
     
-    // Eigenvalue decomposition (for symmetric matrices)
+    // Eigenvalue decomposition of a symmetric matrix; throws std::invalid_argument otherwise
     std::pair<std::vector<T>, Matrix> eigenDecomposition() const;
     std::vector<std::complex<T>> eigenvalues() const;
     
+    // Matrix functions (see MatrixFunctions.h for reusable workspaces)
+    Matrix expm() const;
+    Matrix logm() const;
+    Matrix sqrtm() const;
+    Matrix pow(int exponent) const;
+    
     // LU Decomposition
     std::pair<Matrix, Matrix> luDecomposition() const;
     
     // QR Decomposition
     std::pair<Matrix, Matrix> qrDecomposition() const;
     
+    // Linear system solve (A * X = B) via partial-pivoted LU; exact for
+    // integer T, which throws std::domain_error when X is not integral
+    // (exactSolve gives the fractions)
+    Matrix solve(const Matrix& B) const;
+    
+    // Norms
+    T norm1() const;
+    T normInf() const;
+    T normFrobenius() const;
+    
+    // Element type conversion (e.g. MatrixD -> MatrixF)
+    template<typename U>
+    Matrix<U> cast() const;
+    
     // Utility functions
     void fill(const T& value);
+    // Uniform on [min, max) ([min, max] for integer types) and normal. With
+    // a seed the contents are reproducible and independent of the thread
+    // count (Random.h); without one a fresh seed is drawn.
     void fillRandom(T min = T(0), T max = T(1));
-    Matrix subMatrix(size_t startRow, size_t endRow, size_t startCol, size_t endCol) const;
+    void fillRandom(T min, T max, uint64_t seed);
+    void fillNormal(T mean = T(0), T stddev = T(1));
+    void fillNormal(T mean, T stddev, uint64_t seed);
+    // Rows [startRow, endRow) and columns [startCol, endCol); a temporary
+    // keeps its own rows and trims them instead of copying
+    Matrix subMatrix(size_t startRow, size_t endRow, size_t startCol, size_t endCol) const &;
+    Matrix subMatrix(size_t startRow, size_t endRow, size_t startCol, size_t endCol) &&;
     void resize(size_t newRows, size_t newCols, const T& fillValue = T(0));
     
+    // Block kernels operating in place on sub-blocks (see Matrix.cpp)
+    static void gemm(size_t m, size_t n, size_t k, const T& alpha,
+                     const Matrix& A, size_t ai, size_t aj,
+                     const Matrix& B, size_t bi, size_t bj,
+                     Matrix& C, size_t ci, size_t cj);
+    // X (m x n at xi, xj) <- Tri * X (Left, Tri is m x m) or X * Tri (Right, Tri is n x n)
+    static void trmm(MatrixSide side, TriangleType uplo, DiagonalType diag, size_t m, size_t n,
+                     const Matrix& Tri, size_t ti, size_t tj, Matrix& X, size_t xi, size_t xj);
+    // Inverse of the n x n triangle at (offset, offset), in place
+    static void trtri(TriangleType uplo, DiagonalType diag, size_t n, Matrix& A, size_t offset);
+    // Rank-k updates of the `uplo` triangle of C (n x n at ci, cj); the other
+    // triangle is not touched. NoTranspose: C += alpha * A * A^T with A n x k,
+    // Transpose: C += alpha * A^T * A with A k x n. herk uses A^H instead of
+    // A^T and leaves a real diagonal.
+    static void syrk(TriangleType uplo, TransposeType trans, size_t n, size_t k, const T& alpha,
+                     const Matrix& A, size_t ai, size_t aj, Matrix& C, size_t ci, size_t cj);
+    static void herk(TriangleType uplo, TransposeType trans, size_t n, size_t k, const T& alpha,
+                     const Matrix& A, size_t ai, size_t aj, Matrix& C, size_t ci, size_t cj);
+    
     // Static factory methods
     static Matrix identity(size_t n);
     static Matrix zeros(size_t rows, size_t cols);
     static Matrix ones(size_t rows, size_t cols);
     static Matrix random(size_t rows, size_t cols, T min = T(0), T max = T(1));
+    static Matrix random(size_t rows, size_t cols, T min, T max, uint64_t seed);
+    static Matrix randomNormal(size_t rows, size_t cols, T mean = T(0), T stddev = T(1));
+    static Matrix randomNormal(size_t rows, size_t cols, T mean, T stddev, uint64_t seed);
     
     // I/O operations
     void print(std::ostream& os = std::cout, int precision = 6) const;
     void readFromInput(std::istream& is = std::cin);
     
     // Friends
+    template<typename U>
+    friend class Matrix;
+    
+    template<typename U>
+    friend class CovarianceAccumulator;
+    
+    template<typename U>
+    friend class PointSet;
+    
+    template<typename U>
+    friend struct TileKernels;
+    
     template<typename U>
     friend Matrix<U> operator*(const U& scalar, const Matrix<U>& matrix);
     
+    template<typename U>
+    friend Matrix<U> operator-(const Matrix<U>& lhs, Matrix<U>&& rhs);
+    
     template<typename U>
     friend std::ostream& operator<<(std::ostream& os, const Matrix<U>& matrix);
 
@@ -124,11 +219,53 @@ private:
     // Eigenvalue computation helpers
     void householderReduction(Matrix& Q, Matrix& H) const;
     std::vector<T> qrAlgorithm(Matrix tridiagonal) const;
+    
+    // C += A * B by Strassen recursion down to `cutoff`, then gemm (used by
+    // operator* above KernelTuning::strassenCutoff)
+    static void strassen(size_t m, size_t n, size_t k,
+                         const Matrix& A, size_t ai, size_t aj,
+                         const Matrix& B, size_t bi, size_t bj,
+                         Matrix& C, size_t ci, size_t cj, size_t cutoff);
+    
+    // gemm on `workers` threads (0 = from the tuning), for callers that
+    // already run on several threads
+    static void gemmThreads(size_t m, size_t n, size_t k, const T& alpha,
+                            const Matrix& A, size_t ai, size_t aj,
+                            const Matrix& B, size_t bi, size_t bj,
+                            Matrix& C, size_t ci, size_t cj, unsigned workers);
+    // syrk / herk on `workers` threads (0 = from the tuning)
+    static void rankK(TriangleType uplo, TransposeType trans, bool conjugate, size_t n, size_t k, const T& alpha,
+                      const Matrix& A, size_t ai, size_t aj, Matrix& C, size_t ci, size_t cj, unsigned workers);
+    
+    // rows x cols with empty row vectors, for element-wise results whose
+    // rows are sized by the parallelFor threads that write them
+    static Matrix unsizedRows(size_t rows, size_t cols);
+    // Sizes every row and fills it with generate(row, index of its first
+    // element in row-major order), on parallelFor threads
+    template<typename Generate>
+    void generateRows(const Generate& generate);
 };
 
+// Overloads for an expiring right operand, which then holds the result
+template<typename T>
+Matrix<T> operator+(const Matrix<T>& lhs, Matrix<T>&& rhs);
+template<typename T>
+Matrix<T> operator+(Matrix<T>&& lhs, Matrix<T>&& rhs);
+template<typename T>
+Matrix<T> operator-(const Matrix<T>& lhs, Matrix<T>&& rhs);
+template<typename T>
+Matrix<T> operator-(Matrix<T>&& lhs, Matrix<T>&& rhs);
+template<typename T>
+Matrix<T> operator*(const T& scalar, Matrix<T>&& matrix);
+
 // Typedef for common types
 using MatrixD = Matrix<double>;
 using MatrixF = Matrix<float>;
 using MatrixI = Matrix<int>;
 
 #include "Matrix.cpp"  // Include implementation for template class
+#include "Solvers.h"   // Factorizations used by solve()
+#include "MatrixFunctions.h"
+#include "StructuredMatrix.h"
+#include "Covariance.h"
+#include "ExactArithmetic.h"
@@ -0,0 +1,385 @@
+#include "MatrixFunctions.h"
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+// Reallocate only when the shape changes
+template<typename T>
+void MatrixFunctionWorkspace<T>::ensureSize(Matrix<T>& target, size_t rows, size_t cols) {
+    if (target.getRows() != rows || target.getCols() != cols) {
+        target = Matrix<T>(rows, cols);
+    }
+}
+
+// C = A * B through the blocked gemm kernel, reusing the storage of C
+template<typename T>
+void MatrixFunctionWorkspace<T>::multiply(const Matrix<T>& A, const Matrix<T>& B, Matrix<T>& C) {
+    ensureSize(C, A.getRows(), B.getCols());
+    C.fill(T(0));
+    Matrix<T>::gemm(A.getRows(), B.getCols(), A.getCols(), T(1), A, 0, 0, B, 0, 0, C, 0, 0);
+}
+
+// out = identityCoeff * I + sum(coeff_k * M_k). Element-wise, so out may be one of the M_k.
+template<typename T>
+void MatrixFunctionWorkspace<T>::combine(Matrix<T>& out, T identityCoeff,
+                                         std::initializer_list<std::pair<T, const Matrix<T>*>> terms) {
+    const size_t rows = terms.begin()->second->getRows();
+    const size_t cols = terms.begin()->second->getCols();
+    ensureSize(out, rows, cols);
+
+    std::array<const T*, 8> sources;
+    std::array<T, 8> coeffs;
+    const size_t count = std::min(terms.size(), sources.size());
+    for (size_t i = 0; i < rows; ++i) {
+        size_t t = 0;
+        for (const auto& term : terms) {
+            if (t == count) break;
+            coeffs[t] = term.first;
+            sources[t] = (*term.second)[i].data();
+            ++t;
+        }
+
+        T* o = out[i].data();
+        for (size_t j = 0; j < cols; ++j) {
+            T value = (i == j) ? identityCoeff : T(0);
+            for (size_t k = 0; k < count; ++k) {
+                value += coeffs[k] * sources[k][j];
+            }
+            o[j] = value;
+        }
+    }
+}
+
+// ||A - I||_1 without forming A - I
+template<typename T>
+T MatrixFunctionWorkspace<T>::distanceFromIdentity(const Matrix<T>& A) {
+    std::vector<T> colSums(A.getCols(), T(0));
+    for (size_t i = 0; i < A.getRows(); ++i) {
+        const std::vector<T>& row = A[i];
+        for (size_t j = 0; j < A.getCols(); ++j) {
+            colSums[j] += std::abs(row[j] - ((i == j) ? T(1) : T(0)));
+        }
+    }
+    return colSums.empty() ? T(0) : *std::max_element(colSums.begin(), colSums.end());
+}
+
+// Diagonal Pade approximant r_m(A) = (V - U)^{-1} (V + U) of exp(A)
+template<typename T>
+void MatrixFunctionWorkspace<T>::padeExpm(const Matrix<T>& A, int degree, Matrix<T>& result) {
+    static const double b3[] = {120.0, 60.0, 12.0, 1.0};
+    static const double b5[] = {30240.0, 15120.0, 3360.0, 420.0, 30.0, 1.0};
+    static const double b7[] = {17297280.0, 8648640.0, 1995840.0, 277200.0, 25200.0, 1512.0, 56.0, 1.0};
+    static const double b9[] = {17643225600.0, 8821612800.0, 2075673600.0, 302702400.0, 30270240.0,
+                                2162160.0, 110880.0, 3960.0, 90.0, 1.0};
+    static const double b13[] = {64764752532480000.0, 32382376266240000.0, 7771770303897600.0,
+                                 1187353796428800.0, 129060195264000.0, 10559470521600.0,
+                                 670442572800.0, 33522128640.0, 1323241920.0, 40840800.0,
+                                 960960.0, 16380.0, 182.0, 1.0};
+
+    const double* b = (degree == 3) ? b3 : (degree == 5) ? b5 : (degree == 7) ? b7 : (degree == 9) ? b9 : b13;
+    auto c = [b](int i) { return static_cast<T>(b[i]); };
+
+    multiply(A, A, A2);
+    if (degree >= 5) multiply(A2, A2, A4);
+    if (degree >= 7) multiply(A2, A4, A6);
+    if (degree == 9) multiply(A4, A4, A8);
+
+    switch (degree) {
+        case 3:
+            combine(tmp, c(1), {{c(3), &A2}});
+            multiply(A, tmp, U);
+            combine(V, c(0), {{c(2), &A2}});
+            break;
+        case 5:
+            combine(tmp, c(1), {{c(5), &A4}, {c(3), &A2}});
+            multiply(A, tmp, U);
+            combine(V, c(0), {{c(4), &A4}, {c(2), &A2}});
+            break;
+        case 7:
+            combine(tmp, c(1), {{c(7), &A6}, {c(5), &A4}, {c(3), &A2}});
+            multiply(A, tmp, U);
+            combine(V, c(0), {{c(6), &A6}, {c(4), &A4}, {c(2), &A2}});
+            break;
+        case 9:
+            combine(tmp, c(1), {{c(9), &A8}, {c(7), &A6}, {c(5), &A4}, {c(3), &A2}});
+            multiply(A, tmp, U);
+            combine(V, c(0), {{c(8), &A8}, {c(6), &A6}, {c(4), &A4}, {c(2), &A2}});
+            break;
+        default:
+            // U = A * [A6 * (b13 A6 + b11 A4 + b9 A2) + b7 A6 + b5 A4 + b3 A2 + b1 I]
+            combine(tmp, T(0), {{c(13), &A6}, {c(11), &A4}, {c(9), &A2}});
+            multiply(A6, tmp, U);
+            combine(tmp, c(1), {{T(1), &U}, {c(7), &A6}, {c(5), &A4}, {c(3), &A2}});
+            multiply(A, tmp, U);
+            // V = A6 * (b12 A6 + b10 A4 + b8 A2) + b6 A6 + b4 A4 + b2 A2 + b0 I
+            combine(tmp, T(0), {{c(12), &A6}, {c(10), &A4}, {c(8), &A2}});
+            multiply(A6, tmp, V);
+            combine(V, c(0), {{T(1), &V}, {c(6), &A6}, {c(4), &A4}, {c(2), &A2}});
+            break;
+    }
+
+    combine(tmp, T(0), {{T(1), &V}, {T(-1), &U}});
+    combine(result, T(0), {{T(1), &V}, {T(1), &U}});
+    lu.refactor(tmp);
+    if (lu.isSingular()) {
+        throw std::runtime_error("Matrix exponential failed - singular Pade denominator");
+    }
+    lu.solveInPlace(result);
+}
+
+template<typename T>
+void MatrixFunctionWorkspace<T>::expm(const Matrix<T>& A, Matrix<T>& result) {
+    if (A.getRows() != A.getCols()) {
+        throw std::invalid_argument("Matrix exponential requires a square matrix");
+    }
+    if (A.getRows() == 0) {
+        result = Matrix<T>();
+        return;
+    }
+
+    const T norm = A.norm1();
+    if (!std::isfinite(static_cast<double>(norm))) {
+        throw std::invalid_argument("Matrix exponential requires finite entries");
+    }
+
+    // Largest 1-norm for which each degree is accurate to unit roundoff
+    const bool single = std::numeric_limits<T>::digits <= 24;
+    const std::array<std::pair<int, double>, 4> doubleThetas = {{
+        {3, 1.495585217958292e-2}, {5, 2.539398330063230e-1},
+        {7, 9.504178996162932e-1}, {9, 2.097847961257068e0}}};
+    const std::array<std::pair<int, double>, 2> singleThetas = {{
+        {3, 4.258730016922831e-1}, {5, 1.880152677804762e0}}};
+    const int maxDegree = single ? 7 : 13;
+    const double maxTheta = single ? 3.925724783138660e0 : 5.371920351148152e0;
+
+    if (single) {
+        for (const auto& [degree, theta] : singleThetas) {
+            if (norm <= theta) { padeExpm(A, degree, result); return; }
+        }
+    } else {
+        for (const auto& [degree, theta] : doubleThetas) {
+            if (norm <= theta) { padeExpm(A, degree, result); return; }
+        }
+    }
+
+    // Scale so the norm fits the top degree, then square back up
+    int squarings = 0;
+    if (norm > maxTheta) {
+        squarings = static_cast<int>(std::ceil(std::log2(static_cast<double>(norm) / maxTheta)));
+    }
+    combine(A1, T(0), {{static_cast<T>(std::ldexp(1.0, -squarings)), &A}});
+    padeExpm(A1, maxDegree, result);
+    for (int s = 0; s < squarings; ++s) {
+        multiply(result, result, tmp);
+        std::swap(result, tmp);
+    }
+}
+
+template<typename T>
+Matrix<T> MatrixFunctionWorkspace<T>::expm(const Matrix<T>& A) {
+    Matrix<T> result;
+    expm(A, result);
+    return result;
+}
+
+// Product-form Denman-Beavers:
+//   M_{k+1} = (I + (mu^2 M_k + mu^-2 M_k^{-1}) / 2) / 2
+//   Y_{k+1} = mu Y_k (I + mu^-2 M_k^{-1}) / 2
+// with M_0 = Y_0 = A and mu = |det(M_k)|^{-1/(2n)}; Y_k -> sqrt(A), M_k -> I.
+template<typename T>
+void MatrixFunctionWorkspace<T>::sqrtm(const Matrix<T>& A, Matrix<T>& result) {
+    if (A.getRows() != A.getCols()) {
+        throw std::invalid_argument("Matrix square root requires a square matrix");
+    }
+
+    const size_t n = A.getRows();
+    const int MAX_ITERATIONS = 100;
+    const T TOLERANCE = static_cast<T>(n) * std::numeric_limits<T>::epsilon();
+    const T SCALING_CUTOFF = T(1e-2);
+
+    M = A;
+    Y = A;
+    T distance = distanceFromIdentity(M);
+    if (distance <= TOLERANCE) {
+        result = Y;
+        return;
+    }
+
+    for (int iter = 0; iter < MAX_ITERATIONS; ++iter) {
+        lu.refactor(M);
+        if (lu.isSingular()) {
+            throw std::runtime_error("Matrix square root does not exist (singular iterate)");
+        }
+        lu.inverse(Minv);
+
+        T mu = T(1);
+        if (distance > SCALING_CUTOFF) {
+            const T logAbsDet = lu.logAbsDeterminant().second;
+            mu = static_cast<T>(std::exp(-logAbsDet / (T(2) * static_cast<T>(n))));
+        }
+        const T mu2 = mu * mu;
+
+        combine(tmp, T(1), {{T(1) / mu2, &Minv}});
+        multiply(Y, tmp, U);
+        combine(Y, T(0), {{mu / T(2), &U}});
+        combine(M, T(0.5), {{mu2 / T(4), &M}, {T(1) / (T(4) * mu2), &Minv}});
+
+        const T previous = distance;
+        distance = distanceFromIdentity(M);
+        if (!std::isfinite(static_cast<double>(distance))) break;
+        // Converged, or stagnated at rounding level
+        if (distance <= TOLERANCE ||
+            (distance < std::sqrt(std::numeric_limits<T>::epsilon()) && distance >= previous)) {
+            result = Y;
+            return;
+        }
+    }
+
+    throw std::runtime_error("Matrix square root iteration did not converge");
+}
+
+template<typename T>
+Matrix<T> MatrixFunctionWorkspace<T>::sqrtm(const Matrix<T>& A) {
+    Matrix<T> result;
+    sqrtm(A, result);
+    return result;
+}
+
+// Gauss-Legendre nodes and weights on [0, 1], by Newton iteration on P_m
+template<typename T>
+void MatrixFunctionWorkspace<T>::buildQuadrature(size_t points) {
+    if (quadrature.size() == points) return;
+
+    quadrature.clear();
+    const double PI = 3.14159265358979323846;
+    for (size_t i = 1; i <= points; ++i) {
+        double x = std::cos(PI * (static_cast<double>(i) - 0.25) / (static_cast<double>(points) + 0.5));
+        double derivative = 1.0;
+        for (int newton = 0; newton < 100; ++newton) {
+            double p0 = 1.0;
+            double p1 = x;
+            for (size_t k = 2; k <= points; ++k) {
+                double p2 = ((2.0 * k - 1.0) * x * p1 - (k - 1.0) * p0) / k;
+                p0 = p1;
+                p1 = p2;
+            }
+            derivative = points * (x * p1 - p0) / (x * x - 1.0);
+            const double dx = p1 / derivative;
+            x -= dx;
+            if (std::abs(dx) < 1e-15) break;
+        }
+        const double weight = 2.0 / ((1.0 - x * x) * derivative * derivative);
+        quadrature.emplace_back(static_cast<T>((1.0 + x) / 2.0), static_cast<T>(weight / 2.0));
+    }
+}
+
+// Inverse scaling and squaring: take square roots until A^(1/2^k) is close
+// to I, evaluate the [m/m] Pade approximant of log(I + E) in partial
+// fraction form sum_j w_j (I + x_j E)^{-1} E, and scale back by 2^k.
+template<typename T>
+void MatrixFunctionWorkspace<T>::logm(const Matrix<T>& A, Matrix<T>& result) {
+    if (A.getRows() != A.getCols()) {
+        throw std::invalid_argument("Matrix logarithm requires a square matrix");
+    }
+
+    // ||E||_1 bound for which the degree-m approximant reaches double roundoff
+    static const double thetas[] = {1.10e-5, 1.82e-3, 1.62e-2, 5.39e-2, 1.14e-1, 1.87e-1, 2.64e-1};
+    const size_t MAX_DEGREE = 7;
+    const int MAX_SQUARE_ROOTS = 64;
+
+    X = A;
+    int roots = 0;
+    while (distanceFromIdentity(X) > static_cast<T>(thetas[MAX_DEGREE - 1])) {
+        if (roots == MAX_SQUARE_ROOTS) {
+            throw std::runtime_error("Matrix logarithm failed - square roots did not approach identity");
+        }
+        sqrtm(X, Z);
+        std::swap(X, Z);
+        ++roots;
+    }
+
+    combine(E, T(-1), {{T(1), &X}});
+    const T norm = E.norm1();
+    size_t degree = 1;
+    while (degree < MAX_DEGREE && norm > static_cast<T>(thetas[degree - 1])) {
+        ++degree;
+    }
+    buildQuadrature(degree);
+
+    const size_t n = A.getRows();
+    ensureSize(result, n, n);
+    result.fill(T(0));
+    for (const auto& [node, weight] : quadrature) {
+        combine(tmp, T(1), {{node, &E}});
+        lu.refactor(tmp);
+        if (lu.isSingular()) {
+            throw std::runtime_error("Matrix logarithm failed - singular Pade denominator");
+        }
+        Z = E;
+        lu.solveInPlace(Z);
+        combine(result, T(0), {{T(1), &result}, {weight, &Z}});
+    }
+
+    if (roots > 0) {
+        result *= static_cast<T>(std::ldexp(1.0, roots));
+    }
+}
+
+template<typename T>
+Matrix<T> MatrixFunctionWorkspace<T>::logm(const Matrix<T>& A) {
+    Matrix<T> result;
+    logm(A, result);
+    return result;
+}
+
+// Binary powering: O(log |exponent|) multiplications
+template<typename T>
+void MatrixFunctionWorkspace<T>::pow(const Matrix<T>& A, int exponent, Matrix<T>& result) {
+    if (A.getRows() != A.getCols()) {
+        throw std::invalid_argument("Matrix power requires a square matrix");
+    }
+
+    if (exponent == 0) {
+        result = Matrix<T>::identity(A.getRows());
+        return;
+    }
+
+    if (exponent < 0) {
+        lu.refactor(A);
+        if (lu.isSingular()) {
+            throw std::runtime_error("Matrix is singular and cannot be inverted");
+        }
+        lu.inverse(A1);
+    } else {
+        A1 = A;
+    }
+
+    unsigned long long remaining = (exponent < 0)
+        ? static_cast<unsigned long long>(-static_cast<long long>(exponent))
+        : static_cast<unsigned long long>(exponent);
+    bool started = false;
+    while (remaining > 0) {
+        if (remaining & 1ULL) {
+            if (!started) {
+                result = A1;
+                started = true;
+            } else {
+                multiply(result, A1, tmp);
+                std::swap(result, tmp);
+            }
+        }
+        remaining >>= 1;
+        if (remaining > 0) {
+            multiply(A1, A1, tmp);
+            std::swap(A1, tmp);
+        }
+    }
+}
+
+template<typename T>
+Matrix<T> MatrixFunctionWorkspace<T>::pow(const Matrix<T>& A, int exponent) {
+    Matrix<T> result;
+    pow(A, exponent, result);
+    return result;
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include "Matrix.h"
+#include "Solvers.h"
+#include <vector>
+#include <utility>
+#include <initializer_list>
+
+// Matrix functions (expm, logm, sqrtm, integer powers) with reusable
+// workspace. Matrix<T>::expm() and friends create a workspace per call; hot
+// loops evaluating many functions of same-sized matrices should keep one
+// workspace alive so the temporaries and the LU storage are reused.
+template<typename T = double>
+class MatrixFunctionWorkspace {
+private:
+    // Temporaries shared by the algorithms below
+    Matrix<T> A1, A2, A4, A6, A8;
+    Matrix<T> U, V, tmp;
+    Matrix<T> M, Y, Minv;
+    Matrix<T> X, E, Z;
+    LUFactorization<T> lu;
+    std::vector<std::pair<T, T>> quadrature;  // Gauss-Legendre (node, weight) on [0, 1]
+
+public:
+    MatrixFunctionWorkspace() = default;
+
+    // Matrix exponential: scaling and squaring with Pade approximants (Higham 2005)
+    void expm(const Matrix<T>& A, Matrix<T>& result);
+    Matrix<T> expm(const Matrix<T>& A);
+
+    // Principal square root: product-form Denman-Beavers iteration with determinant scaling
+    void sqrtm(const Matrix<T>& A, Matrix<T>& result);
+    Matrix<T> sqrtm(const Matrix<T>& A);
+
+    // Principal logarithm: inverse scaling and squaring with Pade partial fractions
+    void logm(const Matrix<T>& A, Matrix<T>& result);
+    Matrix<T> logm(const Matrix<T>& A);
+
+    // Integer power by repeated squaring (negative exponents invert first)
+    void pow(const Matrix<T>& A, int exponent, Matrix<T>& result);
+    Matrix<T> pow(const Matrix<T>& A, int exponent);
+
+private:
+    static void ensureSize(Matrix<T>& target, size_t rows, size_t cols);
+    static void multiply(const Matrix<T>& A, const Matrix<T>& B, Matrix<T>& C);
+    static void combine(Matrix<T>& out, T identityCoeff,
+                        std::initializer_list<std::pair<T, const Matrix<T>*>> terms);
+    static T distanceFromIdentity(const Matrix<T>& A);
+
+    void padeExpm(const Matrix<T>& A, int degree, Matrix<T>& result);
+    void buildQuadrature(size_t points);
+};
+
+#include "MatrixFunctions.cpp"  // Include implementation for template class
@@ -0,0 +1,951 @@
+#include "MatrixIO.h"
+#include <fstream>
+#include <sstream>
+#include <cstring>
+#include <charconv>
+#include <exception>
+#include <cctype>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define LINALG_HAVE_MMAP 1
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// ---------------------------------------------------------------------------
+// Header and checksum
+// ---------------------------------------------------------------------------
+
+inline void MatrixFileHeader::validate(size_t fileSize) const {
+    if (std::memcmp(magic, "LINALGMX", 8) != 0) {
+        throw std::runtime_error("Not a binary matrix file (bad magic)");
+    }
+    if (version == 0 || version > CURRENT_VERSION) {
+        throw std::runtime_error("Unsupported binary matrix format version " + std::to_string(version));
+    }
+    if (byteOrder != BYTE_ORDER_TAG) {
+        throw std::runtime_error("Binary matrix file was written with a different byte order");
+    }
+    if (layout != static_cast<uint32_t>(MatrixLayout::RowMajor) &&
+        layout != static_cast<uint32_t>(MatrixLayout::ColumnMajor)) {
+        throw std::runtime_error("Unknown matrix layout in binary matrix file");
+    }
+    // Before any use of elementSize, so that a corrupt one cannot divide by zero
+    uint32_t typeSize = 0;
+    switch (static_cast<MatrixElementType>(elementType)) {
+        case MatrixElementType::Float32:
+        case MatrixElementType::Int32:
+            typeSize = 4;
+            break;
+        case MatrixElementType::Float64:
+        case MatrixElementType::Int64:
+            typeSize = 8;
+            break;
+    }
+    if (typeSize == 0) {
+        throw std::runtime_error("Unknown element type in binary matrix file");
+    }
+    if (elementSize != typeSize) {
+        throw std::runtime_error("Element size does not match the element type in binary matrix file");
+    }
+    if (dataOffset < sizeof(MatrixFileHeader) || dataOffset % DATA_ALIGNMENT != 0 ||
+        dataOffset > fileSize || dataSize > fileSize - dataOffset) {
+        throw std::runtime_error("Binary matrix file is truncated or has an invalid payload offset");
+    }
+    if (dataSize % elementSize != 0) {
+        throw std::runtime_error("Binary matrix payload is not a whole number of elements");
+    }
+
+    const bool rowMajor = layout == static_cast<uint32_t>(MatrixLayout::RowMajor);
+    const bool stridesOk = rowMajor ? (colStride == 1 && rowStride >= static_cast<int64_t>(cols))
+                                    : (rowStride == 1 && colStride >= static_cast<int64_t>(rows));
+    if (!stridesOk) {
+        throw std::runtime_error("Invalid strides in binary matrix file");
+    }
+    if (rows > 0 && cols > 0) {
+        // An empty matrix may be written with a zero stride; any other needs
+        // both positive (the check above passes anything for cols > INT64_MAX)
+        if (rowStride < 1 || colStride < 1) {
+            throw std::runtime_error("Invalid strides in binary matrix file");
+        }
+        // (rows - 1) * rowStride + (cols - 1) * colStride + 1 <= capacity,
+        // term by term so that nothing wraps around
+        const uint64_t capacity = dataSize / elementSize;
+        const uint64_t rowStep = static_cast<uint64_t>(rowStride);
+        const uint64_t colStep = static_cast<uint64_t>(colStride);
+        if (capacity == 0 || rows - 1 > (capacity - 1) / rowStep ||
+            cols - 1 > (capacity - 1 - (rows - 1) * rowStep) / colStep) {
+            throw std::runtime_error("Binary matrix payload is smaller than its shape requires");
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Owning read / write
+// ---------------------------------------------------------------------------
+
+template<typename T>
+void saveMatrixBinary(const Matrix<T>& matrix, const std::string& path) {
+    MatrixFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, "LINALGMX", 8);
+    header.version = MatrixFileHeader::CURRENT_VERSION;
+    header.byteOrder = MatrixFileHeader::BYTE_ORDER_TAG;
+    header.elementType = static_cast<uint32_t>(MatrixElementTraits<T>::code);
+    header.elementSize = sizeof(T);
+    header.layout = static_cast<uint32_t>(MatrixLayout::RowMajor);
+    header.rows = matrix.getRows();
+    header.cols = matrix.getCols();
+    header.rowStride = static_cast<int64_t>(matrix.getCols());
+    header.colStride = 1;
+    header.dataOffset = sizeof(MatrixFileHeader);
+    header.dataSize = static_cast<uint64_t>(matrix.getRows()) * matrix.getCols() * sizeof(T);
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Cannot open file for writing: " + path);
+    }
+
+    // Header first with a zero checksum, rows streamed, then the header is rewritten
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    Checksum64 checksum;
+    const size_t rowBytes = matrix.getCols() * sizeof(T);
+    for (size_t i = 0; i < matrix.getRows(); ++i) {
+        const T* row = matrix[i].data();
+        checksum.update(row, rowBytes);
+        out.write(reinterpret_cast<const char*>(row), static_cast<std::streamsize>(rowBytes));
+    }
+    header.checksum = checksum.digest();
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.close();
+    if (!out) {
+        throw std::runtime_error("Failed to write matrix file: " + path);
+    }
+}
+
+template<typename T>
+Matrix<T> loadMatrixBinary(const std::string& path) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        throw std::runtime_error("Cannot open file for reading: " + path);
+    }
+    const size_t fileSize = static_cast<size_t>(in.tellg());
+    in.seekg(0);
+
+    MatrixFileHeader header;
+    if (fileSize < sizeof(header) || !in.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        throw std::runtime_error("Binary matrix file is truncated: " + path);
+    }
+    header.validate(fileSize);
+    if (header.elementType != static_cast<uint32_t>(MatrixElementTraits<T>::code) ||
+        header.elementSize != sizeof(T)) {
+        throw std::invalid_argument("File element type does not match the requested matrix type");
+    }
+
+    const size_t rows = header.rows;
+    const size_t cols = header.cols;
+    Matrix<T> result(rows, cols);
+    Checksum64 checksum;
+    in.seekg(static_cast<std::streamoff>(header.dataOffset));
+
+    if (header.layout == static_cast<uint32_t>(MatrixLayout::RowMajor) &&
+        header.rowStride == static_cast<int64_t>(cols) &&
+        header.dataSize == static_cast<uint64_t>(rows) * cols * sizeof(T)) {
+        // Dense row-major: read straight into the row buffers
+        const size_t rowBytes = cols * sizeof(T);
+        for (size_t i = 0; i < rows; ++i) {
+            T* row = result[i].data();
+            in.read(reinterpret_cast<char*>(row), static_cast<std::streamsize>(rowBytes));
+            checksum.update(row, rowBytes);
+        }
+    } else {
+        // Padded or column-major: read the payload once and gather through the strides
+        std::vector<T> payload(header.dataSize / sizeof(T));
+        const size_t payloadBytes = payload.size() * sizeof(T);
+        in.read(reinterpret_cast<char*>(payload.data()), static_cast<std::streamsize>(payloadBytes));
+        checksum.update(payload.data(), payloadBytes);
+        for (size_t i = 0; i < rows; ++i) {
+            std::vector<T>& row = result[i];
+            for (size_t j = 0; j < cols; ++j) {
+                row[j] = payload[i * header.rowStride + j * header.colStride];
+            }
+        }
+    }
+
+    if (!in) {
+        throw std::runtime_error("Binary matrix file is truncated: " + path);
+    }
+    if (checksum.digest() != header.checksum) {
+        throw std::runtime_error("Checksum mismatch in binary matrix file: " + path);
+    }
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+// MappedMatrix
+// ---------------------------------------------------------------------------
+
+template<typename T>
+MappedMatrix<T>::MappedMatrix()
+    : mapping(nullptr), mappingSize(0), base(nullptr), rows(0), cols(0),
+      rowStride(0), colStride(1), storedChecksum(0) {}
+
+template<typename T>
+MappedMatrix<T>::MappedMatrix(const std::string& path) : MappedMatrix() {
+#ifdef LINALG_HAVE_MMAP
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open file for reading: " + path);
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot stat file: " + path);
+    }
+    mappingSize = static_cast<size_t>(info.st_size);
+    if (mappingSize < sizeof(MatrixFileHeader)) {
+        ::close(fd);
+        throw std::runtime_error("Binary matrix file is truncated: " + path);
+    }
+    void* address = ::mmap(nullptr, mappingSize, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);  // The mapping keeps the file referenced
+    if (address == MAP_FAILED) {
+        mappingSize = 0;
+        throw std::runtime_error("Cannot memory-map file: " + path);
+    }
+    mapping = static_cast<const uint8_t*>(address);
+#else
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        throw std::runtime_error("Cannot open file for reading: " + path);
+    }
+    fallback.resize(static_cast<size_t>(in.tellg()));
+    in.seekg(0);
+    in.read(reinterpret_cast<char*>(fallback.data()), static_cast<std::streamsize>(fallback.size()));
+    if (fallback.size() < sizeof(MatrixFileHeader) || !in) {
+        throw std::runtime_error("Binary matrix file is truncated: " + path);
+    }
+    mapping = fallback.data();
+    mappingSize = fallback.size();
+#endif
+
+    try {
+        MatrixFileHeader header;
+        std::memcpy(&header, mapping, sizeof(header));
+        header.validate(mappingSize);
+        if (header.elementType != static_cast<uint32_t>(MatrixElementTraits<T>::code) ||
+            header.elementSize != sizeof(T)) {
+            throw std::invalid_argument("File element type does not match the requested matrix type");
+        }
+        base = reinterpret_cast<const T*>(mapping + header.dataOffset);
+        rows = header.rows;
+        cols = header.cols;
+        rowStride = header.rowStride;
+        colStride = header.colStride;
+        storedChecksum = header.checksum;
+    } catch (...) {
+        release();
+        throw;
+    }
+}
+
+template<typename T>
+void MappedMatrix<T>::release() {
+#ifdef LINALG_HAVE_MMAP
+    if (mapping && fallback.empty()) {
+        ::munmap(const_cast<uint8_t*>(mapping), mappingSize);
+    }
+#endif
+    fallback.clear();
+    mapping = nullptr;
+    mappingSize = 0;
+    base = nullptr;
+    rows = cols = 0;
+}
+
+template<typename T>
+MappedMatrix<T>::~MappedMatrix() {
+    release();
+}
+
+template<typename T>
+MappedMatrix<T>::MappedMatrix(MappedMatrix&& other) noexcept
+    : mapping(other.mapping), mappingSize(other.mappingSize), fallback(std::move(other.fallback)),
+      base(other.base), rows(other.rows), cols(other.cols), rowStride(other.rowStride),
+      colStride(other.colStride), storedChecksum(other.storedChecksum) {
+    other.mapping = nullptr;
+    other.mappingSize = 0;
+    other.base = nullptr;
+    other.rows = other.cols = 0;
+}
+
+template<typename T>
+MappedMatrix<T>& MappedMatrix<T>::operator=(MappedMatrix&& other) noexcept {
+    if (this != &other) {
+        release();
+        mapping = other.mapping;
+        mappingSize = other.mappingSize;
+        fallback = std::move(other.fallback);
+        base = other.base;
+        rows = other.rows;
+        cols = other.cols;
+        rowStride = other.rowStride;
+        colStride = other.colStride;
+        storedChecksum = other.storedChecksum;
+        other.mapping = nullptr;
+        other.mappingSize = 0;
+        other.base = nullptr;
+        other.rows = other.cols = 0;
+    }
+    return *this;
+}
+
+template<typename T>
+const T& MappedMatrix<T>::operator()(size_t i, size_t j) const {
+    if (i >= rows || j >= cols) {
+        throw std::out_of_range("Matrix indices out of range");
+    }
+    return base[i * rowStride + j * colStride];
+}
+
+template<typename T>
+const T* MappedMatrix<T>::row(size_t i) const {
+    if (i >= rows) {
+        throw std::out_of_range("Row index out of range");
+    }
+    if (!isRowMajor()) {
+        throw std::logic_error("Row pointers require a row-major file");
+    }
+    return base + i * rowStride;
+}
+
+template<typename T>
+bool MappedMatrix<T>::verifyChecksum() const {
+    if (!mapping) return false;
+    MatrixFileHeader header;
+    std::memcpy(&header, mapping, sizeof(header));
+    Checksum64 checksum;
+    checksum.update(mapping + header.dataOffset, header.dataSize);
+    return checksum.digest() == storedChecksum;
+}
+
+template<typename T>
+Matrix<T> MappedMatrix<T>::toMatrix() const {
+    return rowRange(0, rows);
+}
+
+template<typename T>
+Matrix<T> MappedMatrix<T>::rowRange(size_t begin, size_t end) const {
+    if (begin > end || end > rows) {
+        throw std::out_of_range("Row range out of range");
+    }
+
+    Matrix<T> result(end - begin, cols);
+    for (size_t i = begin; i < end; ++i) {
+        std::vector<T>& out = result[i - begin];
+        if (isRowMajor()) {
+            std::memcpy(out.data(), base + i * rowStride, cols * sizeof(T));
+        } else {
+            for (size_t j = 0; j < cols; ++j) out[j] = base[i + j * colStride];
+        }
+    }
+    return result;
+}
+
+template<typename T>
+Matrix<T> MappedMatrix<T>::multiply(const Matrix<T>& B) const {
+    if (B.getRows() != cols) {
+        throw std::invalid_argument("Invalid matrix dimensions for multiplication");
+    }
+
+    const size_t m = B.getCols();
+    Matrix<T> result(rows, m);
+    for (size_t i = 0; i < rows; ++i) {
+        std::vector<T>& out = result[i];
+        for (size_t k = 0; k < cols; ++k) {
+            const T a = base[i * rowStride + k * colStride];
+            if (a == T(0)) continue;
+            const std::vector<T>& b_row = B[k];
+            for (size_t j = 0; j < m; ++j) out[j] += a * b_row[j];
+        }
+    }
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+// Text formats: shared chunked parsing
+// ---------------------------------------------------------------------------
+
+namespace matrix_io_detail {
+
+inline std::string readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        throw std::runtime_error("Cannot open file for reading: " + path);
+    }
+    std::string contents(static_cast<size_t>(in.tellg()), '\0');
+    in.seekg(0);
+    in.read(&contents[0], static_cast<std::streamsize>(contents.size()));
+    if (!in) {
+        throw std::runtime_error("Failed to read file: " + path);
+    }
+    return contents;
+}
+
+// Chunks smaller than this are not worth a thread
+constexpr size_t MIN_BYTES_PER_THREAD = size_t(1) << 20;
+
+inline unsigned resolveThreads(unsigned threads, size_t work) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    return static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(threads, work / MIN_BYTES_PER_THREAD + 1)));
+}
+
+// Runs task(0) .. task(count - 1) on their own threads and rethrows the
+// first exception after all of them have finished
+template<typename Task>
+void runTasks(size_t count, Task task) {
+    if (count == 1) {
+        task(0);
+        return;
+    }
+    std::vector<std::exception_ptr> errors(count);
+    std::vector<std::thread> workers;
+    workers.reserve(count);
+    for (size_t t = 0; t < count; ++t) {
+        workers.emplace_back([&, t]() {
+            try {
+                LINALG_PROFILE("MatrixIO::task", 0, 0);
+                task(t);
+            } catch (...) {
+                errors[t] = std::current_exception();
+            }
+        });
+    }
+    for (std::thread& worker : workers) worker.join();
+    for (const std::exception_ptr& error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+}
+
+inline bool isBlank(const char* begin, const char* end) {
+    for (; begin < end; ++begin) {
+        if (*begin != ' ' && *begin != '\t' && *begin != '\r') return false;
+    }
+    return true;
+}
+
+// Calls fn(begin, end) for every non-blank line; end excludes "\r\n"
+template<typename Fn>
+void forEachLine(const char* begin, const char* end, Fn fn) {
+    while (begin < end) {
+        const char* newline = static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+        const char* lineEnd = newline ? newline : end;
+        const char* contentEnd = (lineEnd > begin && lineEnd[-1] == '\r') ? lineEnd - 1 : lineEnd;
+        if (!isBlank(begin, contentEnd)) fn(begin, contentEnd);
+        begin = newline ? newline + 1 : end;
+    }
+}
+
+struct LineChunk {
+    const char* begin;
+    const char* end;
+    size_t firstLine;  // Index of the chunk's first non-blank line in the whole text
+    size_t lines;
+};
+
+// Splits text into line-aligned chunks and counts the non-blank lines of
+// each chunk in parallel, so every chunk knows where its output starts
+inline std::vector<LineChunk> splitLines(const char* begin, const char* end, unsigned threads) {
+    std::vector<LineChunk> chunks;
+    const size_t size = static_cast<size_t>(end - begin);
+    const char* chunkBegin = begin;
+    for (unsigned t = 1; t <= threads && chunkBegin < end; ++t) {
+        const char* chunkEnd = t == threads ? end : begin + size * t / threads;
+        if (chunkEnd < chunkBegin) chunkEnd = chunkBegin;
+        if (chunkEnd < end) {
+            const char* newline = static_cast<const char*>(std::memchr(chunkEnd, '\n', end - chunkEnd));
+            chunkEnd = newline ? newline + 1 : end;
+        }
+        chunks.push_back({chunkBegin, chunkEnd, 0, 0});
+        chunkBegin = chunkEnd;
+    }
+
+    runTasks(chunks.size(), [&](size_t t) {
+        size_t lines = 0;
+        forEachLine(chunks[t].begin, chunks[t].end, [&](const char*, const char*) { ++lines; });
+        chunks[t].lines = lines;
+    });
+    size_t offset = 0;
+    for (LineChunk& chunk : chunks) {
+        chunk.firstLine = offset;
+        offset += chunk.lines;
+    }
+    return chunks;
+}
+
+inline size_t countLines(const std::vector<LineChunk>& chunks) {
+    return chunks.empty() ? 0 : chunks.back().firstLine + chunks.back().lines;
+}
+
+// Parses one number, skipping leading blanks other than the delimiter.
+// Returns nullptr on failure.
+template<typename T>
+const char* parseNumber(const char* p, const char* end, T& value, char delimiter = '\0') {
+    while (p < end && (*p == ' ' || *p == '\t') && *p != delimiter) ++p;
+    if (p < end && *p == '+') ++p;
+    auto [next, error] = std::from_chars(p, end, value);
+    return error == std::errc() ? next : nullptr;
+}
+
+inline const char* skipBlanks(const char* p, const char* end, char delimiter = '\0') {
+    while (p < end && (*p == ' ' || *p == '\t') && *p != delimiter) ++p;
+    return p;
+}
+
+template<typename T>
+void appendNumber(std::string& out, const T& value) {
+    char buffer[64];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+inline void writeAll(std::ofstream& out, const std::string& text, const std::string& path) {
+    out.write(text.data(), static_cast<std::streamsize>(text.size()));
+    if (!out) {
+        throw std::runtime_error("Failed to write matrix file: " + path);
+    }
+}
+
+inline bool hostIsLittleEndian() {
+    const uint16_t probe = 1;
+    uint8_t first;
+    std::memcpy(&first, &probe, 1);
+    return first == 1;
+}
+
+}  // namespace matrix_io_detail
+
+// ---------------------------------------------------------------------------
+// CSV / TSV
+// ---------------------------------------------------------------------------
+
+template<typename T>
+Matrix<T> loadMatrixCSV(const std::string& path, char delimiter, bool skipHeader, unsigned threads) {
+    using namespace matrix_io_detail;
+    const std::string text = readFile(path);
+    const char* begin = text.data();
+    const char* end = begin + text.size();
+
+    if (skipHeader) {
+        const char* newline = static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+        begin = newline ? newline + 1 : end;
+    }
+
+    // Column count comes from the first non-blank line
+    size_t cols = 0;
+    for (const char* line = begin; line < end && cols == 0;) {
+        const char* newline = static_cast<const char*>(std::memchr(line, '\n', end - line));
+        const char* lineEnd = newline ? newline : end;
+        if (!isBlank(line, lineEnd)) cols = static_cast<size_t>(std::count(line, lineEnd, delimiter)) + 1;
+        line = newline ? newline + 1 : end;
+    }
+
+    const std::vector<LineChunk> chunks = splitLines(begin, end, resolveThreads(threads, text.size()));
+    Matrix<T> result(countLines(chunks), cols);
+
+    runTasks(chunks.size(), [&](size_t t) {
+        size_t row = chunks[t].firstLine;
+        forEachLine(chunks[t].begin, chunks[t].end, [&](const char* p, const char* lineEnd) {
+            std::vector<T>& out = result[row];
+            for (size_t j = 0; j < cols; ++j) {
+                p = parseNumber(p, lineEnd, out[j], delimiter);
+                if (!p) {
+                    throw std::runtime_error("Invalid number in row " + std::to_string(row + 1) +
+                                             ", column " + std::to_string(j + 1) + " of " + path);
+                }
+                p = skipBlanks(p, lineEnd, delimiter);
+                const bool last = j + 1 == cols;
+                if (last ? p != lineEnd : (p == lineEnd || *p != delimiter)) {
+                    throw std::runtime_error("Row " + std::to_string(row + 1) + " of " + path +
+                                             " does not have " + std::to_string(cols) + " fields");
+                }
+                ++p;
+            }
+            ++row;
+        });
+    });
+    return result;
+}
+
+// Rows are formatted in parallel batches and written in order
+template<typename T>
+void saveMatrixCSV(const Matrix<T>& matrix, const std::string& path, char delimiter, unsigned threads) {
+    using namespace matrix_io_detail;
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Cannot open file for writing: " + path);
+    }
+
+    const size_t rows = matrix.getRows();
+    const size_t cols = matrix.getCols();
+    const size_t bytesPerRow = cols * 24 + 1;  // Upper bound for shortest round-trip doubles
+    const size_t rowsPerTask = std::max<size_t>(1, MIN_BYTES_PER_THREAD / bytesPerRow);
+    const unsigned workers = resolveThreads(threads, rows * bytesPerRow);
+    std::vector<std::string> buffers(workers);
+
+    for (size_t batch = 0; batch < rows; batch += rowsPerTask * workers) {
+        runTasks(workers, [&](size_t t) {
+            std::string& buffer = buffers[t];
+            buffer.clear();
+            const size_t first = std::min(rows, batch + t * rowsPerTask);
+            const size_t last = std::min(rows, first + rowsPerTask);
+            for (size_t i = first; i < last; ++i) {
+                const std::vector<T>& row = matrix[i];
+                for (size_t j = 0; j < cols; ++j) {
+                    if (j > 0) buffer.push_back(delimiter);
+                    appendNumber(buffer, row[j]);
+                }
+                buffer.push_back('\n');
+            }
+        });
+        for (const std::string& buffer : buffers) writeAll(out, buffer, path);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Matrix Market
+// ---------------------------------------------------------------------------
+
+template<typename T>
+Matrix<T> loadMatrixMarket(const std::string& path, unsigned threads) {
+    using namespace matrix_io_detail;
+    const std::string text = readFile(path);
+    const char* p = text.data();
+    const char* end = p + text.size();
+
+    auto nextLine = [&](const char*& lineBegin, const char*& lineEnd) {
+        lineBegin = p;
+        const char* newline = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        lineEnd = newline ? newline : end;
+        p = newline ? newline + 1 : end;
+        if (lineEnd > lineBegin && lineEnd[-1] == '\r') --lineEnd;
+    };
+
+    // Banner: %%MatrixMarket matrix <format> <field> <symmetry>
+    const char* lineBegin;
+    const char* lineEnd;
+    nextLine(lineBegin, lineEnd);
+    std::string banner(lineBegin, lineEnd);
+    std::transform(banner.begin(), banner.end(), banner.begin(), [](unsigned char c) { return std::tolower(c); });
+    std::istringstream bannerStream(banner);
+    std::string tag, object, format, field, symmetry;
+    bannerStream >> tag >> object >> format >> field >> symmetry;
+    if (tag != "%%matrixmarket" || object != "matrix") {
+        throw std::runtime_error("Not a Matrix Market matrix file: " + path);
+    }
+    const bool coordinate = format == "coordinate";
+    if (!coordinate && format != "array") {
+        throw std::runtime_error("Unknown Matrix Market format '" + format + "' in " + path);
+    }
+    const bool pattern = field == "pattern";
+    if (field != "real" && field != "double" && field != "integer" && !pattern) {
+        throw std::runtime_error("Unsupported Matrix Market field '" + field + "' in " + path);
+    }
+    const bool skew = symmetry == "skew-symmetric";
+    const bool symmetric = symmetry == "symmetric" || symmetry == "hermitian" || skew;
+    if (!symmetric && symmetry != "general") {
+        throw std::runtime_error("Unknown Matrix Market symmetry '" + symmetry + "' in " + path);
+    }
+
+    // Size line follows the comments
+    do {
+        if (p >= end) throw std::runtime_error("Matrix Market file has no size line: " + path);
+        nextLine(lineBegin, lineEnd);
+    } while (lineBegin < lineEnd && *lineBegin == '%');
+    while (isBlank(lineBegin, lineEnd) && p < end) nextLine(lineBegin, lineEnd);
+
+    size_t rows = 0, cols = 0, entries = 0;
+    const char* q = parseNumber(lineBegin, lineEnd, rows);
+    q = q ? parseNumber(q, lineEnd, cols) : nullptr;
+    if (q && coordinate) q = parseNumber(q, lineEnd, entries);
+    if (!q || skipBlanks(q, lineEnd) != lineEnd) {
+        throw std::runtime_error("Invalid Matrix Market size line in " + path);
+    }
+    if (symmetric && rows != cols) {
+        throw std::runtime_error("Symmetric Matrix Market matrix must be square: " + path);
+    }
+    if (!coordinate) {
+        entries = symmetric ? (skew ? rows * (rows - 1) / 2 : rows * (rows + 1) / 2) : rows * cols;
+    }
+
+    const std::vector<LineChunk> chunks = splitLines(p, end, resolveThreads(threads, end - p));
+    if (countLines(chunks) != entries) {
+        throw std::runtime_error("Matrix Market file " + path + " has " + std::to_string(countLines(chunks)) +
+                                 " entries, expected " + std::to_string(entries));
+    }
+
+    Matrix<T> result(rows, cols);
+    auto invalidEntry = [&](size_t k) {
+        return std::runtime_error("Invalid Matrix Market entry " + std::to_string(k + 1) + " in " + path);
+    };
+
+    if (!coordinate) {
+        // Column-major values; symmetric files list the lower triangle of each column
+        const size_t diagonalOffset = skew ? 1 : 0;
+        std::vector<size_t> columnStart(cols + 1, 0);
+        for (size_t j = 0; j < cols; ++j) {
+            const size_t height = symmetric ? rows - std::min(rows, j + diagonalOffset) : rows;
+            columnStart[j + 1] = columnStart[j] + height;
+        }
+
+        runTasks(chunks.size(), [&](size_t t) {
+            size_t k = chunks[t].firstLine;
+            size_t j = std::upper_bound(columnStart.begin(), columnStart.end(), k) - columnStart.begin() - 1;
+            forEachLine(chunks[t].begin, chunks[t].end, [&](const char* b, const char* e) {
+                while (columnStart[j + 1] <= k) ++j;
+                const size_t i = k - columnStart[j] + (symmetric ? j + diagonalOffset : 0);
+                T value;
+                const char* next = parseNumber(b, e, value);
+                if (!next || skipBlanks(next, e) != e) throw invalidEntry(k);
+                result[i][j] = value;
+                if (symmetric && i != j) result[j][i] = skew ? -value : value;
+                ++k;
+            });
+        });
+        return result;
+    }
+
+    // Coordinate: parse triplets in parallel, then scatter (summing duplicates)
+    std::vector<size_t> rowIndex(entries), colIndex(entries);
+    std::vector<T> values(entries, T(1));
+    runTasks(chunks.size(), [&](size_t t) {
+        size_t k = chunks[t].firstLine;
+        forEachLine(chunks[t].begin, chunks[t].end, [&](const char* b, const char* e) {
+            const char* next = parseNumber(b, e, rowIndex[k]);
+            next = next ? parseNumber(next, e, colIndex[k]) : nullptr;
+            if (next && !pattern) next = parseNumber(next, e, values[k]);
+            if (!next || skipBlanks(next, e) != e) throw invalidEntry(k);
+            if (rowIndex[k] == 0 || rowIndex[k] > rows || colIndex[k] == 0 || colIndex[k] > cols) {
+                throw std::runtime_error("Matrix Market entry " + std::to_string(k + 1) + " in " + path +
+                                         " is outside the matrix");
+            }
+            ++k;
+        });
+    });
+    for (size_t k = 0; k < entries; ++k) {
+        const size_t i = rowIndex[k] - 1;
+        const size_t j = colIndex[k] - 1;
+        result[i][j] += values[k];
+        if (symmetric && i != j) result[j][i] += skew ? -values[k] : values[k];
+    }
+    return result;
+}
+
+template<typename T>
+void saveMatrixMarket(const Matrix<T>& matrix, const std::string& path) {
+    using namespace matrix_io_detail;
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Cannot open file for writing: " + path);
+    }
+
+    std::string buffer = std::is_integral<T>::value ? "%%MatrixMarket matrix array integer general\n"
+                                                    : "%%MatrixMarket matrix array real general\n";
+    appendNumber(buffer, matrix.getRows());
+    buffer.push_back(' ');
+    appendNumber(buffer, matrix.getCols());
+    buffer.push_back('\n');
+    for (size_t j = 0; j < matrix.getCols(); ++j) {
+        for (size_t i = 0; i < matrix.getRows(); ++i) {
+            appendNumber(buffer, matrix[i][j]);
+            buffer.push_back('\n');
+        }
+        if (buffer.size() >= MIN_BYTES_PER_THREAD) {
+            writeAll(out, buffer, path);
+            buffer.clear();
+        }
+    }
+    writeAll(out, buffer, path);
+}
+
+// ---------------------------------------------------------------------------
+// NumPy .npy
+// ---------------------------------------------------------------------------
+
+namespace matrix_io_detail {
+
+template<typename Stored, typename T>
+void readNpyPayload(std::ifstream& in, Matrix<T>& result, bool fortranOrder, const std::string& path) {
+    const size_t rows = result.getRows();
+    const size_t cols = result.getCols();
+    std::vector<Stored> payload(rows * cols);
+    in.read(reinterpret_cast<char*>(payload.data()), static_cast<std::streamsize>(payload.size() * sizeof(Stored)));
+    if (!in) {
+        throw std::runtime_error("NumPy file is truncated: " + path);
+    }
+    for (size_t i = 0; i < rows; ++i) {
+        std::vector<T>& row = result[i];
+        for (size_t j = 0; j < cols; ++j) {
+            row[j] = static_cast<T>(payload[fortranOrder ? j * rows + i : i * cols + j]);
+        }
+    }
+}
+
+}  // namespace matrix_io_detail
+
+template<typename T>
+Matrix<T> loadMatrixNpy(const std::string& path) {
+    using namespace matrix_io_detail;
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Cannot open file for reading: " + path);
+    }
+
+    unsigned char preamble[8];
+    if (!in.read(reinterpret_cast<char*>(preamble), 8) || std::memcmp(preamble, "\x93NUMPY", 6) != 0) {
+        throw std::runtime_error("Not a NumPy .npy file: " + path);
+    }
+    const unsigned major = preamble[6];
+    if (major < 1 || major > 3) {
+        throw std::runtime_error("Unsupported .npy format version " + std::to_string(major) + " in " + path);
+    }
+    unsigned char lengthBytes[4] = {0, 0, 0, 0};
+    in.read(reinterpret_cast<char*>(lengthBytes), major == 1 ? 2 : 4);
+    const size_t headerLength = lengthBytes[0] | (lengthBytes[1] << 8) | (size_t(lengthBytes[2]) << 16) |
+                                (size_t(lengthBytes[3]) << 24);
+    std::string header(headerLength, '\0');
+    if (!in.read(&header[0], static_cast<std::streamsize>(headerLength))) {
+        throw std::runtime_error("NumPy file is truncated: " + path);
+    }
+
+    auto valueOf = [&](const std::string& key) {
+        const size_t keyPos = header.find("'" + key + "'");
+        const size_t colon = keyPos == std::string::npos ? keyPos : header.find(':', keyPos);
+        if (colon == std::string::npos) {
+            throw std::runtime_error("NumPy header is missing '" + key + "' in " + path);
+        }
+        return header.find_first_not_of(' ', colon + 1);
+    };
+
+    const size_t descrPos = valueOf("descr");
+    const size_t descrEnd = header.find(header[descrPos], descrPos + 1);
+    const std::string descr = header.substr(descrPos + 1, descrEnd - descrPos - 1);
+    const bool fortranOrder = header.compare(valueOf("fortran_order"), 4, "True") == 0;
+
+    std::vector<size_t> shape;
+    const size_t shapePos = valueOf("shape");
+    const char* s = header.c_str() + shapePos + 1;
+    const char* shapeEnd = header.c_str() + header.find(')', shapePos);
+    while (s < shapeEnd) {
+        size_t extent;
+        const char* next = parseNumber(s, shapeEnd, extent);
+        if (!next) break;
+        shape.push_back(extent);
+        s = skipBlanks(next, shapeEnd);
+        if (s < shapeEnd && *s == ',') ++s;
+    }
+    if (shape.size() > 2) {
+        throw std::runtime_error("Only 0-D, 1-D and 2-D arrays can be loaded as a matrix: " + path);
+    }
+    const size_t rows = shape.empty() ? 1 : shape[0];
+    const size_t cols = shape.size() == 2 ? shape[1] : 1;
+
+    const char byteOrder = descr.empty() ? '?' : descr[0];
+    const bool nativeOrder = byteOrder == '|' || byteOrder == '=' ||
+                             (byteOrder == '<') == hostIsLittleEndian();
+    if (!nativeOrder) {
+        throw std::runtime_error("NumPy data in " + path + " has non-native byte order '" + descr + "'");
+    }
+
+    Matrix<T> result(rows, cols);
+    const std::string kind = descr.substr(1);
+    if (kind == "f8") readNpyPayload<double>(in, result, fortranOrder, path);
+    else if (kind == "f4") readNpyPayload<float>(in, result, fortranOrder, path);
+    else if (kind == "i8") readNpyPayload<int64_t>(in, result, fortranOrder, path);
+    else if (kind == "i4") readNpyPayload<int32_t>(in, result, fortranOrder, path);
+    else throw std::runtime_error("Unsupported NumPy dtype '" + descr + "' in " + path);
+    return result;
+}
+
+template<typename T>
+void saveMatrixNpy(const Matrix<T>& matrix, const std::string& path) {
+    using namespace matrix_io_detail;
+    const char* kinds[] = {"", "f4", "f8", "i4", "i8"};
+    std::string header = std::string("{'descr': '") + (hostIsLittleEndian() ? '<' : '>') +
+                         kinds[static_cast<uint32_t>(MatrixElementTraits<T>::code)] +
+                         "', 'fortran_order': False, 'shape': (" + std::to_string(matrix.getRows()) + ", " +
+                         std::to_string(matrix.getCols()) + "), }";
+
+    // Pad with spaces and a newline so the payload starts on a 64-byte boundary
+    const bool version2 = header.size() + 11 > 65535;
+    const size_t preambleSize = version2 ? 12 : 10;
+    header.append(63 - (preambleSize + header.size()) % 64, ' ');
+    header.push_back('\n');
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Cannot open file for writing: " + path);
+    }
+    std::string preamble("\x93NUMPY", 6);
+    preamble.push_back(version2 ? 2 : 1);
+    preamble.push_back(0);
+    const size_t length = header.size();
+    for (size_t b = 0; b < (version2 ? 4u : 2u); ++b) preamble.push_back(static_cast<char>((length >> (8 * b)) & 0xFF));
+    writeAll(out, preamble + header, path);
+
+    for (size_t i = 0; i < matrix.getRows(); ++i) {
+        out.write(reinterpret_cast<const char*>(matrix[i].data()),
+                  static_cast<std::streamsize>(matrix.getCols() * sizeof(T)));
+    }
+    out.close();
+    if (!out) {
+        throw std::runtime_error("Failed to write matrix file: " + path);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Format selection by extension
+// ---------------------------------------------------------------------------
+
+namespace matrix_io_detail {
+
+inline std::string extensionOf(const std::string& path) {
+    const size_t dot = path.find_last_of('.');
+    const size_t slash = path.find_last_of("/\\");
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        throw std::invalid_argument("Cannot infer matrix file format without an extension: " + path);
+    }
+    std::string extension = path.substr(dot + 1);
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+    return extension;
+}
+
+}  // namespace matrix_io_detail
+
+template<typename T>
+Matrix<T> loadMatrixFile(const std::string& path, unsigned threads) {
+    const std::string extension = matrix_io_detail::extensionOf(path);
+    if (extension == "lamx" || extension == "bin") return loadMatrixBinary<T>(path);
+    if (extension == "csv") return loadMatrixCSV<T>(path, ',', false, threads);
+    if (extension == "tsv") return loadMatrixCSV<T>(path, '\t', false, threads);
+    if (extension == "mtx") return loadMatrixMarket<T>(path, threads);
+    if (extension == "npy") return loadMatrixNpy<T>(path);
+    throw std::invalid_argument("Unknown matrix file format '." + extension + "': " + path);
+}
+
+template<typename T>
+void saveMatrixFile(const Matrix<T>& matrix, const std::string& path, unsigned threads) {
+    const std::string extension = matrix_io_detail::extensionOf(path);
+    if (extension == "lamx" || extension == "bin") saveMatrixBinary(matrix, path);
+    else if (extension == "csv") saveMatrixCSV(matrix, path, ',', threads);
+    else if (extension == "tsv") saveMatrixCSV(matrix, path, '\t', threads);
+    else if (extension == "mtx") saveMatrixMarket(matrix, path);
+    else if (extension == "npy") saveMatrixNpy(matrix, path);
+    else throw std::invalid_argument("Unknown matrix file format '." + extension + "': " + path);
+}
@@ -0,0 +1,171 @@
+#pragma once
+#include "Matrix.h"
+#include "Checksum.h"
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <thread>
+
+// Binary matrix file format (".lamx")
+//
+//   offset  size  field
+//   0       8     magic "LINALGMX"
+//   8       4     format version
+//   12      4     byte-order tag (0x01020304 as written by the producer)
+//   16      4     element type code (see MatrixElementType)
+//   20      4     element size in bytes
+//   24      4     layout (0 = row-major, 1 = column-major)
+//   28      4     reserved
+//   32      8     rows
+//   40      8     cols
+//   48      8     row stride in elements
+//   56      8     column stride in elements
+//   64      8     payload offset (multiple of 64)
+//   72      8     payload size in bytes
+//   80      8     payload checksum
+//   88..127       reserved, zero
+//
+// The payload starts on a 64-byte boundary so an mmap of the file can be
+// used directly as an aligned T array.
+
+enum class MatrixElementType : uint32_t { Float32 = 1, Float64 = 2, Int32 = 3, Int64 = 4 };
+enum class MatrixLayout : uint32_t { RowMajor = 0, ColumnMajor = 1 };
+
+struct MatrixFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t elementType;
+    uint32_t elementSize;
+    uint32_t layout;
+    uint32_t reserved0;
+    uint64_t rows;
+    uint64_t cols;
+    int64_t rowStride;
+    int64_t colStride;
+    uint64_t dataOffset;
+    uint64_t dataSize;
+    uint64_t checksum;
+    uint8_t reserved[40];
+
+    static constexpr uint32_t CURRENT_VERSION = 1;
+    static constexpr uint32_t BYTE_ORDER_TAG = 0x01020304u;
+    static constexpr uint64_t DATA_ALIGNMENT = 64;
+
+    // Checks magic, version, byte order and stride consistency; throws on mismatch
+    void validate(size_t fileSize) const;
+};
+static_assert(sizeof(MatrixFileHeader) == 128, "MatrixFileHeader must be 128 bytes");
+
+// Maps C++ element types to their on-disk type code
+template<typename T> struct MatrixElementTraits;
+template<> struct MatrixElementTraits<float>   { static constexpr MatrixElementType code = MatrixElementType::Float32; };
+template<> struct MatrixElementTraits<double>  { static constexpr MatrixElementType code = MatrixElementType::Float64; };
+template<> struct MatrixElementTraits<int32_t> { static constexpr MatrixElementType code = MatrixElementType::Int32; };
+template<> struct MatrixElementTraits<int64_t> { static constexpr MatrixElementType code = MatrixElementType::Int64; };
+
+// Write a matrix in the binary format (row-major, dense strides)
+template<typename T>
+void saveMatrixBinary(const Matrix<T>& matrix, const std::string& path);
+
+// Read a binary matrix file into an owning Matrix (bulk read, checksum verified)
+template<typename T>
+Matrix<T> loadMatrixBinary(const std::string& path);
+
+// Read-only, zero-copy view of a binary matrix file. The file is memory
+// mapped and elements are read straight from the page cache, so opening a
+// multi-gigabyte file costs a header read regardless of its size and several
+// processes mapping the same file share its pages. Matrix<T> owns per-row
+// vectors and cannot alias the mapping; use toMatrix() when an owning copy
+// is needed.
+template<typename T = double>
+class MappedMatrix {
+private:
+    const uint8_t* mapping;
+    size_t mappingSize;
+    std::vector<uint8_t> fallback;  // Used where mmap is unavailable
+    const T* base;
+    size_t rows;
+    size_t cols;
+    int64_t rowStride;
+    int64_t colStride;
+    uint64_t storedChecksum;
+
+    void release();
+
+public:
+    MappedMatrix();
+    explicit MappedMatrix(const std::string& path);
+    ~MappedMatrix();
+
+    MappedMatrix(const MappedMatrix&) = delete;
+    MappedMatrix& operator=(const MappedMatrix&) = delete;
+    MappedMatrix(MappedMatrix&& other) noexcept;
+    MappedMatrix& operator=(MappedMatrix&& other) noexcept;
+
+    // Accessors
+    size_t getRows() const { return rows; }
+    size_t getCols() const { return cols; }
+    bool isRowMajor() const { return colStride == 1; }
+    const T* data() const { return base; }
+
+    // Element access
+    const T& operator()(size_t i, size_t j) const;
+
+    // Pointer to row i (row-major files only)
+    const T* row(size_t i) const;
+
+    // Hashes the whole payload; touches every page, so it is opt-in
+    bool verifyChecksum() const;
+
+    // Owning copies
+    Matrix<T> toMatrix() const;
+    Matrix<T> rowRange(size_t begin, size_t end) const;
+
+    // this * B computed directly from the mapping
+    Matrix<T> multiply(const Matrix<T>& B) const;
+};
+
+using MappedMatrixD = MappedMatrix<double>;
+using MappedMatrixF = MappedMatrix<float>;
+
+// Text and interchange formats. Readers load the whole file with one read,
+// split it into line-aligned chunks and parse the chunks on worker threads
+// with std::from_chars, so throughput is bounded by I/O rather than by
+// stream extraction. threads = 0 uses std::thread::hardware_concurrency().
+
+// Delimited text (CSV with ',', TSV with '\t'). Blank lines are skipped;
+// every remaining line must have the same number of fields.
+template<typename T>
+Matrix<T> loadMatrixCSV(const std::string& path, char delimiter = ',', bool skipHeader = false,
+                        unsigned threads = 0);
+template<typename T>
+void saveMatrixCSV(const Matrix<T>& matrix, const std::string& path, char delimiter = ',',
+                   unsigned threads = 0);
+
+// Matrix Market exchange format. Both "array" and "coordinate" files are
+// accepted (real, integer or pattern; general, symmetric or skew-symmetric).
+// There is no sparse matrix type yet, so coordinate files are expanded into a
+// dense Matrix with duplicate entries summed. The writer emits "array" format.
+template<typename T>
+Matrix<T> loadMatrixMarket(const std::string& path, unsigned threads = 0);
+template<typename T>
+void saveMatrixMarket(const Matrix<T>& matrix, const std::string& path);
+
+// NumPy .npy (format versions 1.0 to 3.0; little-endian f4, f8, i4 and i8,
+// C or Fortran order, converted to T on load). 1-D arrays load as a column.
+template<typename T>
+Matrix<T> loadMatrixNpy(const std::string& path);
+template<typename T>
+void saveMatrixNpy(const Matrix<T>& matrix, const std::string& path);
+
+// Pick the format from the file extension: .lamx/.bin (binary), .csv, .tsv,
+// .mtx (Matrix Market) or .npy. threads applies to the text formats.
+template<typename T>
+Matrix<T> loadMatrixFile(const std::string& path, unsigned threads = 0);
+template<typename T>
+void saveMatrixFile(const Matrix<T>& matrix, const std::string& path, unsigned threads = 0);
+
+#include "MatrixIO.cpp"  // Include implementation for template functions
@@ -0,0 +1,713 @@
+#include "OutOfCore.h"
+#include <chrono>
+#include <cstring>
+#include <utility>
+
+// ---------------------------------------------------------------------------
+// TileStore
+// ---------------------------------------------------------------------------
+
+// On-disk header of a tile store (padded to DATA_OFFSET)
+struct TileStoreHeader {
+    char magic[8];  // "LINALGTS"
+    uint32_t version;
+    uint32_t elementType;
+    uint64_t rows;
+    uint64_t cols;
+    uint64_t tileSize;
+};
+
+template<typename T>
+TileStore<T>::TileStore(std::fstream&& stream, const std::string& filePath, size_t r, size_t c, size_t b)
+    : file(std::move(stream)), path(filePath), rows(r), cols(c), tileSize(b) {}
+
+template<typename T>
+std::streamoff TileStore<T>::tileOffset(size_t ti, size_t tj) const {
+    const uint64_t index = static_cast<uint64_t>(ti) * tileCols() + tj;
+    return static_cast<std::streamoff>(DATA_OFFSET + index * tileSize * tileSize * sizeof(T));
+}
+
+template<typename T>
+TileStore<T> TileStore<T>::create(const std::string& path, size_t rows, size_t cols, size_t tileSize) {
+    if (tileSize == 0) {
+        throw std::invalid_argument("Tile size must be positive");
+    }
+
+    std::fstream stream(path, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!stream) {
+        throw std::runtime_error("Cannot create tile store: " + path);
+    }
+
+    TileStoreHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, "LINALGTS", 8);
+    header.version = 1;
+    header.elementType = static_cast<uint32_t>(MatrixElementTraits<T>::code);
+    header.rows = rows;
+    header.cols = cols;
+    header.tileSize = tileSize;
+    stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    // Extend to full size; the filesystem keeps the untouched tiles sparse (zero)
+    TileStore store(std::move(stream), path, rows, cols, tileSize);
+    const std::streamoff end = store.tileOffset(store.tileRows(), 0);
+    store.file.seekp(end - 1);
+    store.file.put('\0');
+    store.file.flush();
+    if (!store.file) {
+        throw std::runtime_error("Cannot allocate tile store: " + path);
+    }
+    return store;
+}
+
+template<typename T>
+TileStore<T> TileStore<T>::open(const std::string& path) {
+    std::fstream stream(path, std::ios::in | std::ios::out | std::ios::binary);
+    if (!stream) {
+        throw std::runtime_error("Cannot open tile store: " + path);
+    }
+
+    TileStoreHeader header;
+    if (!stream.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, "LINALGTS", 8) != 0) {
+        throw std::runtime_error("Not a tile store: " + path);
+    }
+    if (header.version != 1) {
+        throw std::runtime_error("Unsupported tile store version " + std::to_string(header.version));
+    }
+    if (header.elementType != static_cast<uint32_t>(MatrixElementTraits<T>::code) || header.tileSize == 0) {
+        throw std::invalid_argument("Tile store element type does not match the requested matrix type");
+    }
+    return TileStore(std::move(stream), path, header.rows, header.cols, header.tileSize);
+}
+
+template<typename T>
+template<typename Source>
+TileStore<T> TileStore<T>::fromMatrix(const Source& source, const std::string& path, size_t tileSize) {
+    TileStore store = create(path, source.getRows(), source.getCols(), tileSize);
+    Matrix<T> tile;
+    for (size_t ti = 0; ti < store.tileRows(); ++ti) {
+        for (size_t tj = 0; tj < store.tileCols(); ++tj) {
+            const size_t h = store.tileHeight(ti);
+            const size_t w = store.tileWidth(tj);
+            if (tile.getRows() != h || tile.getCols() != w) tile = Matrix<T>(h, w);
+            for (size_t i = 0; i < h; ++i) {
+                std::vector<T>& row = tile[i];
+                for (size_t j = 0; j < w; ++j) row[j] = source(ti * tileSize + i, tj * tileSize + j);
+            }
+            store.writeTile(ti, tj, tile);
+        }
+    }
+    store.flush();
+    return store;
+}
+
+template<typename T>
+void TileStore<T>::readTile(size_t ti, size_t tj, Matrix<T>& tile) const {
+    if (ti >= tileRows() || tj >= tileCols()) {
+        throw std::out_of_range("Tile index out of range");
+    }
+
+    const size_t h = tileHeight(ti);
+    const size_t w = tileWidth(tj);
+    if (tile.getRows() != h || tile.getCols() != w) tile = Matrix<T>(h, w);
+
+    file.seekg(tileOffset(ti, tj));
+    for (size_t i = 0; i < h; ++i) {
+        file.read(reinterpret_cast<char*>(tile[i].data()), static_cast<std::streamsize>(w * sizeof(T)));
+        if (w < tileSize) file.seekg(static_cast<std::streamoff>((tileSize - w) * sizeof(T)), std::ios::cur);
+    }
+    if (!file) {
+        throw std::runtime_error("Failed to read tile from " + path);
+    }
+}
+
+template<typename T>
+void TileStore<T>::writeTile(size_t ti, size_t tj, const Matrix<T>& tile) {
+    if (ti >= tileRows() || tj >= tileCols()) {
+        throw std::out_of_range("Tile index out of range");
+    }
+
+    const size_t h = tileHeight(ti);
+    const size_t w = tileWidth(tj);
+    if (tile.getRows() != h || tile.getCols() != w) {
+        throw std::invalid_argument("Tile dimensions do not match the store");
+    }
+
+    file.seekp(tileOffset(ti, tj));
+    for (size_t i = 0; i < h; ++i) {
+        file.write(reinterpret_cast<const char*>(tile[i].data()), static_cast<std::streamsize>(w * sizeof(T)));
+        if (w < tileSize) file.seekp(static_cast<std::streamoff>((tileSize - w) * sizeof(T)), std::ios::cur);
+    }
+    if (!file) {
+        throw std::runtime_error("Failed to write tile to " + path);
+    }
+}
+
+template<typename T>
+Matrix<T> TileStore<T>::toMatrix() const {
+    Matrix<T> result(rows, cols);
+    Matrix<T> tile;
+    for (size_t ti = 0; ti < tileRows(); ++ti) {
+        for (size_t tj = 0; tj < tileCols(); ++tj) {
+            readTile(ti, tj, tile);
+            for (size_t i = 0; i < tile.getRows(); ++i) {
+                std::copy(tile[i].begin(), tile[i].end(), result[ti * tileSize + i].begin() + tj * tileSize);
+            }
+        }
+    }
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+// Stats and I/O worker
+// ---------------------------------------------------------------------------
+
+inline void OutOfCoreStats::print(std::ostream& os) const {
+    const double mb = 1024.0 * 1024.0;
+    const std::ios::fmtflags flags = os.flags();
+    const std::streamsize precision = os.precision();
+    os << std::fixed << std::setprecision(2)
+       << "Tiles: " << tilesDone << "/" << tilesTotal << " (" << 100.0 * fractionDone() << "%)\n"
+       << "Elapsed: " << elapsedSeconds << " s, compute " << computeSeconds << " s, stalled on I/O "
+       << stallSeconds << " s\n"
+       << "I/O: read " << bytesRead / mb << " MB in " << readSeconds << " s, wrote "
+       << bytesWritten / mb << " MB in " << writeSeconds << " s\n";
+    os.flags(flags);
+    os.precision(precision);
+}
+
+template<typename T>
+TileIOWorker<T>::TileIOWorker()
+    : stopping(false), readNanos(0), writeNanos(0), bytesRead(0), bytesWritten(0) {
+    worker = std::thread([this]() { run(); });
+}
+
+template<typename T>
+TileIOWorker<T>::~TileIOWorker() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    ready.notify_one();
+    worker.join();
+}
+
+template<typename T>
+void TileIOWorker<T>::run() {
+    for (;;) {
+        std::packaged_task<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            ready.wait(lock, [this]() { return stopping || !queue.empty(); });
+            if (queue.empty()) return;  // Stopping with nothing left to do
+            job = std::move(queue.front());
+            queue.pop_front();
+        }
+        job();  // Exceptions are delivered through the job's future
+    }
+}
+
+template<typename T>
+std::future<void> TileIOWorker<T>::submit(std::function<void()> job) {
+    std::packaged_task<void()> task(std::move(job));
+    std::future<void> result = task.get_future();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back(std::move(task));
+    }
+    ready.notify_one();
+    return result;
+}
+
+template<typename T>
+std::future<void> TileIOWorker<T>::read(const TileStore<T>& store, size_t ti, size_t tj, Matrix<T>& tile) {
+    return submit([this, &store, ti, tj, &tile]() {
+        LINALG_PROFILE("TileIO::read", tile.getRows(), tile.getCols(), 0.0,
+                       double(tile.getRows() * tile.getCols() * sizeof(T)));
+        const auto start = std::chrono::steady_clock::now();
+        store.readTile(ti, tj, tile);
+        readNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         std::chrono::steady_clock::now() - start).count();
+        bytesRead += tile.getRows() * tile.getCols() * sizeof(T);
+    });
+}
+
+template<typename T>
+std::future<void> TileIOWorker<T>::write(TileStore<T>& store, size_t ti, size_t tj, const Matrix<T>& tile) {
+    return submit([this, &store, ti, tj, &tile]() {
+        LINALG_PROFILE("TileIO::write", tile.getRows(), tile.getCols(), 0.0,
+                       double(tile.getRows() * tile.getCols() * sizeof(T)));
+        const auto start = std::chrono::steady_clock::now();
+        store.writeTile(ti, tj, tile);
+        writeNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::steady_clock::now() - start).count();
+        bytesWritten += tile.getRows() * tile.getCols() * sizeof(T);
+    });
+}
+
+template<typename T>
+void TileIOWorker<T>::collect(OutOfCoreStats& stats) const {
+    stats.readSeconds = readNanos.load() * 1e-9;
+    stats.writeSeconds = writeNanos.load() * 1e-9;
+    stats.bytesRead = bytesRead.load();
+    stats.bytesWritten = bytesWritten.load();
+}
+
+// ---------------------------------------------------------------------------
+// Pipelining helpers
+// ---------------------------------------------------------------------------
+
+namespace out_of_core_detail {
+
+using Clock = std::chrono::steady_clock;
+
+inline double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Shared bookkeeping of one out-of-core run
+template<typename T>
+struct Run {
+    TileIOWorker<T> io;
+    OutOfCoreStats stats;
+    const OutOfCoreOptions& options;
+    Clock::time_point start;
+
+    Run(const OutOfCoreOptions& opts, size_t totalTiles) : options(opts), start(Clock::now()) {
+        stats.tilesTotal = totalTiles;
+    }
+
+    // Times a tile computation and reports progress
+    template<typename Fn>
+    void compute(Fn fn) {
+        const Clock::time_point begin = Clock::now();
+        fn();
+        stats.computeSeconds += secondsSince(begin);
+        ++stats.tilesDone;
+        if (options.progress) {
+            io.collect(stats);
+            stats.elapsedSeconds = secondsSince(start);
+            options.progress(stats);
+        }
+    }
+
+    void wait(std::future<void>& pending) {
+        if (!pending.valid()) return;
+        const Clock::time_point begin = Clock::now();
+        pending.get();
+        stats.stallSeconds += secondsSince(begin);
+    }
+
+    OutOfCoreStats finish() {
+        io.collect(stats);
+        stats.elapsedSeconds = secondsSince(start);
+        return stats;
+    }
+};
+
+// Reads a fixed sequence of tiles with `depth` reads in flight. The buffer
+// returned by next() stays valid until the following call to next().
+template<typename T>
+class ReadAhead {
+private:
+    Run<T>& run;
+    const TileStore<T>& store;
+    std::vector<std::pair<size_t, size_t>> order;
+    std::vector<Matrix<T>> buffers;
+    std::vector<std::future<void>> pending;
+    size_t issued;
+    size_t taken;
+
+    void issue() {
+        if (issued == order.size()) return;
+        const size_t slot = issued % buffers.size();
+        pending[slot] = run.io.read(store, order[issued].first, order[issued].second, buffers[slot]);
+        ++issued;
+    }
+
+public:
+    ReadAhead(Run<T>& r, const TileStore<T>& s, std::vector<std::pair<size_t, size_t>> tiles)
+        : run(r), store(s), order(std::move(tiles)), buffers(std::max<size_t>(1, r.options.readAhead) + 1),
+          pending(buffers.size()), issued(0), taken(0) {
+        for (size_t d = 0; d + 1 < buffers.size(); ++d) issue();
+    }
+
+    ~ReadAhead() {
+        // Buffers must outlive the reads that target them
+        for (std::future<void>& read : pending) {
+            if (read.valid()) read.wait();
+        }
+    }
+
+    Matrix<T>& next() {
+        const size_t slot = taken % buffers.size();
+        run.wait(pending[slot]);
+        ++taken;
+        issue();
+        return buffers[slot];
+    }
+};
+
+// Takes finished tiles by swap and writes them in the background, keeping
+// at most two writes in flight
+template<typename T>
+class WriteBehind {
+private:
+    Run<T>& run;
+    TileStore<T>& store;
+    Matrix<T> buffers[2];
+    std::future<void> pending[2];
+    size_t count;
+
+public:
+    WriteBehind(Run<T>& r, TileStore<T>& s) : run(r), store(s), count(0) {}
+
+    ~WriteBehind() {
+        for (std::future<void>& write : pending) {
+            if (write.valid()) write.wait();
+        }
+    }
+
+    // tile receives an unspecified buffer in exchange
+    void write(size_t ti, size_t tj, Matrix<T>& tile) {
+        const size_t slot = count++ % 2;
+        run.wait(pending[slot]);
+        std::swap(buffers[slot], tile);
+        pending[slot] = run.io.write(store, ti, tj, buffers[slot]);
+    }
+
+    void finish() {
+        for (std::future<void>& write : pending) run.wait(write);
+        store.flush();
+    }
+};
+
+template<typename T>
+void requireBudget(const OutOfCoreOptions& options, size_t tileSize, size_t tilesNeeded) {
+    const size_t tileBytes = tileSize * tileSize * sizeof(T);
+    if (tilesNeeded * tileBytes > options.memoryBudget) {
+        throw std::invalid_argument("Memory budget of " + std::to_string(options.memoryBudget) +
+                                    " bytes is too small: this factorization needs " +
+                                    std::to_string(tilesNeeded) + " tiles of " + std::to_string(tileBytes) +
+                                    " bytes in memory; use smaller tiles");
+    }
+}
+
+// C += alpha * A * B on whole tiles
+template<typename T>
+void tileGemm(const T& alpha, const Matrix<T>& A, const Matrix<T>& B, Matrix<T>& C) {
+    Matrix<T>::gemm(A.getRows(), B.getCols(), A.getCols(), alpha, A, 0, 0, B, 0, 0, C, 0, 0);
+}
+
+// Row r (counted from the top of the matrix) of a tile column held as
+// tiles[r / tileSize]
+template<typename T>
+std::vector<T>& tileColumnRow(std::vector<Matrix<T>>& tiles, size_t tileSize, size_t r) {
+    return tiles[r / tileSize][r % tileSize];
+}
+
+// Partially pivoted in-place LU of the tall panel tiles[k..) (unit L and U
+// packed), pivoting over every row of the panel. pivots[r] receives the row
+// interchanged with row r, as GETRF's ipiv.
+template<typename T>
+void panelLU(std::vector<Matrix<T>>& tiles, size_t k, size_t tileSize, std::vector<size_t>& pivots) {
+    const size_t n = tiles.size();
+    const size_t width = tiles[k].getCols();
+    const size_t first = k * tileSize;
+    for (size_t p = 0; p < width; ++p) {
+        const size_t r = first + p;
+        size_t pivotRow = r;
+        T pivotAbs = std::abs(tileColumnRow(tiles, tileSize, r)[p]);
+        for (size_t t = k; t < n; ++t) {
+            const Matrix<T>& tile = tiles[t];
+            for (size_t i = (t == k ? p + 1 : 0); i < tile.getRows(); ++i) {
+                const T candidate = std::abs(tile[i][p]);
+                if (candidate > pivotAbs) {
+                    pivotAbs = candidate;
+                    pivotRow = t * tileSize + i;
+                }
+            }
+        }
+        pivots[r] = pivotRow;
+        if (pivotAbs == T(0)) continue;  // Singular; the column is already eliminated
+        if (pivotRow != r) std::swap(tileColumnRow(tiles, tileSize, r), tileColumnRow(tiles, tileSize, pivotRow));
+
+        const std::vector<T>& pivot = tileColumnRow(tiles, tileSize, r);
+        const T inv_pivot = T(1) / pivot[p];
+        for (size_t t = k; t < n; ++t) {
+            Matrix<T>& tile = tiles[t];
+            for (size_t i = (t == k ? p + 1 : 0); i < tile.getRows(); ++i) {
+                std::vector<T>& row = tile[i];
+                const T factor = row[p] * inv_pivot;
+                row[p] = factor;
+                if (factor == T(0)) continue;
+                for (size_t j = p + 1; j < width; ++j) row[j] -= factor * pivot[j];
+            }
+        }
+    }
+}
+
+// Applies the interchanges pivots[begin..end) in order to a tile column
+template<typename T>
+void swapRows(std::vector<Matrix<T>>& tiles, size_t tileSize, const std::vector<size_t>& pivots,
+              size_t begin, size_t end) {
+    for (size_t r = begin; r < end; ++r) {
+        if (pivots[r] != r) std::swap(tileColumnRow(tiles, tileSize, r), tileColumnRow(tiles, tileSize, pivots[r]));
+    }
+}
+
+// X = L^{-1} X with L the unit lower triangle of LU (forward substitution)
+template<typename T>
+void tileSolveUnitLower(const Matrix<T>& LU, Matrix<T>& X) {
+    const size_t n = LU.getRows();
+    for (size_t i = 1; i < n; ++i) {
+        const std::vector<T>& l = LU[i];
+        std::vector<T>& xi = X[i];
+        for (size_t k = 0; k < i; ++k) {
+            const T factor = l[k];
+            if (factor == T(0)) continue;
+            const std::vector<T>& xk = X[k];
+            for (size_t j = 0; j < xi.size(); ++j) xi[j] -= factor * xk[j];
+        }
+    }
+}
+
+// X = X L^{-T} with L lower triangular; each row solves L x^T = a^T
+template<typename T>
+void tileSolveLowerTransposeRight(const Matrix<T>& L, Matrix<T>& X) {
+    const size_t n = L.getRows();
+    for (size_t r = 0; r < X.getRows(); ++r) {
+        std::vector<T>& x = X[r];
+        for (size_t j = 0; j < n; ++j) {
+            const std::vector<T>& l = L[j];
+            T sum = x[j];
+            for (size_t p = 0; p < j; ++p) sum -= l[p] * x[p];
+            x[j] = sum / l[j];
+        }
+    }
+}
+
+}  // namespace out_of_core_detail
+
+// ---------------------------------------------------------------------------
+// Algorithms
+// ---------------------------------------------------------------------------
+
+template<typename T>
+OutOfCoreStats outOfCoreMultiply(const TileStore<T>& A, const TileStore<T>& B, TileStore<T>& C,
+                                 const OutOfCoreOptions& options) {
+    using namespace out_of_core_detail;
+    if (A.getCols() != B.getRows() || C.getRows() != A.getRows() || C.getCols() != B.getCols()) {
+        throw std::invalid_argument("Invalid matrix dimensions for multiplication");
+    }
+    if (A.getTileSize() != B.getTileSize() || A.getTileSize() != C.getTileSize()) {
+        throw std::invalid_argument("Tile stores must use the same tile size");
+    }
+
+    const size_t M = C.tileRows();
+    const size_t N = C.tileCols();
+    const size_t K = A.tileCols();
+    const size_t depth = std::max<size_t>(1, options.readAhead);
+
+    // B stream and C write-behind buffers plus the accumulator are always needed
+    const size_t streamingTiles = 2 * (depth + 1) + 3;
+    requireBudget<T>(options, A.getTileSize(), streamingTiles);
+    const bool cachePanel = (K + depth + 4) * A.getTileSize() * A.getTileSize() * sizeof(T) <= options.memoryBudget;
+
+    Run<T> run(options, M * N * K);
+    WriteBehind<T> writer(run, C);
+    std::vector<Matrix<T>> panel(cachePanel ? K : 0);
+    Matrix<T> accumulator;
+
+    for (size_t i = 0; i < M; ++i) {
+        std::vector<std::pair<size_t, size_t>> aOrder, bOrder;
+        for (size_t j = 0; j < N; ++j) {
+            for (size_t k = 0; k < K; ++k) {
+                bOrder.push_back({k, j});
+                if (!cachePanel) aOrder.push_back({i, k});
+            }
+        }
+        if (cachePanel) {
+            std::vector<std::pair<size_t, size_t>> panelOrder;
+            for (size_t k = 0; k < K; ++k) panelOrder.push_back({i, k});
+            ReadAhead<T> panelReads(run, A, panelOrder);
+            for (size_t k = 0; k < K; ++k) std::swap(panel[k], panelReads.next());
+        }
+
+        ReadAhead<T> aReads(run, A, aOrder);
+        ReadAhead<T> bReads(run, B, bOrder);
+        for (size_t j = 0; j < N; ++j) {
+            accumulator = Matrix<T>(C.tileHeight(i), C.tileWidth(j));
+            for (size_t k = 0; k < K; ++k) {
+                const Matrix<T>& a = cachePanel ? panel[k] : aReads.next();
+                const Matrix<T>& b = bReads.next();
+                run.compute([&]() { tileGemm(T(1), a, b, accumulator); });
+            }
+            writer.write(i, j, accumulator);
+        }
+    }
+    writer.finish();
+    return run.finish();
+}
+
+template<typename T>
+OutOfCoreStats outOfCoreCholesky(TileStore<T>& A, const OutOfCoreOptions& options) {
+    using namespace out_of_core_detail;
+    if (A.getRows() != A.getCols()) {
+        throw std::invalid_argument("Cholesky factorization requires a square matrix");
+    }
+
+    const size_t n = A.tileRows();
+    const size_t depth = std::max<size_t>(1, options.readAhead);
+    // Panel column + its transpose in use + read-ahead ring + write-behind
+    requireBudget<T>(options, A.getTileSize(), n + 1 + (depth + 1) + 2);
+
+    // Per step k: factor 1 diagonal tile, solve n-k-1 panel tiles, update the trailing lower triangle
+    size_t total = 0;
+    for (size_t k = 0; k < n; ++k) total += (n - k) + (n - k - 1) * (n - k) / 2;
+
+    Run<T> run(options, total);
+    WriteBehind<T> writer(run, A);
+    std::vector<Matrix<T>> panel(n);
+    Matrix<T> transposed;
+
+    for (size_t k = 0; k < n; ++k) {
+        std::vector<std::pair<size_t, size_t>> panelOrder;
+        for (size_t i = k; i < n; ++i) panelOrder.push_back({i, k});
+        // The panel ring is released before the trailing ring is opened
+        {
+            ReadAhead<T> panelReads(run, A, panelOrder);
+
+            Matrix<T>& diagonal = panelReads.next();
+            run.compute([&]() {
+                CholeskyFactorization<T> chol(diagonal);
+                if (!chol.isPositiveDefinite()) {
+                    throw std::runtime_error("Matrix is not positive definite");
+                }
+                panel[k] = chol.lower();
+                diagonal = panel[k];
+            });
+            writer.write(k, k, diagonal);
+
+            for (size_t i = k + 1; i < n; ++i) {
+                Matrix<T>& tile = panelReads.next();
+                run.compute([&]() {
+                    tileSolveLowerTransposeRight(panel[k], tile);
+                    panel[i] = tile;
+                });
+                writer.write(i, k, tile);
+            }
+        }
+
+        // Trailing update A(i, j) -= L(i, k) * L(j, k)^T for k < j <= i. The
+        // reads are issued after this step's panel writes, so the FIFO I/O
+        // thread orders them correctly.
+        std::vector<std::pair<size_t, size_t>> trailingOrder;
+        for (size_t j = k + 1; j < n; ++j) {
+            for (size_t i = j; i < n; ++i) trailingOrder.push_back({i, j});
+        }
+        ReadAhead<T> trailingReads(run, A, trailingOrder);
+        for (size_t j = k + 1; j < n; ++j) {
+            transposed = panel[j].transpose();
+            for (size_t i = j; i < n; ++i) {
+                Matrix<T>& tile = trailingReads.next();
+                run.compute([&]() { tileGemm(T(-1), panel[i], transposed, tile); });
+                writer.write(i, j, tile);
+            }
+        }
+        panel[k] = Matrix<T>();
+    }
+    writer.finish();
+    return run.finish();
+}
+
+template<typename T>
+OutOfCoreStats outOfCoreLU(TileStore<T>& A, std::vector<size_t>& permutation, const OutOfCoreOptions& options) {
+    using namespace out_of_core_detail;
+    if (A.getRows() != A.getCols()) {
+        throw std::invalid_argument("LU factorization requires a square matrix");
+    }
+
+    const size_t n = A.tileRows();
+    const size_t b = A.getTileSize();
+    const size_t earlierColumns = n > 0 ? n - 1 : 0;
+    const size_t depth = std::max<size_t>(1, options.readAhead);
+    // Column panel + trailing column + read-ahead ring + write-behind
+    requireBudget<T>(options, b, 2 * n + 1 + (depth + 1) + 2);
+
+    // Per step k: factor the panel, then per trailing column one interchange
+    // and row solve and n-k-1 updates; finally one interchange per earlier L column
+    size_t total = 0;
+    for (size_t k = 0; k < n; ++k) total += 1 + (n - k - 1) + (n - k - 1) * (n - k - 1);
+    total += earlierColumns;
+
+    Run<T> run(options, total);
+    WriteBehind<T> writer(run, A);
+    std::vector<Matrix<T>> columnPanel(n), column(n);
+    std::vector<size_t> pivots(A.getRows());
+    Matrix<T> finished;
+
+    for (size_t k = 0; k < n; ++k) {
+        std::vector<std::pair<size_t, size_t>> panelOrder;
+        for (size_t i = k; i < n; ++i) panelOrder.push_back({i, k});
+        {
+            ReadAhead<T> panelReads(run, A, panelOrder);
+            for (size_t i = k; i < n; ++i) std::swap(columnPanel[i], panelReads.next());
+        }
+        run.compute([&]() { panelLU(columnPanel, k, b, pivots); });
+        for (size_t i = k; i < n; ++i) {
+            finished = columnPanel[i];
+            writer.write(i, k, finished);
+        }
+
+        // Per trailing column j: apply this step's interchanges, solve
+        // U(k, j) = L(k, k)^{-1} A(k, j), then A(i, j) -= L(i, k) * U(k, j).
+        // The interchanges can move rows between any two tiles of the column,
+        // so the whole column is read before any of it is written.
+        const size_t swapEnd = k * b + A.tileWidth(k);
+        std::vector<std::pair<size_t, size_t>> trailingOrder;
+        for (size_t j = k + 1; j < n; ++j) {
+            for (size_t i = k; i < n; ++i) trailingOrder.push_back({i, j});
+        }
+        ReadAhead<T> trailingReads(run, A, trailingOrder);
+        for (size_t j = k + 1; j < n; ++j) {
+            for (size_t i = k; i < n; ++i) std::swap(column[i], trailingReads.next());
+            run.compute([&]() {
+                swapRows(column, b, pivots, k * b, swapEnd);
+                tileSolveUnitLower(columnPanel[k], column[k]);
+            });
+            for (size_t i = k + 1; i < n; ++i) {
+                run.compute([&]() { tileGemm(T(-1), columnPanel[i], column[k], column[i]); });
+            }
+            for (size_t i = k; i < n; ++i) writer.write(i, j, column[i]);
+        }
+    }
+    columnPanel.clear();
+
+    // The L tiles of column j still have their rows in the order of step j;
+    // bring them into the final order (LASWP), skipping untouched columns
+    std::vector<size_t> swapped;
+    for (size_t j = 0; j < earlierColumns; ++j) {
+        bool any = false;
+        for (size_t r = (j + 1) * b; r < A.getRows() && !any; ++r) any = pivots[r] != r;
+        if (any) swapped.push_back(j);
+    }
+    std::vector<std::pair<size_t, size_t>> lowerOrder;
+    for (size_t j : swapped) {
+        for (size_t i = j + 1; i < n; ++i) lowerOrder.push_back({i, j});
+    }
+    run.stats.tilesTotal -= earlierColumns - swapped.size();
+    ReadAhead<T> lowerReads(run, A, lowerOrder);
+    for (size_t j : swapped) {
+        for (size_t i = j + 1; i < n; ++i) std::swap(column[i], lowerReads.next());
+        run.compute([&]() { swapRows(column, b, pivots, (j + 1) * b, A.getRows()); });
+        for (size_t i = j + 1; i < n; ++i) writer.write(i, j, column[i]);
+    }
+    writer.finish();
+
+    permutation.resize(A.getRows());
+    for (size_t i = 0; i < permutation.size(); ++i) permutation[i] = i;
+    for (size_t r = 0; r < permutation.size(); ++r) std::swap(permutation[r], permutation[pivots[r]]);
+    return run.finish();
+}
@@ -0,0 +1,159 @@
+#pragma once
+#include "Matrix.h"
+#include "MatrixIO.h"
+#include <string>
+#include <vector>
+#include <deque>
+#include <fstream>
+#include <future>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <iostream>
+
+// Out-of-core (larger than RAM) matrix storage and algorithms.
+//
+// A TileStore keeps an N x M matrix on disk as square tiles, each tile stored
+// contiguously, so any tile is one sequential read. The out-of-core GEMM,
+// LU and Cholesky below keep only a bounded number of tiles in memory and
+// run all disk traffic on a background I/O thread: the tiles needed next are
+// read ahead while the current tile is being computed, and finished tiles
+// are written behind.
+
+// Tile file on local disk. Edge tiles are stored padded to the full tile
+// size so every tile has the same offset arithmetic. Not thread-safe; the
+// out-of-core routines issue all reads and writes from their single I/O
+// thread.
+template<typename T = double>
+class TileStore {
+private:
+    mutable std::fstream file;
+    std::string path;
+    size_t rows;
+    size_t cols;
+    size_t tileSize;
+
+    static constexpr uint64_t DATA_OFFSET = 4096;  // Page-aligned first tile
+
+    TileStore(std::fstream&& stream, const std::string& filePath, size_t r, size_t c, size_t b);
+    std::streamoff tileOffset(size_t ti, size_t tj) const;
+
+public:
+    TileStore(TileStore&&) = default;
+    TileStore& operator=(TileStore&&) = default;
+
+    // Create (or truncate) a zero-filled store / open an existing one
+    static TileStore create(const std::string& path, size_t rows, size_t cols, size_t tileSize);
+    static TileStore open(const std::string& path);
+
+    // Copy any matrix-like source with getRows/getCols/operator()(i, j) into a
+    // new store, e.g. a Matrix or a MappedMatrix larger than memory
+    template<typename Source>
+    static TileStore fromMatrix(const Source& source, const std::string& path, size_t tileSize);
+
+    // Accessors
+    const std::string& getPath() const { return path; }
+    size_t getRows() const { return rows; }
+    size_t getCols() const { return cols; }
+    size_t getTileSize() const { return tileSize; }
+    size_t tileRows() const { return (rows + tileSize - 1) / tileSize; }
+    size_t tileCols() const { return (cols + tileSize - 1) / tileSize; }
+    size_t tileHeight(size_t ti) const { return std::min(tileSize, rows - ti * tileSize); }
+    size_t tileWidth(size_t tj) const { return std::min(tileSize, cols - tj * tileSize); }
+
+    // Tile I/O; readTile resizes the destination to the tile's extent
+    void readTile(size_t ti, size_t tj, Matrix<T>& tile) const;
+    void writeTile(size_t ti, size_t tj, const Matrix<T>& tile);
+    void flush() { file.flush(); }
+
+    // Whole matrix (only for stores that fit in memory)
+    Matrix<T> toMatrix() const;
+};
+
+// Timing and progress of an out-of-core run. I/O times are measured on the
+// I/O thread; stallSeconds is time the compute thread spent waiting for it,
+// so stallSeconds close to zero means the I/O was fully hidden.
+struct OutOfCoreStats {
+    size_t tilesDone = 0;
+    size_t tilesTotal = 0;
+    uint64_t bytesRead = 0;
+    uint64_t bytesWritten = 0;
+    double readSeconds = 0.0;
+    double writeSeconds = 0.0;
+    double computeSeconds = 0.0;
+    double stallSeconds = 0.0;
+    double elapsedSeconds = 0.0;
+
+    double fractionDone() const { return tilesTotal ? double(tilesDone) / double(tilesTotal) : 1.0; }
+    void print(std::ostream& os = std::cout) const;
+};
+
+struct OutOfCoreOptions {
+    size_t memoryBudget = size_t(1) << 30;  // Bytes available for tile buffers
+    size_t readAhead = 2;                   // Tiles read ahead of the compute thread
+    std::function<void(const OutOfCoreStats&)> progress;  // Called after every tile operation
+};
+
+// Single background thread that executes tile reads and writes in FIFO
+// order. FIFO order is what makes read-after-write on the same tile safe: a
+// read submitted after a write of that tile observes the written data.
+template<typename T = double>
+class TileIOWorker {
+private:
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<std::packaged_task<void()>> queue;
+    bool stopping;
+
+    std::atomic<uint64_t> readNanos;
+    std::atomic<uint64_t> writeNanos;
+    std::atomic<uint64_t> bytesRead;
+    std::atomic<uint64_t> bytesWritten;
+
+    std::future<void> submit(std::function<void()> job);
+    void run();
+
+public:
+    TileIOWorker();
+    ~TileIOWorker();
+    TileIOWorker(const TileIOWorker&) = delete;
+    TileIOWorker& operator=(const TileIOWorker&) = delete;
+
+    std::future<void> read(const TileStore<T>& store, size_t ti, size_t tj, Matrix<T>& tile);
+    std::future<void> write(TileStore<T>& store, size_t ti, size_t tj, const Matrix<T>& tile);
+
+    // Copies the I/O counters into stats
+    void collect(OutOfCoreStats& stats) const;
+};
+
+// C = A * B. Tile sizes must match; C must already have the product's shape
+// (see TileStore::create). A row panel of A is kept in memory when the
+// budget allows, otherwise A tiles are streamed alongside B.
+template<typename T>
+OutOfCoreStats outOfCoreMultiply(const TileStore<T>& A, const TileStore<T>& B, TileStore<T>& C,
+                                 const OutOfCoreOptions& options = OutOfCoreOptions());
+
+// In-place right-looking Cholesky, A = L * L^T. Only tiles on and below the
+// diagonal are read or written; they hold L on return. Needs one tile column
+// in memory.
+template<typename T>
+OutOfCoreStats outOfCoreCholesky(TileStore<T>& A, const OutOfCoreOptions& options = OutOfCoreOptions());
+
+// In-place right-looking LU with partial pivoting, P * A = L * U, L unit
+// lower, packed like GETRF. Each tile column is factored as one tall panel,
+// pivoting over all of its rows; the interchanges reach the trailing tiles
+// in the update pass that reads them anyway, and the L tiles of earlier
+// columns in one final pass. Row i of P * A is row permutation[i] of A, as
+// in LUFactorization. A singular matrix leaves a zero on U's diagonal.
+// Needs two tile columns in memory.
+template<typename T>
+OutOfCoreStats outOfCoreLU(TileStore<T>& A, std::vector<size_t>& permutation,
+                           const OutOfCoreOptions& options = OutOfCoreOptions());
+
+// Typedef for common types
+using TileStoreD = TileStore<double>;
+
+#include "OutOfCore.cpp"  // Include implementation for template classes
@@ -0,0 +1,226 @@
+#include "ParallelFor.h"
+
+namespace parallel_detail {
+
+// Elements per chunk: enough to amortize taking it, few enough that a loop
+// at the parallel threshold still has a chunk or more per thread
+constexpr size_t CHUNK_ELEMENTS = 16384;
+
+// A run of chunks [front, back) packed into one word, so that the owner
+// taking the front and a thief taking the back half are single CAS updates
+inline uint64_t pack(size_t front, size_t back) { return (static_cast<uint64_t>(front) << 32) | back; }
+inline size_t front(uint64_t run) { return static_cast<size_t>(run >> 32); }
+inline size_t back(uint64_t run) { return static_cast<size_t>(run & 0xffffffffu); }
+
+// The loop in flight, on the stack of the thread that started it
+struct Loop {
+    const std::function<void(size_t)>* chunk;
+    size_t participants;
+    std::unique_ptr<std::atomic<uint64_t>[]> runs;  // One per participant
+    std::atomic<bool> failed{false};
+    std::mutex errorMutex;
+    std::exception_ptr error;
+};
+
+inline bool takeFront(std::atomic<uint64_t>& run, size_t& chunk) {
+    uint64_t value = run.load();
+    while (front(value) < back(value)) {
+        if (run.compare_exchange_weak(value, pack(front(value) + 1, back(value)))) {
+            chunk = front(value);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Moves the back half of `victim` (all of it when one chunk is left) into
+// `own`, which is empty and therefore not written by anyone else
+inline bool stealHalf(std::atomic<uint64_t>& victim, std::atomic<uint64_t>& own) {
+    uint64_t value = victim.load();
+    while (front(value) < back(value)) {
+        const size_t middle = front(value) + (back(value) - front(value)) / 2;
+        if (victim.compare_exchange_weak(value, pack(front(value), middle))) {
+            own.store(pack(middle, back(value)));
+            return true;
+        }
+    }
+    return false;
+}
+
+// Runs chunks until the own run is empty and a pass over the others found
+// nothing to steal. A half stolen by a third thread during that pass may be
+// missed; that thread runs it, so this only costs some balance.
+inline void participate(Loop& loop, size_t self) {
+    std::atomic<uint64_t>& own = loop.runs[self];
+    size_t chunk;
+    while (!loop.failed.load(std::memory_order_relaxed)) {
+        if (!takeFront(own, chunk)) {
+            bool stolen = false;
+            for (size_t offset = 1; offset < loop.participants && !stolen; ++offset) {
+                stolen = stealHalf(loop.runs[(self + offset) % loop.participants], own);
+            }
+            if (!stolen) return;
+            continue;
+        }
+        try {
+            (*loop.chunk)(chunk);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(loop.errorMutex);
+            if (!loop.error) loop.error = std::current_exception();
+            loop.failed.store(true);
+            return;
+        }
+    }
+}
+
+// Set on helper threads, and on the calling thread while it runs its share
+// of a loop, so that a nested loop runs serially instead of waiting for
+// helpers that are busy with the outer one
+inline thread_local bool insideLoop = false;
+
+class LoopRuntime {
+public:
+    static LoopRuntime& instance() {
+        static LoopRuntime runtime;
+        return runtime;
+    }
+
+    ~LoopRuntime() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& helper : helpers) helper.join();
+    }
+
+    // Runs chunks [0, chunks) on `threads` threads, the caller included;
+    // false, without running anything, when the loop has to run serially
+    bool run(size_t chunks, unsigned threads, const std::function<void(size_t)>& chunk) {
+        if (insideLoop || threads < 2 || chunks < 2) return false;
+        std::unique_lock<std::mutex> owner(busy, std::try_to_lock);
+        if (!owner) return false;
+
+        Loop loop;
+        loop.chunk = &chunk;
+        loop.participants = std::min<size_t>(threads, chunks);
+        loop.runs.reset(new std::atomic<uint64_t>[loop.participants]);
+        for (size_t p = 0; p < loop.participants; ++p) {
+            loop.runs[p].store(pack(p * chunks / loop.participants, (p + 1) * chunks / loop.participants));
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            while (helpers.size() + 1 < loop.participants) {
+                const size_t index = helpers.size() + 1;
+                const uint64_t seen = generation;
+                helpers.emplace_back([this, index, seen]() { helperLoop(index, seen); });
+            }
+            current = &loop;
+            participants = loop.participants;
+            active = loop.participants - 1;
+            ++generation;
+        }
+        wake.notify_all();
+
+        insideLoop = true;
+        participate(loop, 0);
+        insideLoop = false;
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            finished.wait(lock, [this]() { return active == 0; });
+            current = nullptr;
+            participants = 0;
+        }
+        if (loop.error) std::rethrow_exception(loop.error);
+        return true;
+    }
+
+private:
+    std::mutex busy;  // Held by the thread whose loop is in flight
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable finished;
+    std::vector<std::thread> helpers;
+    Loop* current = nullptr;
+    // Threads of the current loop. Helpers beyond it are woken too but not
+    // counted in `active`, so they must not touch `current`, which the
+    // loop may already have cleared by the time they get the mutex.
+    size_t participants = 0;
+    uint64_t generation = 0;
+    size_t active = 0;  // Helpers still working on the current loop
+    bool stopping = false;
+
+    LoopRuntime() = default;
+
+    void helperLoop(size_t index, uint64_t seen) {
+        insideLoop = true;
+        for (;;) {
+            Loop* loop;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&]() { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+                if (index >= participants) continue;
+                loop = current;
+            }
+            participate(*loop, index);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (--active == 0) finished.notify_all();
+            }
+        }
+    }
+};
+
+// Items per chunk, and the thread count (1 below the threshold)
+inline size_t grainSize(size_t count, size_t width) {
+    const size_t grain = std::max<size_t>(1, CHUNK_ELEMENTS / std::max<size_t>(1, width));
+    // Chunk indices have to fit the 32-bit halves of a run
+    return std::max(grain, count / 0xffffffffu + 1);
+}
+
+inline bool aboveThreshold(size_t count, size_t width, const KernelTuning& tuning) {
+    return tuning.parallelMinElements > 0 && static_cast<double>(count) * width >= tuning.parallelMinElements;
+}
+
+inline unsigned loopThreads(const KernelTuning& tuning) {
+    return tuning.threads ? tuning.threads : std::max(1u, std::thread::hardware_concurrency());
+}
+
+}  // namespace parallel_detail
+
+template<typename Body>
+void parallelFor(size_t count, size_t width, const KernelTuning& tuning, const Body& body) {
+    using namespace parallel_detail;
+    if (aboveThreshold(count, width, tuning)) {
+        const size_t grain = grainSize(count, width);
+        const std::function<void(size_t)> chunk = [&](size_t c) {
+            body(c * grain, std::min(c * grain + grain, count));
+        };
+        if (LoopRuntime::instance().run((count + grain - 1) / grain, loopThreads(tuning), chunk)) return;
+    }
+    body(0, count);
+}
+
+template<typename R, typename Map, typename Combine>
+R parallelReduce(size_t count, size_t width, const KernelTuning& tuning, const Map& map, const Combine& combine) {
+    using namespace parallel_detail;
+    if (!aboveThreshold(count, width, tuning)) return map(0, count);
+
+    const size_t grain = grainSize(count, width);
+    const size_t chunks = (count + grain - 1) / grain;
+    // Not a std::vector: chunks of a std::vector<bool> would share words
+    std::unique_ptr<R[]> partials(new R[chunks]);
+    const std::function<void(size_t)> chunk = [&](size_t c) {
+        partials[c] = map(c * grain, std::min(c * grain + grain, count));
+    };
+    if (!LoopRuntime::instance().run(chunks, loopThreads(tuning), chunk)) {
+        for (size_t c = 0; c < chunks; ++c) chunk(c);
+    }
+    R result = std::move(partials[0]);
+    for (size_t c = 1; c < chunks; ++c) result = combine(std::move(result), partials[c]);
+    return result;
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Tuning.h"
+
+// Work-stealing parallel loops for the element-wise operations and
+// reductions of Matrix and Vector.
+//
+// A loop over [0, count) is cut into chunks of roughly 16K elements (the
+// grain) and every thread starts with an equal contiguous run of them. A
+// thread takes chunks from the front of its own run; once that is empty it
+// steals the back half of another thread's remaining run, so a thread
+// slowed down by other processes or remote memory hands its work to idle
+// ones without the loop being cut into many tasks up front. The helper
+// threads are started on first use and sleep between loops.
+//
+// Loops of fewer than KernelTuning::parallelMinElements elements run
+// serially on the calling thread, as do loops started inside another
+// parallel loop or while another thread's loop is in flight.
+
+// Calls body(begin, end) on disjoint ranges covering [0, count). Every item
+// touches `width` elements: the columns of a matrix row, 1 for a vector.
+template<typename Body>
+void parallelFor(size_t count, size_t width, const KernelTuning& tuning, const Body& body);
+
+// Folds map(begin, end) -> R over [0, count) with combine(R, R) -> R. From
+// the parallel threshold up, the partial results are those of the fixed
+// chunks, combined in index order, so the result does not depend on the
+// thread count or on which thread ran which chunk. R must be default
+// constructible.
+template<typename R, typename Map, typename Combine>
+R parallelReduce(size_t count, size_t width, const KernelTuning& tuning, const Map& map, const Combine& combine);
+
+#include "ParallelFor.cpp"  // Include implementation (header-only library)
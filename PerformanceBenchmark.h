@@ -1,17 +1,33 @@
 #pragma once
 #include "Matrix.h"
 #include "Vector.h"
+#include "Distance.h"
+#include "FactorizationCache.h"
+#include "Async.h"
+#include "TiledFactorization.h"
+#include "MatrixIO.h"
+#include "OutOfCore.h"
+#include "BenchmarkHarness.h"
+#include "BenchmarkReport.h"
 #include <chrono>
 #include <functional>
 #include <string>
+#include <vector>
 #include <iomanip>
 
-class PerformanceBenchmark {
-private:
-    using Clock = std::chrono::high_resolution_clock;
-    using TimePoint = std::chrono::time_point<Clock>;
-    using Duration = std::chrono::duration<double, std::milli>;
+// Parameter grid of a scaling sweep. Every kernel is measured for every
+// dtype, aspect ratio, size and thread count; sizes are the largest matrix
+// dimension (rows for aspect >= 1, cols otherwise), and dot products use
+// vectors with as many elements as the matrix.
+struct SweepConfig {
+    std::vector<std::string> kernels;                   // PerformanceBenchmark::sweepKernels(); all when empty
+    std::vector<std::string> dtypes = {"double"};       // float, double, complex<float>, complex<double>
+    std::vector<size_t> sizes = {128, 256, 512};
+    std::vector<double> aspects = {1.0};                // rows / cols: > 1 tall-skinny, < 1 short-wide
+    std::vector<unsigned> threads = {1};                // Threads given to the parallel gemm
+};
 
+class PerformanceBenchmark {
 public:
     // Benchmark matrix operations
     static void benchmarkMatrixMultiplication();
@@ -20,6 +36,14 @@ public:
     static void benchmarkInverse();
     static void benchmarkLUDecomposition();
     static void benchmarkQRDecomposition();
+    static void benchmarkMatrixFunctions();
+    static void benchmarkGram();
+    static void benchmarkNearestNeighbors();
+    static void benchmarkFactorizationCache();
+    static void benchmarkAsync();
+    static void benchmarkTiledFactorizations();
+    static void benchmarkRandom();
+    static void benchmarkExactDeterminant();
     
     // Benchmark vector operations
     static void benchmarkVectorOperations();
@@ -34,30 +58,63 @@ public:
     
     // Accuracy tests
     static void testAccuracy();
+    
+    // Runs the named groups (all when empty) without the banner or accuracy
+    // tests, e.g. {"multiply", "lu"}; see benchmarkGroups()
+    static void runBenchmarks(const std::vector<std::string>& groups);
+    static std::vector<std::string> benchmarkGroups();
+    
+    // Size / shape / dtype / thread sweep with strong-scaling (fixed size)
+    // and weak-scaling (fixed work per thread) tables; results are recorded
+    // like any other benchmark
+    static void runSweep(const SweepConfig& config);
+    static std::vector<std::string> sweepKernels();
+    
+    // Measures the KernelTuning parameters (Tuning.h) of the named element
+    // types on this host, all of tuningTypes() when empty, and installs them
+    // for the running process; Tuning::save() persists them
+    static void autotune(const std::vector<std::string>& dtypes = {});
+    static std::vector<std::string> tuningTypes();
+    
+    // Every result printed since the last clearResults(), for JSON/CSV export
+    static const std::vector<BenchmarkRecord>& results() { return recorded(); }
+    static void clearResults() { recorded().clear(); }
 
 private:
     // Utility functions
     template<typename Func>
-    static double timeFunction(const std::string& description, Func&& func);
+    static BenchmarkStats timeFunction(const std::string& description, Func&& func,
+                                       const BenchmarkConfig& config = BenchmarkConfig());
     
     static void printHeader(const std::string& title);
-    static void printResult(const std::string& operation, double time_ms, const std::string& additional_info = "");
+    template<typename T>
+    static void sweepType(const std::string& dtype, const SweepConfig& config);
+    // Pairs stats with the profile collected by the last timeFunction call
+    static BenchmarkRecord makeRecord(const std::string& operation, size_t rows, size_t cols,
+                                      const BenchmarkStats& stats, double flops = 0.0, double bytes = 0.0);
+    static void printResult(const BenchmarkRecord& record, const std::string& additional_info = "");
+    static std::vector<BenchmarkRecord>& recorded();
+    static KernelProfile& lastProfile();
+    static void printProfile(const BenchmarkRecord& record);
     
     // Test data generators
     static MatrixD generateRandomMatrix(size_t size);
     static VectorD generateRandomVector(size_t size);
 };
 
+// Runs func under BenchmarkHarness (warmup, repeated samples until the
+// confidence target) and reports the median per-call time. One extra
+// untimed batch collects hardware counters for the next makeRecord().
 template<typename Func>
-double PerformanceBenchmark::timeFunction(const std::string& description, Func&& func) {
+BenchmarkStats PerformanceBenchmark::timeFunction(const std::string& description, Func&& func,
+                                                  const BenchmarkConfig& config) {
     std::cout << "Running: " << description << "... " << std::flush;
     
-    auto start = Clock::now();
-    func();
-    auto end = Clock::now();
+    BenchmarkStats stats = BenchmarkHarness::run(description, func, config);
+    lastProfile() = profileKernel(func, stats.iterationsPerSample);
     
-    double elapsed = Duration(end - start).count();
-    std::cout << "Done (" << std::fixed << std::setprecision(3) << elapsed << " ms)" << std::endl;
+    std::cout << "Done (" << std::fixed << std::setprecision(stats.medianMs < 1.0 ? 6 : 3) << stats.medianMs << " ms, "
+              << stats.samples << " samples)" << std::endl;
     
-    return elapsed;
+    return stats;
 }
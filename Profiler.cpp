@@ -0,0 +1,139 @@
+#include "Profiler.h"
+
+#ifdef LINALG_ENABLE_PROFILING
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+inline Profiler::State& Profiler::state() {
+    static State instance;
+    return instance;
+}
+
+inline size_t Profiler::sizeBucket(size_t rows, size_t cols) {
+    const size_t extent = std::max(rows, cols);
+    size_t bucket = 1;
+    while (bucket < extent) bucket <<= 1;
+    return extent ? bucket : 0;
+}
+
+inline uint32_t Profiler::threadIndex() {
+    thread_local const uint32_t index = state().nextThread.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+inline void Profiler::record(const char* operation, size_t rows, size_t cols, double flops, double bytes,
+                             Clock::time_point start, Clock::time_point end) {
+    State& s = state();
+    const double elapsedMs = std::chrono::duration<double, std::milli>(end - start).count();
+    const size_t bucket = sizeBucket(rows, cols);
+    const bool tracingOn = s.tracing.load(std::memory_order_relaxed);
+    const uint32_t thread = tracingOn ? threadIndex() : 0;
+
+    std::lock_guard<std::mutex> lock(s.mutex);
+    ProfileEntry& entry = s.table[std::make_pair(std::string(operation), bucket)];
+    if (entry.calls == 0) {
+        entry.operation = operation;
+        entry.sizeBucket = bucket;
+    }
+    ++entry.calls;
+    entry.totalMs += elapsedMs;
+    entry.flops += flops;
+    entry.bytes += bytes;
+
+    if (tracingOn) {
+        if (s.spans.size() < s.maxSpans) {
+            s.spans.push_back({operation,
+                               std::chrono::duration<double, std::micro>(start - s.epoch).count(),
+                               elapsedMs * 1000.0, thread, rows, cols});
+        } else {
+            ++s.dropped;
+        }
+    }
+}
+
+inline std::vector<ProfileEntry> Profiler::entries() {
+    State& s = state();
+    std::vector<ProfileEntry> result;
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        for (const auto& item : s.table) result.push_back(item.second);
+    }
+    std::sort(result.begin(), result.end(),
+              [](const ProfileEntry& a, const ProfileEntry& b) { return a.totalMs > b.totalMs; });
+    return result;
+}
+
+inline void Profiler::report(std::ostream& os) {
+    const std::vector<ProfileEntry> table = entries();
+    const std::ios::fmtflags flags = os.flags();
+    const std::streamsize precision = os.precision();
+
+    os << std::left << std::setw(28) << "Operation" << std::right << std::setw(8) << "Size<="
+       << std::setw(10) << "Calls" << std::setw(14) << "Total ms" << std::setw(12) << "Mean ms"
+       << std::setw(10) << "GFLOPS" << std::setw(10) << "GB/s" << "\n";
+    for (const ProfileEntry& entry : table) {
+        const double seconds = entry.totalMs * 1e-3;
+        os << std::left << std::setw(28) << entry.operation << std::right << std::setw(8) << entry.sizeBucket
+           << std::setw(10) << entry.calls << std::fixed << std::setprecision(3)
+           << std::setw(14) << entry.totalMs << std::setw(12) << entry.meanMs() << std::setprecision(2)
+           << std::setw(10) << (seconds > 0.0 ? entry.flops / seconds * 1e-9 : 0.0)
+           << std::setw(10) << (seconds > 0.0 ? entry.bytes / seconds * 1e-9 : 0.0) << "\n";
+    }
+    os.flush();
+
+    os.flags(flags);
+    os.precision(precision);
+}
+
+inline void Profiler::reset() {
+    State& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.table.clear();
+    s.spans.clear();
+    s.dropped = 0;
+}
+
+inline void Profiler::setTracing(bool enabled, size_t maxSpans) {
+    State& s = state();
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.maxSpans = maxSpans;
+        if (enabled) s.spans.reserve(std::min<size_t>(maxSpans, 65536));
+    }
+    s.tracing.store(enabled, std::memory_order_relaxed);
+}
+
+inline size_t Profiler::droppedSpans() {
+    State& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return s.dropped;
+}
+
+// Chrome trace event format: complete ("X") events, timestamps in
+// microseconds, one track per thread
+inline void Profiler::writeChromeTrace(const std::string& path) {
+    State& s = state();
+    std::ofstream file(path);
+    if (!file) {
+        throw std::runtime_error("Cannot open '" + path + "' for writing");
+    }
+
+    std::lock_guard<std::mutex> lock(s.mutex);
+    file << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    file << std::fixed << std::setprecision(3);
+    for (size_t i = 0; i < s.spans.size(); ++i) {
+        const TraceSpan& span = s.spans[i];
+        file << (i ? "," : "") << "\n  {\"name\": \"" << span.operation << "\", \"cat\": \"linalg\", \"ph\": \"X\""
+             << ", \"ts\": " << span.startUs << ", \"dur\": " << span.durationUs
+             << ", \"pid\": 1, \"tid\": " << span.thread
+             << ", \"args\": {\"rows\": " << span.rows << ", \"cols\": " << span.cols << "}}";
+    }
+    file << "\n]}\n";
+    if (!file) {
+        throw std::runtime_error("Failed writing '" + path + "'");
+    }
+}
+
+#endif  // LINALG_ENABLE_PROFILING
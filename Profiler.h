@@ -0,0 +1,121 @@
+#pragma once
+
+// Per-operation profiling and tracing for the library's public Matrix and
+// Vector operations.
+//
+// Instrumentation is compiled in only when LINALG_ENABLE_PROFILING is
+// defined (make profiling). Otherwise LINALG_PROFILE(...) expands to
+// ((void)0) without evaluating its arguments, so disabled builds carry no
+// code, data or timing overhead.
+//
+// With profiling compiled in, every instrumented call adds its wall time,
+// flops and bytes to a table keyed by operation name and size bucket, which
+// can be queried with Profiler::entries() or printed with Profiler::report().
+// Profiler::setTracing(true) additionally records each call as a span for
+// Profiler::writeChromeTrace(), which chrome://tracing and Perfetto load;
+// spans carry the recording thread so work inside parallel kernels shows up
+// per thread.
+
+#ifdef LINALG_ENABLE_PROFILING
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Accumulated cost of one operation within one size bucket
+struct ProfileEntry {
+    std::string operation;
+    size_t sizeBucket = 0;   // Largest dimension rounded up to a power of two
+    uint64_t calls = 0;
+    double totalMs = 0.0;
+    double flops = 0.0;
+    double bytes = 0.0;
+
+    double meanMs() const { return calls ? totalMs / static_cast<double>(calls) : 0.0; }
+};
+
+// One call, as recorded while tracing is on
+struct TraceSpan {
+    const char* operation;   // String literal from the LINALG_PROFILE site
+    double startUs;          // Since the profiler epoch
+    double durationUs;
+    uint32_t thread;
+    size_t rows;
+    size_t cols;
+};
+
+class Profiler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static void record(const char* operation, size_t rows, size_t cols, double flops, double bytes,
+                       Clock::time_point start, Clock::time_point end);
+
+    // Snapshot of the table, sorted by total time (descending)
+    static std::vector<ProfileEntry> entries();
+    static void report(std::ostream& os = std::cout);
+    static void reset();  // Clears the table and recorded spans
+
+    // Span recording; at most maxSpans are kept, later ones are counted as dropped
+    static void setTracing(bool enabled, size_t maxSpans = 1000000);
+    static bool tracing() { return state().tracing.load(std::memory_order_relaxed); }
+    static size_t droppedSpans();
+    static void writeChromeTrace(const std::string& path);
+
+    static size_t sizeBucket(size_t rows, size_t cols);
+
+    // Small sequential id of the calling thread (0 = first thread seen)
+    static uint32_t threadIndex();
+
+private:
+    struct State {
+        std::mutex mutex;
+        std::map<std::pair<std::string, size_t>, ProfileEntry> table;
+        std::vector<TraceSpan> spans;
+        std::atomic<bool> tracing{false};
+        size_t maxSpans = 0;
+        size_t dropped = 0;
+        std::atomic<uint32_t> nextThread{0};
+        Clock::time_point epoch = Clock::now();
+    };
+    static State& state();
+};
+
+// Records the enclosing scope as one call of `operation`
+class ProfileScope {
+private:
+    const char* operation;
+    size_t rows;
+    size_t cols;
+    double flops;
+    double bytes;
+    Profiler::Clock::time_point start;
+
+public:
+    ProfileScope(const char* op, size_t r, size_t c, double f = 0.0, double b = 0.0)
+        : operation(op), rows(r), cols(c), flops(f), bytes(b), start(Profiler::Clock::now()) {}
+    ~ProfileScope() { Profiler::record(operation, rows, cols, flops, bytes, start, Profiler::Clock::now()); }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+#define LINALG_PROFILE_CONCAT_(a, b) a##b
+#define LINALG_PROFILE_CONCAT(a, b) LINALG_PROFILE_CONCAT_(a, b)
+// LINALG_PROFILE(name, rows, cols[, flops[, bytes]])
+#define LINALG_PROFILE(...) ProfileScope LINALG_PROFILE_CONCAT(linalgProfileScope, __LINE__)(__VA_ARGS__)
+#define LINALG_PROFILING_ENABLED 1
+
+#include "Profiler.cpp"  // Include implementation (header-only library)
+
+#else
+
+#define LINALG_PROFILE(...) ((void)0)
+#define LINALG_PROFILING_ENABLED 0
+
+#endif
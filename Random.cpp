@@ -0,0 +1,209 @@
+#include "Random.h"
+
+namespace random_detail {
+
+// Round multipliers and Weyl key increments of Philox4x32
+constexpr uint32_t PHILOX_M0 = 0xD2511F53u;
+constexpr uint32_t PHILOX_M1 = 0xCD9E8D57u;
+constexpr uint32_t PHILOX_W0 = 0x9E3779B9u;
+constexpr uint32_t PHILOX_W1 = 0xBB67AE85u;
+constexpr int PHILOX_ROUNDS = 10;
+
+// Blocks per batch; every block gives two 64-bit words, one per element
+constexpr size_t LANES = 16;
+constexpr uint64_t BATCH_ELEMENTS = 2 * LANES;
+
+// Counter streams, so that the distributions of one seed are independent
+constexpr uint64_t UNIFORM_STREAM = 0;
+constexpr uint64_t NORMAL_STREAM = 1;
+
+#if defined(__AVX2__)
+// High and low halves of the 32 x 32-bit products of eight lanes by m,
+// from two widening multiplies on the even and the odd lanes
+inline void multiplyHighLow(__m256i a, __m256i m, __m256i& high, __m256i& low) {
+    const __m256i even = _mm256_mul_epu32(a, m);
+    const __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), m);
+    low = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+    high = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+}
+#endif
+
+// Philox on the counters (index + lane, stream) of a batch, eight lanes per
+// AVX2 register. The portable version relies on the compiler, which
+// vectorizes the widening multiplies less well.
+inline void philoxBatch(const uint32_t key[2], uint64_t index, uint64_t stream, uint64_t words[BATCH_ELEMENTS]) {
+    alignas(32) uint32_t c0[LANES], c1[LANES], c2[LANES], c3[LANES];
+    for (size_t l = 0; l < LANES; ++l) {
+        c0[l] = static_cast<uint32_t>(index + l);
+        c1[l] = static_cast<uint32_t>((index + l) >> 32);
+        c2[l] = static_cast<uint32_t>(stream);
+        c3[l] = static_cast<uint32_t>(stream >> 32);
+    }
+#if defined(__AVX2__)
+    const __m256i m0 = _mm256_set1_epi32(static_cast<int>(PHILOX_M0));
+    const __m256i m1 = _mm256_set1_epi32(static_cast<int>(PHILOX_M1));
+    for (size_t l = 0; l < LANES; l += 8) {
+        __m256i x0 = _mm256_load_si256(reinterpret_cast<const __m256i*>(c0 + l));
+        __m256i x1 = _mm256_load_si256(reinterpret_cast<const __m256i*>(c1 + l));
+        __m256i x2 = _mm256_load_si256(reinterpret_cast<const __m256i*>(c2 + l));
+        __m256i x3 = _mm256_load_si256(reinterpret_cast<const __m256i*>(c3 + l));
+        uint32_t k0 = key[0], k1 = key[1];
+        for (int round = 0; round < PHILOX_ROUNDS; ++round) {
+            __m256i high0, low0, high1, low1;
+            multiplyHighLow(x0, m0, high0, low0);
+            multiplyHighLow(x2, m1, high1, low1);
+            x0 = _mm256_xor_si256(_mm256_xor_si256(high1, x1), _mm256_set1_epi32(static_cast<int>(k0)));
+            x2 = _mm256_xor_si256(_mm256_xor_si256(high0, x3), _mm256_set1_epi32(static_cast<int>(k1)));
+            x1 = low1;
+            x3 = low0;
+            k0 += PHILOX_W0;
+            k1 += PHILOX_W1;
+        }
+        _mm256_store_si256(reinterpret_cast<__m256i*>(c0 + l), x0);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(c1 + l), x1);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(c2 + l), x2);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(c3 + l), x3);
+    }
+#else
+    for (size_t l = 0; l < LANES; ++l) {
+        uint32_t k0 = key[0], k1 = key[1];
+        for (int round = 0; round < PHILOX_ROUNDS; ++round) {
+            const uint64_t p0 = static_cast<uint64_t>(PHILOX_M0) * c0[l];
+            const uint64_t p1 = static_cast<uint64_t>(PHILOX_M1) * c2[l];
+            c0[l] = static_cast<uint32_t>(p1 >> 32) ^ c1[l] ^ k0;
+            c2[l] = static_cast<uint32_t>(p0 >> 32) ^ c3[l] ^ k1;
+            c1[l] = static_cast<uint32_t>(p1);
+            c3[l] = static_cast<uint32_t>(p0);
+            k0 += PHILOX_W0;
+            k1 += PHILOX_W1;
+        }
+    }
+#endif
+    for (size_t l = 0; l < LANES; ++l) {
+        words[2 * l] = c0[l] | (static_cast<uint64_t>(c1[l]) << 32);
+        words[2 * l + 1] = c2[l] | (static_cast<uint64_t>(c3[l]) << 32);
+    }
+}
+
+// High 64 bits of a * b
+inline uint64_t multiplyHigh(uint64_t a, uint64_t b) {
+    const uint64_t a0 = static_cast<uint32_t>(a), a1 = a >> 32;
+    const uint64_t b0 = static_cast<uint32_t>(b), b1 = b >> 32;
+    const uint64_t p01 = a0 * b1, p10 = a1 * b0;
+    const uint64_t middle = ((a0 * b0) >> 32) + static_cast<uint32_t>(p01) + static_cast<uint32_t>(p10);
+    return a1 * b1 + (p01 >> 32) + (p10 >> 32) + (middle >> 32);
+}
+
+// Uniform on [0, 1) with the precision of T
+template<typename T>
+T unitInterval(uint64_t word) {
+    if constexpr (sizeof(T) <= 4) {
+        return static_cast<T>(word >> 40) * static_cast<T>(0x1p-24);
+    } else {
+        return static_cast<T>(word >> 11) * static_cast<T>(0x1p-53);
+    }
+}
+
+// Word -> element transforms over a whole batch. The loops have a fixed
+// trip count, so every element is computed by the same (vector) code
+// whichever range it was requested with.
+template<typename T>
+struct UniformTransform {
+    T min, max;
+
+    void operator()(const uint64_t* words, T* values) const {
+        if constexpr (std::is_floating_point<T>::value) {
+            const T scale = max - min;
+            for (size_t v = 0; v < BATCH_ELEMENTS; ++v) values[v] = min + scale * unitInterval<T>(words[v]);
+        } else {
+            // Multiply-shift into [0, span); the bias is below span / 2^64.
+            // span wraps to 0 for the full 64-bit range.
+            const uint64_t low = static_cast<uint64_t>(min);
+            const uint64_t span = static_cast<uint64_t>(max) - low + 1;
+            for (size_t v = 0; v < BATCH_ELEMENTS; ++v) {
+                values[v] = static_cast<T>(low + (span ? multiplyHigh(words[v], span) : words[v]));
+            }
+        }
+    }
+};
+
+// Box-Muller on pairs of words, in double for every T
+template<typename T>
+struct NormalTransform {
+    T mean, stddev;
+
+    void operator()(const uint64_t* words, T* values) const {
+        constexpr double TWO_PI = 6.283185307179586476925286766559;
+        for (size_t p = 0; p < LANES; ++p) {
+            const double u1 = static_cast<double>((words[2 * p] >> 11) + 1) * 0x1p-53;  // (0, 1]
+            const double u2 = static_cast<double>(words[2 * p + 1] >> 11) * 0x1p-53;
+            const double radius = std::sqrt(-2.0 * std::log(u1));
+            const double angle = TWO_PI * u2;
+            values[2 * p] = static_cast<T>(mean + stddev * radius * std::cos(angle));
+            values[2 * p + 1] = static_cast<T>(mean + stddev * radius * std::sin(angle));
+        }
+    }
+};
+
+// Elements [first, first + count) of a stream into out. Batches are aligned
+// to multiples of BATCH_ELEMENTS, so an element always lands in the same
+// lane.
+template<typename T, typename Transform>
+void generate(T* out, size_t count, uint64_t first, uint64_t seed, uint64_t stream, const Transform& transform) {
+    const uint32_t key[2] = {static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)};
+    uint64_t words[BATCH_ELEMENTS];
+    T values[BATCH_ELEMENTS];
+    const uint64_t last = first + count;
+    for (uint64_t element = first; element < last;) {
+        const uint64_t batch = element / BATCH_ELEMENTS;
+        philoxBatch(key, batch * LANES, stream, words);
+        transform(words, values);
+        const size_t offset = static_cast<size_t>(element - batch * BATCH_ELEMENTS);
+        const size_t take = static_cast<size_t>(std::min<uint64_t>(BATCH_ELEMENTS - offset, last - element));
+        std::copy(values + offset, values + offset + take, out + (element - first));
+        element += take;
+    }
+}
+
+}  // namespace random_detail
+
+inline Philox4x32::Block Philox4x32::operator()(uint64_t index, uint64_t stream) const {
+    using namespace random_detail;
+    Block c = {static_cast<uint32_t>(index), static_cast<uint32_t>(index >> 32),
+               static_cast<uint32_t>(stream), static_cast<uint32_t>(stream >> 32)};
+    uint32_t k0 = key[0], k1 = key[1];
+    for (int round = 0; round < PHILOX_ROUNDS; ++round) {
+        const uint64_t p0 = static_cast<uint64_t>(PHILOX_M0) * c[0];
+        const uint64_t p1 = static_cast<uint64_t>(PHILOX_M1) * c[2];
+        c = {static_cast<uint32_t>(p1 >> 32) ^ c[1] ^ k0, static_cast<uint32_t>(p1),
+             static_cast<uint32_t>(p0 >> 32) ^ c[3] ^ k1, static_cast<uint32_t>(p0)};
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+    return c;
+}
+
+inline uint64_t randomSeed() {
+    std::random_device device;
+    return (static_cast<uint64_t>(device()) << 32) ^ device();
+}
+
+template<typename T>
+void randomUniform(T* out, size_t count, uint64_t first, T min, T max, uint64_t seed) {
+    static_assert(std::is_arithmetic<T>::value, "Uniform random numbers need a real or integer element type");
+    if (max < min) {
+        throw std::invalid_argument("Random range must satisfy min <= max");
+    }
+    random_detail::generate(out, count, first, seed, random_detail::UNIFORM_STREAM,
+                            random_detail::UniformTransform<T>{min, max});
+}
+
+template<typename T>
+void randomNormal(T* out, size_t count, uint64_t first, T mean, T stddev, uint64_t seed) {
+    static_assert(std::is_floating_point<T>::value, "Normal random numbers need a floating-point element type");
+    if (!(stddev >= T(0))) {
+        throw std::invalid_argument("Standard deviation must be non-negative");
+    }
+    random_detail::generate(out, count, first, seed, random_detail::NORMAL_STREAM,
+                            random_detail::NormalTransform<T>{mean, stddev});
+}
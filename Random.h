@@ -0,0 +1,51 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// Counter-based random numbers for the fill and factory functions of Matrix
+// and Vector.
+//
+// Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as 1, 2,
+// 3", SC'11) maps a 128-bit counter and a 64-bit key to 128 random bits
+// with ten rounds of multiplies and xors, and passes BigCrush. Element e of
+// a fill is derived from the counter e / 2 and the seed alone, so any range
+// of elements can be generated independently: the threads of a parallel
+// fill produce exactly the values of a serial one, for every thread count.
+// Blocks are generated sixteen at a time in structure-of-arrays form, with
+// AVX2 when the build targets it.
+
+class Philox4x32 {
+public:
+    using Block = std::array<uint32_t, 4>;
+
+    explicit Philox4x32(uint64_t seed) : key{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)} {}
+
+    // Random bits of the counter (index, stream)
+    Block operator()(uint64_t index, uint64_t stream = 0) const;
+
+private:
+    uint32_t key[2];
+};
+
+// Seed from std::random_device, for fills that were not given one
+uint64_t randomSeed();
+
+// out[0 .. count) <- elements first .. first + count of the uniform stream
+// of `seed`: [min, max) for floating-point T, [min, max] for integer T
+template<typename T>
+void randomUniform(T* out, size_t count, uint64_t first, T min, T max, uint64_t seed);
+
+// The same for the normal distribution (Box-Muller), floating-point T only
+template<typename T>
+void randomNormal(T* out, size_t count, uint64_t first, T mean, T stddev, uint64_t seed);
+
+#include "Random.cpp"  // Include implementation (header-only library)
@@ -0,0 +1,1076 @@
+#include "Solvers.h"
+
+// LU factorization (copy of A)
+template<typename T>
+LUFactorization<T>::LUFactorization(const Matrix<T>& A)
+    : lu(A), permutationSign(1), singular(false) {
+    factorize();
+}
+
+// LU factorization reusing the storage of A
+template<typename T>
+LUFactorization<T>::LUFactorization(Matrix<T>&& A)
+    : lu(std::move(A)), permutationSign(1), singular(false) {
+    factorize();
+}
+
+// Factor a new matrix, reusing the existing storage when the size matches
+template<typename T>
+void LUFactorization<T>::refactor(const Matrix<T>& A) {
+    lu = A;
+    permutationSign = 1;
+    singular = false;
+    factorize();
+}
+
+// Blocked right-looking elimination with partial pivoting. Each panel of
+// columns is factored unblocked, then the trailing matrix is updated with a
+// triangular solve and a gemm. Rows are swapped by exchanging row buffers,
+// so a pivot costs O(1) rather than O(n).
+template<typename T>
+void LUFactorization<T>::factorize() {
+    if (lu.getRows() != lu.getCols()) {
+        throw std::invalid_argument("LU decomposition requires a square matrix");
+    }
+
+    const size_t n = lu.getRows();
+    const size_t BLOCK_SIZE = Tuning::parameters<T>().luPanel;
+    permutation.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        permutation[i] = i;
+    }
+
+    for (size_t k0 = 0; k0 < n; k0 += BLOCK_SIZE) {
+        const size_t k1 = std::min(k0 + BLOCK_SIZE, n);
+
+        // Panel factorization of columns [k0, k1)
+        for (size_t k = k0; k < k1; ++k) {
+            size_t pivot_row = k;
+            T pivot_abs = std::abs(lu[k][k]);
+            for (size_t i = k + 1; i < n; ++i) {
+                T candidate = std::abs(lu[i][k]);
+                if (candidate > pivot_abs) {
+                    pivot_abs = candidate;
+                    pivot_row = i;
+                }
+            }
+
+            if (pivot_abs == T(0)) {
+                singular = true;
+                continue;
+            }
+
+            if (pivot_row != k) {
+                std::swap(lu[k], lu[pivot_row]);
+                std::swap(permutation[k], permutation[pivot_row]);
+                permutationSign = -permutationSign;
+            }
+
+            const std::vector<T>& pivot = lu[k];
+            const T inv_pivot = T(1) / pivot[k];
+            for (size_t i = k + 1; i < n; ++i) {
+                std::vector<T>& row = lu[i];
+                const T factor = row[k] * inv_pivot;
+                row[k] = factor;
+                if (factor == T(0)) continue;
+                for (size_t j = k + 1; j < k1; ++j) {
+                    row[j] -= factor * pivot[j];
+                }
+            }
+        }
+
+        if (k1 == n) break;
+
+        // U12 = inv(L11) * A12
+        for (size_t i = k0 + 1; i < k1; ++i) {
+            std::vector<T>& row = lu[i];
+            for (size_t p = k0; p < i; ++p) {
+                const T factor = row[p];
+                if (factor == T(0)) continue;
+                const std::vector<T>& source = lu[p];
+                for (size_t j = k1; j < n; ++j) {
+                    row[j] -= factor * source[j];
+                }
+            }
+        }
+
+        // A22 -= L21 * U12
+        Matrix<T>::gemm(n - k1, n - k1, k1 - k0, T(-1), lu, k1, k0, lu, k0, k1, lu, k1, k1);
+    }
+}
+
+template<typename T>
+Matrix<T> LUFactorization<T>::lower() const {
+    const size_t n = size();
+    Matrix<T> L = Matrix<T>::identity(n);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < i; ++j) {
+            L(i, j) = lu[i][j];
+        }
+    }
+    return L;
+}
+
+template<typename T>
+Matrix<T> LUFactorization<T>::upper() const {
+    const size_t n = size();
+    Matrix<T> U(n, n);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = i; j < n; ++j) {
+            U(i, j) = lu[i][j];
+        }
+    }
+    return U;
+}
+
+template<typename T>
+Matrix<T> LUFactorization<T>::solve(const Matrix<T>& B) const {
+    Matrix<T> X = B;
+    solveInPlace(X);
+    return X;
+}
+
+// Apply P, then forward substitution with unit L and back substitution with U.
+// Each update is a row axpy, so all right-hand sides are processed together.
+template<typename T>
+void LUFactorization<T>::solveInPlace(Matrix<T>& B) const {
+    const size_t n = size();
+    if (B.getRows() != n) {
+        throw std::invalid_argument("Right-hand side rows must match matrix size");
+    }
+    if (singular) {
+        throw std::runtime_error("Matrix is singular and the system cannot be solved");
+    }
+
+    const size_t m = B.getCols();
+
+    // Apply row permutation by moving row buffers
+    std::vector<std::vector<T>> permuted(n);
+    for (size_t i = 0; i < n; ++i) {
+        permuted[i] = std::move(B[permutation[i]]);
+    }
+    for (size_t i = 0; i < n; ++i) {
+        B[i] = std::move(permuted[i]);
+    }
+
+    // Forward substitution (L has unit diagonal)
+    for (size_t i = 0; i < n; ++i) {
+        std::vector<T>& xi = B[i];
+        const std::vector<T>& li = lu[i];
+        for (size_t k = 0; k < i; ++k) {
+            const T factor = li[k];
+            if (factor == T(0)) continue;
+            const std::vector<T>& xk = B[k];
+            for (size_t j = 0; j < m; ++j) {
+                xi[j] -= factor * xk[j];
+            }
+        }
+    }
+
+    // Back substitution
+    for (size_t i = n; i-- > 0;) {
+        std::vector<T>& xi = B[i];
+        const std::vector<T>& ui = lu[i];
+        for (size_t k = i + 1; k < n; ++k) {
+            const T factor = ui[k];
+            if (factor == T(0)) continue;
+            const std::vector<T>& xk = B[k];
+            for (size_t j = 0; j < m; ++j) {
+                xi[j] -= factor * xk[j];
+            }
+        }
+        const T inv_diag = T(1) / ui[i];
+        for (size_t j = 0; j < m; ++j) {
+            xi[j] *= inv_diag;
+        }
+    }
+}
+
+template<typename T>
+T LUFactorization<T>::determinant() const {
+    if (singular) return T(0);
+
+    T det = static_cast<T>(permutationSign);
+    for (size_t i = 0; i < size(); ++i) {
+        det *= lu[i][i];
+    }
+    return det;
+}
+
+template<typename T>
+std::pair<T, T> LUFactorization<T>::logAbsDeterminant() const {
+    if (singular) {
+        return std::make_pair(T(0), -std::numeric_limits<T>::infinity());
+    }
+
+    T sign = static_cast<T>(permutationSign);
+    T logAbs = T(0);
+    for (size_t i = 0; i < size(); ++i) {
+        const T pivot = lu[i][i];
+        if (pivot < T(0)) sign = -sign;
+        logAbs += static_cast<T>(std::log(std::abs(pivot)));
+    }
+    return std::make_pair(sign, logAbs);
+}
+
+// In-place product W <- U * L of the packed factors held in the n x n block
+// of W at (o, o): U is the upper triangle including the diagonal, L is the
+// strict lower triangle with an implicit unit diagonal.
+//   [U11 U12; 0 U22] * [L11 0; L21 L22]
+//     = [U11*L11 + U12*L21, U12*L22; U22*L21, U22*L22]
+template<typename T>
+void multiplyUpperUnitLowerInPlace(Matrix<T>& W, size_t o, size_t n) {
+    const size_t BLOCK_SIZE = Tuning::parameters<T>().recursionCutoff;
+
+    if (n > BLOCK_SIZE) {
+        const size_t n1 = n / 2;
+        const size_t n2 = n - n1;
+        multiplyUpperUnitLowerInPlace(W, o, n1);
+        Matrix<T>::gemm(n1, n1, n2, T(1), W, o, o + n1, W, o + n1, o, W, o, o);
+        Matrix<T>::trmm(MatrixSide::Right, TriangleType::Lower, DiagonalType::Unit, n1, n2,
+                        W, o + n1, o + n1, W, o, o + n1);
+        Matrix<T>::trmm(MatrixSide::Left, TriangleType::Upper, DiagonalType::NonUnit, n2, n1,
+                        W, o + n1, o + n1, W, o + n1, o);
+        multiplyUpperUnitLowerInPlace(W, o + n1, n2);
+        return;
+    }
+
+    // Row i of the product only needs row i of U and rows k >= i of L,
+    // so rows can be overwritten in ascending order.
+    std::vector<T> tmp(n);
+    for (size_t i = 0; i < n; ++i) {
+        std::fill(tmp.begin(), tmp.end(), T(0));
+        const std::vector<T>& u_row = W[o + i];
+        for (size_t k = i; k < n; ++k) {
+            const T u = u_row[o + k];
+            if (u == T(0)) continue;
+            const std::vector<T>& l_row = W[o + k];
+            for (size_t j = 0; j < k; ++j) {
+                tmp[j] += u * l_row[o + j];
+            }
+            tmp[k] += u;
+        }
+        std::copy(tmp.begin(), tmp.end(), W[o + i].begin() + o);
+    }
+}
+
+template<typename T>
+Matrix<T> LUFactorization<T>::inverse() const {
+    Matrix<T> W;
+    inverse(W);
+    return W;
+}
+
+template<typename T>
+void LUFactorization<T>::inverse(Matrix<T>& W) const {
+    if (singular) {
+        throw std::runtime_error("Matrix is singular and cannot be inverted");
+    }
+
+    const size_t n = size();
+    W = lu;
+    Matrix<T>::trtri(TriangleType::Upper, DiagonalType::NonUnit, n, W, 0);
+    Matrix<T>::trtri(TriangleType::Lower, DiagonalType::Unit, n, W, 0);
+    multiplyUpperUnitLowerInPlace(W, 0, n);
+
+    // Undo the row permutation: column permutation[i] of inv(A) is column i of inv(U) * inv(L)
+    std::vector<T> tmp(n);
+    for (size_t r = 0; r < n; ++r) {
+        std::vector<T>& row = W[r];
+        for (size_t i = 0; i < n; ++i) {
+            tmp[permutation[i]] = row[i];
+        }
+        std::copy(tmp.begin(), tmp.end(), row.begin());
+    }
+}
+
+// Cholesky factorization (copy of A)
+template<typename T>
+CholeskyFactorization<T>::CholeskyFactorization(const Matrix<T>& A)
+    : L(A), positiveDefinite(true) {
+    factorize();
+}
+
+// Cholesky factorization reusing the storage of A
+template<typename T>
+CholeskyFactorization<T>::CholeskyFactorization(Matrix<T>&& A)
+    : L(std::move(A)), positiveDefinite(true) {
+    factorize();
+}
+
+// Row-oriented Cholesky–Crout: each entry is a dot product of two
+// contiguous row prefixes of L.
+template<typename T>
+void CholeskyFactorization<T>::factorize() {
+    if (L.getRows() != L.getCols()) {
+        throw std::invalid_argument("Cholesky decomposition requires a square matrix");
+    }
+
+    const size_t n = L.getRows();
+    for (size_t i = 0; i < n; ++i) {
+        std::vector<T>& li = L[i];
+        for (size_t j = 0; j <= i; ++j) {
+            const std::vector<T>& lj = L[j];
+            T sum = li[j];
+            for (size_t k = 0; k < j; ++k) {
+                sum -= li[k] * lj[k];
+            }
+
+            if (i == j) {
+                if (!(sum > T(0))) {
+                    positiveDefinite = false;
+                    return;
+                }
+                li[i] = static_cast<T>(std::sqrt(sum));
+            } else {
+                li[j] = sum / lj[j];
+            }
+        }
+
+        // Clear the (unused) upper triangle
+        for (size_t j = i + 1; j < n; ++j) {
+            li[j] = T(0);
+        }
+    }
+}
+
+template<typename T>
+Matrix<T> CholeskyFactorization<T>::solve(const Matrix<T>& B) const {
+    Matrix<T> X = B;
+    solveInPlace(X);
+    return X;
+}
+
+// Forward substitution with L, then back substitution with L^T applied
+// column-wise so that only rows of L are traversed.
+template<typename T>
+void CholeskyFactorization<T>::solveInPlace(Matrix<T>& B) const {
+    const size_t n = size();
+    if (B.getRows() != n) {
+        throw std::invalid_argument("Right-hand side rows must match matrix size");
+    }
+    if (!positiveDefinite) {
+        throw std::runtime_error("Matrix is not positive definite - Cholesky solve failed");
+    }
+
+    const size_t m = B.getCols();
+
+    // L * Y = B
+    for (size_t i = 0; i < n; ++i) {
+        std::vector<T>& yi = B[i];
+        const std::vector<T>& li = L[i];
+        for (size_t k = 0; k < i; ++k) {
+            const T factor = li[k];
+            const std::vector<T>& yk = B[k];
+            for (size_t j = 0; j < m; ++j) {
+                yi[j] -= factor * yk[j];
+            }
+        }
+        const T inv_diag = T(1) / li[i];
+        for (size_t j = 0; j < m; ++j) {
+            yi[j] *= inv_diag;
+        }
+    }
+
+    // L^T * X = Y
+    for (size_t i = n; i-- > 0;) {
+        std::vector<T>& xi = B[i];
+        const std::vector<T>& li = L[i];
+        const T inv_diag = T(1) / li[i];
+        for (size_t j = 0; j < m; ++j) {
+            xi[j] *= inv_diag;
+        }
+        for (size_t k = 0; k < i; ++k) {
+            const T factor = li[k];
+            std::vector<T>& xk = B[k];
+            for (size_t j = 0; j < m; ++j) {
+                xk[j] -= factor * xi[j];
+            }
+        }
+    }
+}
+
+template<typename T>
+T CholeskyFactorization<T>::determinant() const {
+    if (!positiveDefinite) {
+        throw std::runtime_error("Matrix is not positive definite - Cholesky decomposition failed");
+    }
+
+    T det = T(1);
+    for (size_t i = 0; i < size(); ++i) {
+        det *= L[i][i] * L[i][i];
+    }
+    return det;
+}
+
+template<typename T>
+T CholeskyFactorization<T>::logDeterminant() const {
+    if (!positiveDefinite) {
+        throw std::runtime_error("Matrix is not positive definite - Cholesky decomposition failed");
+    }
+
+    T logDet = T(0);
+    for (size_t i = 0; i < size(); ++i) {
+        logDet += static_cast<T>(std::log(L[i][i]));
+    }
+    return T(2) * logDet;
+}
+
+// inv(L) = L' * D with L' unit lower, so inv(A) = inv(L)^T * L' * D, which
+// reuses the packed upper-times-unit-lower product of the LU inverse.
+template<typename T>
+Matrix<T> CholeskyFactorization<T>::inverse() const {
+    if (!positiveDefinite) {
+        throw std::runtime_error("Matrix is not positive definite - Cholesky inverse failed");
+    }
+
+    const size_t n = size();
+    Matrix<T> W = L;
+    Matrix<T>::trtri(TriangleType::Lower, DiagonalType::NonUnit, n, W, 0);
+
+    std::vector<T> d(n);
+    for (size_t i = 0; i < n; ++i) {
+        d[i] = W[i][i];
+    }
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = i + 1; j < n; ++j) {
+            W[i][j] = W[j][i];
+        }
+    }
+    for (size_t i = 0; i < n; ++i) {
+        std::vector<T>& row = W[i];
+        for (size_t j = 0; j < i; ++j) {
+            row[j] /= d[j];
+        }
+    }
+
+    multiplyUpperUnitLowerInPlace(W, 0, n);
+
+    // Scale columns by D and mirror the lower triangle for exact symmetry
+    for (size_t i = 0; i < n; ++i) {
+        std::vector<T>& row = W[i];
+        for (size_t j = 0; j <= i; ++j) {
+            row[j] *= d[j];
+        }
+    }
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = i + 1; j < n; ++j) {
+            W[i][j] = W[j][i];
+        }
+    }
+    return W;
+}
+
+template<typename T>
+void CholeskyFactorization<T>::update(const std::vector<T>& x) {
+    rankOneUpdate(x, false);
+}
+
+template<typename T>
+void CholeskyFactorization<T>::downdate(const std::vector<T>& x) {
+    rankOneUpdate(x, true);
+}
+
+// LINPACK-style rank-1 update: rotation k combines column k of L with x.
+// Row i applies rotations 0..i-1 in order and then forms its own diagonal
+// rotation, which is the column algorithm reordered to traverse L by rows.
+template<typename T>
+void CholeskyFactorization<T>::rankOneUpdate(const std::vector<T>& x, bool downdating) {
+    const size_t n = size();
+    if (x.size() != n) {
+        throw std::invalid_argument("Update vector length must match matrix size");
+    }
+    if (!positiveDefinite) {
+        throw std::runtime_error("Matrix is not positive definite - Cholesky update failed");
+    }
+
+    if (downdating) {
+        // A - x * x^T stays positive definite iff ||inv(L) * x|| < 1
+        std::vector<T> p(n);
+        T norm2 = T(0);
+        for (size_t i = 0; i < n; ++i) {
+            const std::vector<T>& li = L[i];
+            T sum = x[i];
+            for (size_t k = 0; k < i; ++k) {
+                sum -= li[k] * p[k];
+            }
+            p[i] = sum / li[i];
+            norm2 += p[i] * p[i];
+        }
+        if (!(norm2 < T(1))) {
+            throw std::runtime_error("Cholesky downdate would make the matrix indefinite");
+        }
+    }
+
+    const T sign = downdating ? T(-1) : T(1);
+    std::vector<T> c(n), s(n);
+    for (size_t i = 0; i < n; ++i) {
+        std::vector<T>& li = L[i];
+        T xi = x[i];
+        for (size_t k = 0; k < i; ++k) {
+            const T lik = (li[k] + sign * s[k] * xi) / c[k];
+            xi = c[k] * xi - s[k] * lik;
+            li[k] = lik;
+        }
+        const T r2 = li[i] * li[i] + sign * xi * xi;
+        if (!(r2 > T(0))) {
+            // Only reachable through rounding right at the definiteness boundary
+            positiveDefinite = false;
+            throw std::runtime_error("Cholesky downdate would make the matrix indefinite");
+        }
+        const T r = static_cast<T>(std::sqrt(r2));
+        c[i] = r / li[i];
+        s[i] = xi / li[i];
+        li[i] = r;
+    }
+}
+
+// QR factorization (copy of A)
+template<typename T>
+QRFactorization<T>::QRFactorization(const Matrix<T>& A) : R(A) {
+    factorize();
+}
+
+// Householder reflections H_k = I - beta_k * v_k * v_k^T reduce R to upper
+// trapezoidal form, with v_k kept below the diagonal of R. The thin
+// Q = H_0 * ... * H_{k-1} * [I; 0] is then formed from the last reflector
+// backwards, so that each one only touches the columns it can change. All
+// updates run over rows: w^T = v^T * X, then X -= beta * v * w^T.
+template<typename T>
+void QRFactorization<T>::factorize() {
+    const size_t m = R.getRows();
+    const size_t n = R.getCols();
+    const size_t p = std::min(m, n);
+    std::vector<T> head(p, T(0)), beta(p, T(0)), w(n);
+    for (size_t k = 0; k + 1 < m && k < n; ++k) {
+        T norm = T(0);
+        for (size_t i = k; i < m; ++i) {
+            norm += R[i][k] * R[i][k];
+        }
+        norm = static_cast<T>(std::sqrt(norm));
+        if (norm == T(0)) continue;
+
+        // v = R(k:m, k) - alpha * e_k; only its head differs from R
+        const T alpha = R[k][k] > T(0) ? -norm : norm;
+        head[k] = R[k][k] - alpha;
+        T vnorm2 = head[k] * head[k];
+        for (size_t i = k + 1; i < m; ++i) {
+            vnorm2 += R[i][k] * R[i][k];
+        }
+        beta[k] = T(2) / vnorm2;
+
+        std::fill(w.begin() + k + 1, w.end(), T(0));
+        for (size_t i = k; i < m; ++i) {
+            const std::vector<T>& ri = R[i];
+            const T vi = i == k ? head[k] : ri[k];
+            for (size_t j = k + 1; j < n; ++j) {
+                w[j] += vi * ri[j];
+            }
+        }
+        for (size_t i = k; i < m; ++i) {
+            std::vector<T>& ri = R[i];
+            const T factor = beta[k] * (i == k ? head[k] : ri[k]);
+            for (size_t j = k + 1; j < n; ++j) {
+                ri[j] -= factor * w[j];
+            }
+        }
+        R[k][k] = alpha;
+    }
+
+    Q = Matrix<T>(m, p);
+    for (size_t i = 0; i < p; ++i) {
+        Q[i][i] = T(1);
+    }
+    for (size_t k = p; k-- > 0;) {
+        if (beta[k] == T(0)) continue;
+        std::fill(w.begin() + k, w.begin() + p, T(0));
+        for (size_t i = k; i < m; ++i) {
+            const std::vector<T>& qi = Q[i];
+            const T vi = i == k ? head[k] : R[i][k];
+            for (size_t j = k; j < p; ++j) {
+                w[j] += vi * qi[j];
+            }
+        }
+        for (size_t i = k; i < m; ++i) {
+            std::vector<T>& qi = Q[i];
+            const T factor = beta[k] * (i == k ? head[k] : R[i][k]);
+            for (size_t j = k; j < p; ++j) {
+                qi[j] -= factor * w[j];
+            }
+        }
+    }
+
+    for (size_t i = 1; i < m; ++i) {
+        std::fill(R[i].begin(), R[i].begin() + std::min(i, n), T(0));
+    }
+    R.resize(p, n);
+}
+
+template<typename T>
+void QRFactorization<T>::givens(const T& a, const T& b, T& c, T& s) {
+    if (b == T(0)) {
+        c = T(1);
+        s = T(0);
+        return;
+    }
+    const T r = static_cast<T>(std::hypot(a, b));
+    c = a / r;
+    s = b / r;
+}
+
+template<typename T>
+void QRFactorization<T>::rotateColumns(size_t j, size_t k, const T& c, const T& s) {
+    for (size_t r = 0; r < Q.getRows(); ++r) {
+        std::vector<T>& qr = Q[r];
+        const T qj = qr[j];
+        const T qk = qr[k];
+        qr[j] = c * qj + s * qk;
+        qr[k] = -s * qj + c * qk;
+    }
+}
+
+template<typename T>
+void QRFactorization<T>::rotateWithColumn(std::vector<T>& x, size_t k, const T& c, const T& s) {
+    for (size_t r = 0; r < Q.getRows(); ++r) {
+        std::vector<T>& qr = Q[r];
+        const T xr = x[r];
+        const T qk = qr[k];
+        x[r] = c * xr + s * qk;
+        qr[k] = -s * xr + c * qk;
+    }
+}
+
+// Classical Gram-Schmidt run twice, which keeps x orthogonal to Q to
+// working precision unless x lies in Q's span. In that case the first unit
+// vector e_i with a component of norm^2 >= 1 / (2m) outside the span takes
+// its place; one exists because the m - k missing directions spread over m
+// unit vectors.
+template<typename T>
+T QRFactorization<T>::complement(std::vector<T>& x, std::vector<T>& coefficients) const {
+    const size_t m = Q.getRows();
+    const size_t p = Q.getCols();
+    std::vector<T> h(p);
+    auto project = [&](std::vector<T>& y, bool accumulate) {
+        for (int pass = 0; pass < 2; ++pass) {
+            std::fill(h.begin(), h.end(), T(0));
+            for (size_t r = 0; r < m; ++r) {
+                const std::vector<T>& qr = Q[r];
+                const T yr = y[r];
+                for (size_t j = 0; j < p; ++j) {
+                    h[j] += qr[j] * yr;
+                }
+            }
+            for (size_t r = 0; r < m; ++r) {
+                const std::vector<T>& qr = Q[r];
+                T sum = T(0);
+                for (size_t j = 0; j < p; ++j) {
+                    sum += qr[j] * h[j];
+                }
+                y[r] -= sum;
+            }
+            if (accumulate) {
+                for (size_t j = 0; j < p; ++j) {
+                    coefficients[j] += h[j];
+                }
+            }
+        }
+        T norm2 = T(0);
+        for (size_t r = 0; r < m; ++r) {
+            norm2 += y[r] * y[r];
+        }
+        return norm2;
+    };
+
+    T before = T(0);
+    for (size_t r = 0; r < m; ++r) {
+        before += x[r] * x[r];
+    }
+    const T norm2 = project(x, true);
+    const T eps = std::numeric_limits<T>::epsilon();
+    if (norm2 > T(m) * eps * eps * before) {
+        const T norm = static_cast<T>(std::sqrt(norm2));
+        for (T& value : x) value /= norm;
+        return norm;
+    }
+
+    for (size_t i = 0; i < m; ++i) {
+        std::fill(x.begin(), x.end(), T(0));
+        x[i] = T(1);
+        const T candidate = project(x, false);
+        if (T(2 * m) * candidate >= T(1)) {
+            const T norm = static_cast<T>(std::sqrt(candidate));
+            for (T& value : x) value /= norm;
+            break;
+        }
+    }
+    return T(0);
+}
+
+// Least squares through R1 * X = (Q^T * B)(0:n, :); Q^T * B is accumulated
+// by rows of Q and B
+template<typename T>
+Matrix<T> QRFactorization<T>::solve(const Matrix<T>& B) const {
+    const size_t m = rows();
+    const size_t n = cols();
+    if (B.getRows() != m) {
+        throw std::invalid_argument("Right-hand side rows must match matrix size");
+    }
+    if (m < n) {
+        throw std::invalid_argument("Least-squares solve needs at least as many rows as columns");
+    }
+
+    const size_t nrhs = B.getCols();
+    Matrix<T> X(n, nrhs);
+    for (size_t i = 0; i < m; ++i) {
+        const std::vector<T>& qi = Q[i];
+        const std::vector<T>& bi = B[i];
+        for (size_t j = 0; j < n; ++j) {
+            const T factor = qi[j];
+            std::vector<T>& xj = X[j];
+            for (size_t c = 0; c < nrhs; ++c) {
+                xj[c] += factor * bi[c];
+            }
+        }
+    }
+
+    for (size_t i = n; i-- > 0;) {
+        const std::vector<T>& ri = R[i];
+        if (ri[i] == T(0)) {
+            throw std::runtime_error("Matrix is rank deficient - QR solve failed");
+        }
+        std::vector<T>& xi = X[i];
+        for (size_t k = i + 1; k < n; ++k) {
+            const T factor = ri[k];
+            const std::vector<T>& xk = X[k];
+            for (size_t c = 0; c < nrhs; ++c) {
+                xi[c] -= factor * xk[c];
+            }
+        }
+        const T inv_diag = T(1) / ri[i];
+        for (size_t c = 0; c < nrhs; ++c) {
+            xi[c] *= inv_diag;
+        }
+    }
+    return X;
+}
+
+// [A; row^T] = [Q 0; 0 1] * [R; row^T]; rotations of row j of R against the
+// new last row zero its first min(m, n) entries, and the same rotations
+// mix column j of Q with e_m. For m >= n the last row of R ends up zero and
+// the rotated e_m drops out; for m < n both join the factorization. The new
+// row of Q is then moved to `index`.
+template<typename T>
+void QRFactorization<T>::insertRow(size_t index, const std::vector<T>& row) {
+    const size_t m = rows();
+    const size_t n = cols();
+    const size_t p = std::min(m, n);
+    if (index > m) {
+        throw std::out_of_range("Row index out of range");
+    }
+    if (row.size() != n) {
+        throw std::invalid_argument("Row length must match the factorized matrix");
+    }
+
+    Q.resize(m + 1, p);
+    std::vector<T> extra(m + 1, T(0));
+    extra[m] = T(1);
+    std::vector<T> last = row;
+    for (size_t j = 0; j < p; ++j) {
+        T c, s;
+        givens(R[j][j], last[j], c, s);
+        std::vector<T>& rj = R[j];
+        for (size_t k = j; k < n; ++k) {
+            const T a = rj[k];
+            const T b = last[k];
+            rj[k] = c * a + s * b;
+            last[k] = -s * a + c * b;
+        }
+        last[j] = T(0);
+        rotateWithColumn(extra, j, c, -s);  // [Q_j e] * G, as [e Q_j] with s negated
+    }
+
+    if (m < n) {
+        R.resize(m + 1, n);
+        std::swap(R[m], last);
+        Q.resize(m + 1, m + 1);
+        for (size_t r = 0; r <= m; ++r) {
+            Q[r][m] = extra[r];
+        }
+    }
+    for (size_t r = m; r > index; --r) {
+        std::swap(Q[r], Q[r - 1]);
+    }
+}
+
+// Rotations of adjacent columns of Q, from the bottom up, reduce row `index`
+// of Q to +-e_0. The same rotations of rows of R leave it upper Hessenberg,
+// so dropping row `index` and column 0 of Q and row 0 of R is again a QR
+// factorization. When m > n, Q is thin: it is first bordered by the unit u
+// along (I - Q * Q^T) * e_index and R by a zero row, which keeps
+// [Q u] * [R; 0] = A and gives row `index` of [Q u] unit norm.
+template<typename T>
+void QRFactorization<T>::deleteRow(size_t index) {
+    const size_t m = rows();
+    const size_t n = cols();
+    if (index >= m) {
+        throw std::out_of_range("Row index out of range");
+    }
+
+    const bool thin = m > n;
+    std::vector<T> q = Q[index], u, bottom;
+    if (thin) {
+        u.assign(m, T(0));
+        u[index] = T(1);
+        std::vector<T> coefficients(n, T(0));
+        complement(u, coefficients);
+        q.push_back(u[index]);
+        bottom.assign(n, T(0));
+    }
+
+    for (size_t i = q.size(); i-- > 1;) {
+        T c, s;
+        givens(q[i - 1], q[i], c, s);
+        q[i - 1] = c * q[i - 1] + s * q[i];
+        q[i] = T(0);
+        if (thin && i == n) {
+            rotateWithColumn(u, n - 1, c, -s);  // [Q_{n-1} u] * G, as [u Q_{n-1}] with s negated
+        } else {
+            rotateColumns(i - 1, i, c, s);
+        }
+        if (i - 1 < n) {
+            std::vector<T>& upper = R[i - 1];
+            std::vector<T>& lower = thin && i == n ? bottom : R[i];
+            for (size_t k = i - 1; k < n; ++k) {
+                const T a = upper[k];
+                const T b = lower[k];
+                upper[k] = c * a + s * b;
+                lower[k] = -s * a + c * b;
+            }
+        }
+    }
+
+    for (size_t r = 0; r < m && n > 0; ++r) {
+        std::vector<T>& qr = Q[r];
+        std::rotate(qr.begin(), qr.begin() + 1, qr.end());
+        if (thin) qr.back() = u[r];
+    }
+    for (size_t r = index; r + 1 < m; ++r) {
+        std::swap(Q[r], Q[r + 1]);
+    }
+    Q.resize(m - 1, thin ? n : m - 1);
+    for (size_t r = 0; r + 1 < R.getRows(); ++r) {
+        std::swap(R[r], R[r + 1]);
+    }
+    if (thin) {
+        std::swap(R[n - 1], bottom);
+    } else {
+        R.resize(m - 1, n);
+    }
+}
+
+// [A, a] = [Q q] * [R, Q^T a; 0, rho] with q * rho the part of a outside
+// Q's span (m > n); for m <= n, Q is square and only R gains a column
+template<typename T>
+void QRFactorization<T>::appendColumn(const std::vector<T>& column) {
+    const size_t m = rows();
+    const size_t n = cols();
+    const size_t p = std::min(m, n);
+    if (column.size() != m) {
+        throw std::invalid_argument("Column length must match the factorized matrix");
+    }
+
+    std::vector<T> coefficients(p, T(0));
+    if (m > n) {
+        std::vector<T> q = column;
+        const T rho = complement(q, coefficients);
+        Q.resize(m, p + 1);
+        for (size_t r = 0; r < m; ++r) {
+            Q[r][p] = q[r];
+        }
+        R.resize(p + 1, n + 1);
+        R[p][n] = rho;
+    } else {
+        for (size_t r = 0; r < m; ++r) {
+            const std::vector<T>& qr = Q[r];
+            const T ar = column[r];
+            for (size_t j = 0; j < p; ++j) {
+                coefficients[j] += qr[j] * ar;
+            }
+        }
+        R.resize(p, n + 1);
+    }
+    for (size_t j = 0; j < p; ++j) {
+        R[j][n] = coefficients[j];
+    }
+}
+
+template<typename T>
+void shermanMorrisonUpdate(Matrix<T>& Ainv, const std::vector<T>& u, const std::vector<T>& v) {
+    const size_t n = Ainv.getRows();
+    if (Ainv.getCols() != n) {
+        throw std::invalid_argument("Inverse update requires a square matrix");
+    }
+    if (u.size() != n || v.size() != n) {
+        throw std::invalid_argument("Update vector length must match matrix size");
+    }
+
+    // a = Ainv * u and b^T = v^T * Ainv in one pass over the rows
+    std::vector<T> a(n), b(n, T(0));
+    for (size_t i = 0; i < n; ++i) {
+        const std::vector<T>& row = Ainv[i];
+        T sum = T(0);
+        for (size_t j = 0; j < n; ++j) {
+            sum += row[j] * u[j];
+            b[j] += v[i] * row[j];
+        }
+        a[i] = sum;
+    }
+    T vta = T(0);
+    for (size_t i = 0; i < n; ++i) {
+        vta += v[i] * a[i];
+    }
+    const T denominator = T(1) + vta;
+    if (!(std::abs(denominator) > std::numeric_limits<T>::epsilon() * (T(1) + std::abs(vta)))) {
+        throw std::runtime_error("Sherman-Morrison update makes the matrix singular");
+    }
+
+    // inv(A + u v^T) = Ainv - a b^T / (1 + v^T a)
+    for (size_t i = 0; i < n; ++i) {
+        std::vector<T>& row = Ainv[i];
+        const T factor = a[i] / denominator;
+        for (size_t j = 0; j < n; ++j) {
+            row[j] -= factor * b[j];
+        }
+    }
+}
+
+// inv(A + U C V) = Ainv - (Ainv U) * inv(inv(C) + V Ainv U) * (V Ainv)
+template<typename T>
+void woodburyUpdate(Matrix<T>& Ainv, const Matrix<T>& U, const Matrix<T>& C, const Matrix<T>& V) {
+    const size_t n = Ainv.getRows();
+    const size_t k = C.getRows();
+    if (Ainv.getCols() != n) {
+        throw std::invalid_argument("Inverse update requires a square matrix");
+    }
+    if (C.getCols() != k || U.getRows() != n || U.getCols() != k || V.getRows() != k || V.getCols() != n) {
+        throw std::invalid_argument("Woodbury update needs U n x k, C k x k and V k x n");
+    }
+
+    Matrix<T> AU(n, k);
+    Matrix<T>::gemm(n, k, n, T(1), Ainv, 0, 0, U, 0, 0, AU, 0, 0);
+    Matrix<T> VA(k, n);
+    Matrix<T>::gemm(k, n, n, T(1), V, 0, 0, Ainv, 0, 0, VA, 0, 0);
+
+    Matrix<T> S = C.inverse();
+    Matrix<T>::gemm(k, k, n, T(1), V, 0, 0, AU, 0, 0, S, 0, 0);
+    LUFactorization<T> capacitance(std::move(S));
+    if (capacitance.isSingular()) {
+        throw std::runtime_error("Woodbury update makes the matrix singular");
+    }
+    capacitance.solveInPlace(VA);
+    Matrix<T>::gemm(n, n, k, T(-1), AU, 0, 0, VA, 0, 0, Ainv, 0, 0);
+}
+
+// Shared refinement loop: X_{k+1} = X_k + solve_low(B - A * X_k)
+template<typename Low, typename High, typename Factorization, typename Fallback>
+Matrix<High> iterativeRefinement(const Matrix<High>& A, const Matrix<High>& B,
+                                 const Factorization& factor, RefinementInfo& result,
+                                 size_t maxIterations, Fallback&& fallback) {
+    const High anorm = A.normInf();
+    const High bnorm = B.normInf();
+    const High tolerance = std::sqrt(static_cast<High>(A.getRows())) * std::numeric_limits<High>::epsilon();
+
+    Matrix<Low> correction = B.template cast<Low>();
+    factor.solveInPlace(correction);
+    Matrix<High> X = correction.template cast<High>();
+
+    for (size_t iter = 0; ; ++iter) {
+        Matrix<High> R = B - A * X;
+        const High denominator = anorm * X.normInf() + bnorm;
+        const High rnorm = R.normInf();
+        result.backwardError = static_cast<double>(denominator > High(0) ? rnorm / denominator : rnorm);
+
+        if (!std::isfinite(result.backwardError)) break;
+        if (result.backwardError <= static_cast<double>(tolerance)) {
+            result.converged = true;
+            return X;
+        }
+        if (iter == maxIterations) break;
+
+        correction = R.template cast<Low>();
+        factor.solveInPlace(correction);
+        X += correction.template cast<High>();
+        result.iterations = iter + 1;
+    }
+
+    // Refinement did not converge: solve entirely in high precision
+    result.usedFallback = true;
+    X = fallback();
+    Matrix<High> R = B - A * X;
+    const High denominator = anorm * X.normInf() + bnorm;
+    result.backwardError = static_cast<double>(denominator > High(0) ? R.normInf() / denominator : R.normInf());
+    return X;
+}
+
+template<typename Low, typename High>
+Matrix<High> mixedPrecisionSolve(const Matrix<High>& A, const Matrix<High>& B,
+                                 RefinementInfo* info, size_t maxIterations) {
+    if (A.getRows() != A.getCols()) {
+        throw std::invalid_argument("Solve requires a square coefficient matrix");
+    }
+    if (B.getRows() != A.getRows()) {
+        throw std::invalid_argument("Right-hand side rows must match matrix size");
+    }
+
+    RefinementInfo result;
+    auto fallback = [&]() { return LUFactorization<High>(A).solve(B); };
+
+    Matrix<High> X;
+    if (A.normInf() > static_cast<High>(std::numeric_limits<Low>::max())) {
+        // Entries do not fit in the low-precision type
+        result.usedFallback = true;
+        X = fallback();
+    } else {
+        LUFactorization<Low> factor(A.template cast<Low>());
+        if (factor.isSingular()) {
+            result.usedFallback = true;
+            X = fallback();
+        } else {
+            X = iterativeRefinement<Low, High>(A, B, factor, result, maxIterations, fallback);
+        }
+    }
+
+    if (info) *info = result;
+    return X;
+}
+
+template<typename Low, typename High>
+Matrix<High> mixedPrecisionCholeskySolve(const Matrix<High>& A, const Matrix<High>& B,
+                                         RefinementInfo* info, size_t maxIterations) {
+    if (A.getRows() != A.getCols()) {
+        throw std::invalid_argument("Solve requires a square coefficient matrix");
+    }
+    if (B.getRows() != A.getRows()) {
+        throw std::invalid_argument("Right-hand side rows must match matrix size");
+    }
+
+    RefinementInfo result;
+    auto fallback = [&]() { return CholeskyFactorization<High>(A).solve(B); };
+
+    Matrix<High> X;
+    if (A.normInf() > static_cast<High>(std::numeric_limits<Low>::max())) {
+        result.usedFallback = true;
+        X = fallback();
+    } else {
+        CholeskyFactorization<Low> factor(A.template cast<Low>());
+        if (!factor.isPositiveDefinite()) {
+            result.usedFallback = true;
+            X = fallback();
+        } else {
+            X = iterativeRefinement<Low, High>(A, B, factor, result, maxIterations, fallback);
+        }
+    }
+
+    if (info) *info = result;
+    return X;
+}
@@ -0,0 +1,177 @@
+#pragma once
+#include "Matrix.h"
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+// LU factorization with partial pivoting: P * A = L * U
+// L (unit lower) and U are packed into a single matrix, as in LAPACK's GETRF.
+template<typename T = double>
+class LUFactorization {
+private:
+    Matrix<T> lu;
+    std::vector<size_t> permutation;  // Row i of P * A is row permutation[i] of A
+    int permutationSign;
+    bool singular;
+
+public:
+    LUFactorization() : permutationSign(1), singular(false) {}
+    explicit LUFactorization(const Matrix<T>& A);
+    explicit LUFactorization(Matrix<T>&& A);
+
+    // Factor another matrix in the same object (reuses storage)
+    void refactor(const Matrix<T>& A);
+
+    // Accessors
+    size_t size() const { return lu.getRows(); }
+    bool isSingular() const { return singular; }
+    int getPermutationSign() const { return permutationSign; }
+    const std::vector<size_t>& getPermutation() const { return permutation; }
+    const Matrix<T>& packed() const { return lu; }
+
+    // Unpacked factors
+    Matrix<T> lower() const;
+    Matrix<T> upper() const;
+
+    // Solve A * X = B
+    Matrix<T> solve(const Matrix<T>& B) const;
+    void solveInPlace(Matrix<T>& B) const;
+
+    T determinant() const;
+    std::pair<T, T> logAbsDeterminant() const;  // (sign, log|det|)
+
+    // GETRI-style inverse: inv(A) = inv(U) * inv(L) * P
+    Matrix<T> inverse() const;
+    // The same into `result`, reusing its storage when it is already n x n
+    void inverse(Matrix<T>& result) const;
+
+private:
+    void factorize();
+
+    template<typename U>
+    friend struct TileKernels;
+};
+
+// Cholesky factorization of a symmetric positive definite matrix: A = L * L^T
+// Only the lower triangle of A is read.
+template<typename T = double>
+class CholeskyFactorization {
+private:
+    Matrix<T> L;
+    bool positiveDefinite;
+
+public:
+    explicit CholeskyFactorization(const Matrix<T>& A);
+    explicit CholeskyFactorization(Matrix<T>&& A);
+
+    // Accessors
+    size_t size() const { return L.getRows(); }
+    bool isPositiveDefinite() const { return positiveDefinite; }
+    const Matrix<T>& lower() const { return L; }
+
+    // Solve A * X = B
+    Matrix<T> solve(const Matrix<T>& B) const;
+    void solveInPlace(Matrix<T>& B) const;
+
+    T determinant() const;
+    T logDeterminant() const;  // log(det) = 2 * sum(log(L_ii))
+
+    // inv(A) = inv(L)^T * inv(L)
+    Matrix<T> inverse() const;
+
+    // Refactor A + x * x^T or A - x * x^T in O(n^2) by rotating x into L.
+    // A downdate that would lose positive definiteness throws
+    // std::runtime_error and leaves the factor unchanged.
+    void update(const std::vector<T>& x);
+    void downdate(const std::vector<T>& x);
+
+private:
+    CholeskyFactorization() : positiveDefinite(true) {}
+    void factorize();
+    void rankOneUpdate(const std::vector<T>& x, bool downdating);
+
+    template<typename U>
+    friend struct TileKernels;
+};
+
+// Householder QR factorization in thin form: A = Q * R with Q m x k of
+// orthonormal columns and R k x n upper trapezoidal, k = min(m, n). Rows
+// and columns are added or removed with Givens rotations and at most one
+// Gram-Schmidt step (Golub & Van Loan, 12.5), in O(m * n) each against
+// O(m * n^2) for a new factorization.
+template<typename T = double>
+class QRFactorization {
+private:
+    Matrix<T> Q;
+    Matrix<T> R;
+
+public:
+    QRFactorization() = default;
+    explicit QRFactorization(const Matrix<T>& A);
+
+    // Accessors
+    size_t rows() const { return Q.getRows(); }
+    size_t cols() const { return R.getCols(); }
+    const Matrix<T>& orthogonal() const { return Q; }  // m x min(m, n)
+    const Matrix<T>& upper() const { return R; }
+
+    // Least-squares solution of A * X = B (m >= n, full column rank)
+    Matrix<T> solve(const Matrix<T>& B) const;
+
+    // Refactor A with `row` inserted before row `index` (index == rows()
+    // appends) or with row `index` removed
+    void insertRow(size_t index, const std::vector<T>& row);
+    void deleteRow(size_t index);
+    // Refactor [A, column]
+    void appendColumn(const std::vector<T>& column);
+
+private:
+    void factorize();
+    // Rotation [c s; -s c] that maps (a, b) to (r, 0)
+    static void givens(const T& a, const T& b, T& c, T& s);
+    // Rotates columns j and k of Q: [Q_j Q_k] <- [Q_j Q_k] * [c -s; s c]
+    void rotateColumns(size_t j, size_t k, const T& c, const T& s);
+    // The same with a column x outside Q: [x Q_k] <- [x Q_k] * [c -s; s c]
+    void rotateWithColumn(std::vector<T>& x, size_t k, const T& c, const T& s);
+    // Overwrites x with a unit vector orthogonal to Q's columns, adding Q^T x
+    // to coefficients; returns the norm of x's part outside Q's span, which
+    // is zero when x lies in it (the unit vector is then another one)
+    T complement(std::vector<T>& x, std::vector<T>& coefficients) const;
+
+    template<typename U>
+    friend struct TileKernels;
+};
+
+// Sherman-Morrison: given Ainv = inv(A), overwrites it with inv(A + u * v^T)
+// in O(n^2). Throws std::runtime_error when the update makes A singular.
+template<typename T>
+void shermanMorrisonUpdate(Matrix<T>& Ainv, const std::vector<T>& u, const std::vector<T>& v);
+
+// Woodbury: given Ainv = inv(A), overwrites it with inv(A + U * C * V) for
+// U n x k, C k x k, V k x n, in O(n^2 * k) through gemm and a k x k solve
+template<typename T>
+void woodburyUpdate(Matrix<T>& Ainv, const Matrix<T>& U, const Matrix<T>& C, const Matrix<T>& V);
+
+// Result of a mixed-precision solve
+struct RefinementInfo {
+    size_t iterations = 0;       // Refinement steps performed
+    double backwardError = 0.0;  // Final normwise backward error
+    bool converged = false;      // Backward error target reached in low precision
+    bool usedFallback = false;   // Low-precision refinement failed; solved in high precision
+};
+
+// Mixed-precision iterative refinement (LAPACK DSGESV/DSPOSV style).
+// The O(n^3) factorization runs in Low precision; residuals and the solution
+// are accumulated in High precision until the High-precision backward error
+// ||B - A*X|| / (||A|| * ||X|| + ||B||) drops below sqrt(n) * epsilon.
+template<typename Low = float, typename High = double>
+Matrix<High> mixedPrecisionSolve(const Matrix<High>& A, const Matrix<High>& B,
+                                 RefinementInfo* info = nullptr, size_t maxIterations = 30);
+
+// Same as mixedPrecisionSolve, but factors with Cholesky (A must be SPD)
+template<typename Low = float, typename High = double>
+Matrix<High> mixedPrecisionCholeskySolve(const Matrix<High>& A, const Matrix<High>& B,
+                                         RefinementInfo* info = nullptr, size_t maxIterations = 30);
+
+#include "Solvers.cpp"  // Include implementation for template classes
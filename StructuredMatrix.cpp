@@ -0,0 +1,861 @@
+#include "StructuredMatrix.h"
+#include <cmath>
+
+// ---------------------------------------------------------------------------
+// TriangularMatrix
+// ---------------------------------------------------------------------------
+
+template<typename T>
+TriangularMatrix<T>::TriangularMatrix(size_t size, TriangleType uplo, DiagonalType diag)
+    : data(size * (size + 1) / 2, T(0)), n(size), uplo(uplo), diag(diag) {
+    if (diag == DiagonalType::Unit) {
+        for (size_t i = 0; i < n; ++i) data[rowOffset(i) + (uplo == TriangleType::Upper ? 0 : i)] = T(1);
+    }
+}
+
+template<typename T>
+TriangularMatrix<T>::TriangularMatrix(const Matrix<T>& dense, TriangleType uplo, DiagonalType diag)
+    : TriangularMatrix(dense.getRows(), uplo, diag) {
+    if (dense.getRows() != dense.getCols()) {
+        throw std::invalid_argument("Triangular matrix requires a square matrix");
+    }
+    for (size_t i = 0; i < n; ++i) {
+        const std::vector<T>& source = dense[i];
+        const size_t j_begin = uplo == TriangleType::Upper ? i : 0;
+        const size_t j_end = uplo == TriangleType::Upper ? n : i + 1;
+        for (size_t j = j_begin; j < j_end; ++j) {
+            if (i == j && diag == DiagonalType::Unit) continue;
+            data[rowOffset(i) + j - (uplo == TriangleType::Upper ? i : 0)] = source[j];
+        }
+    }
+}
+
+template<typename T>
+bool TriangularMatrix<T>::isStored(size_t i, size_t j) const {
+    if (i >= n || j >= n) return false;
+    return uplo == TriangleType::Upper ? j >= i : j <= i;
+}
+
+template<typename T>
+T TriangularMatrix<T>::operator()(size_t i, size_t j) const {
+    if (i >= n || j >= n) throw std::out_of_range("Matrix indices out of range");
+    if (!isStored(i, j)) return T(0);
+    if (i == j && diag == DiagonalType::Unit) return T(1);
+    return row(i)[uplo == TriangleType::Upper ? j - i : j];
+}
+
+template<typename T>
+T& TriangularMatrix<T>::operator()(size_t i, size_t j) {
+    if (i >= n || j >= n) throw std::out_of_range("Matrix indices out of range");
+    if (!isStored(i, j) || (i == j && diag == DiagonalType::Unit)) {
+        throw std::out_of_range("Element is outside the stored triangle");
+    }
+    return data[rowOffset(i) + (uplo == TriangleType::Upper ? j - i : j)];
+}
+
+template<typename T>
+Matrix<T> TriangularMatrix<T>::toDense() const {
+    Matrix<T> result(n, n);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            if (isStored(i, j)) result(i, j) = (*this)(i, j);
+        }
+    }
+    return result;
+}
+
+// Row i of the product is a combination of the rows of B in row i's triangle
+template<typename T>
+Matrix<T> TriangularMatrix<T>::multiply(const Matrix<T>& B) const {
+    if (B.getRows() != n) {
+        throw std::invalid_argument("Invalid matrix dimensions for multiplication");
+    }
+
+    const size_t m = B.getCols();
+    const bool isUpper = uplo == TriangleType::Upper;
+    const bool unit = diag == DiagonalType::Unit;
+    Matrix<T> result(n, m);
+    for (size_t i = 0; i < n; ++i) {
+        const T* t_row = row(i);
+        std::vector<T>& out = result[i];
+        const size_t k_begin = isUpper ? i : 0;
+        const size_t k_end = isUpper ? n : i + 1;
+        for (size_t k = k_begin; k < k_end; ++k) {
+            const T a = (k == i && unit) ? T(1) : t_row[isUpper ? k - i : k];
+            if (a == T(0)) continue;
+            const std::vector<T>& b_row = B[k];
+            for (size_t j = 0; j < m; ++j) out[j] += a * b_row[j];
+        }
+    }
+    return result;
+}
+
+template<typename T>
+Matrix<T> TriangularMatrix<T>::rightMultiply(const Matrix<T>& B) const {
+    if (B.getCols() != n) {
+        throw std::invalid_argument("Invalid matrix dimensions for multiplication");
+    }
+
+    const size_t m = B.getRows();
+    const bool isUpper = uplo == TriangleType::Upper;
+    const bool unit = diag == DiagonalType::Unit;
+    Matrix<T> result(m, n);
+    for (size_t r = 0; r < m; ++r) {
+        const std::vector<T>& x = B[r];
+        std::vector<T>& out = result[r];
+        for (size_t k = 0; k < n; ++k) {
+            const T a = x[k];
+            if (a == T(0)) continue;
+            const T* t_row = row(k);
+            if (isUpper) {
+                out[k] += unit ? a : a * t_row[0];
+                for (size_t j = k + 1; j < n; ++j) out[j] += a * t_row[j - k];
+            } else {
+                for (size_t j = 0; j < k; ++j) out[j] += a * t_row[j];
+                out[k] += unit ? a : a * t_row[k];
+            }
+        }
+    }
+    return result;
+}
+
+// Forward (lower) or back (upper) substitution on all right-hand sides at once
+template<typename T>
+Matrix<T> TriangularMatrix<T>::solve(const Matrix<T>& B) const {
+    if (B.getRows() != n) {
+        throw std::invalid_argument("Right-hand side rows must match matrix size");
+    }
+
+    const size_t m = B.getCols();
+    const bool isUpper = uplo == TriangleType::Upper;
+    const bool unit = diag == DiagonalType::Unit;
+    Matrix<T> X = B;
+    for (size_t step = 0; step < n; ++step) {
+        const size_t i = isUpper ? n - 1 - step : step;
+        const T* t_row = row(i);
+        std::vector<T>& xi = X[i];
+        const size_t k_begin = isUpper ? i + 1 : 0;
+        const size_t k_end = isUpper ? n : i;
+        for (size_t k = k_begin; k < k_end; ++k) {
+            const T a = t_row[isUpper ? k - i : k];
+            if (a == T(0)) continue;
+            const std::vector<T>& xk = X[k];
+            for (size_t j = 0; j < m; ++j) xi[j] -= a * xk[j];
+        }
+        if (!unit) {
+            const T d = t_row[isUpper ? 0 : i];
+            if (d == T(0)) {
+                throw std::runtime_error("Matrix is singular and the system cannot be solved");
+            }
+            const T inv_d = T(1) / d;
+            for (size_t j = 0; j < m; ++j) xi[j] *= inv_d;
+        }
+    }
+    return X;
+}
+
+template<typename T>
+T TriangularMatrix<T>::determinant() const {
+    if (diag == DiagonalType::Unit) return T(1);
+
+    T det = T(1);
+    for (size_t i = 0; i < n; ++i) {
+        det *= row(i)[uplo == TriangleType::Upper ? 0 : i];
+    }
+    return det;
+}
+
+template<typename T>
+TriangularMatrix<T> TriangularMatrix<T>::transpose() const {
+    TriangleType flipped = uplo == TriangleType::Upper ? TriangleType::Lower : TriangleType::Upper;
+    TriangularMatrix<T> result(n, flipped, diag);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            if (isStored(i, j) && !(i == j && diag == DiagonalType::Unit)) {
+                result(j, i) = (*this)(i, j);
+            }
+        }
+    }
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+// SymmetricMatrix
+// ---------------------------------------------------------------------------
+
+template<typename T>
+SymmetricMatrix<T>::SymmetricMatrix(size_t size) : data(size * (size + 1) / 2, T(0)), n(size) {}
+
+template<typename T>
+SymmetricMatrix<T>::SymmetricMatrix(const Matrix<T>& dense) : SymmetricMatrix(dense.getRows()) {
+    if (dense.getRows() != dense.getCols()) {
+        throw std::invalid_argument("Symmetric matrix requires a square matrix");
+    }
+    for (size_t i = 0; i < n; ++i) {
+        const std::vector<T>& source = dense[i];
+        std::copy(source.begin(), source.begin() + i + 1, data.begin() + rowOffset(i));
+    }
+}
+
+template<typename T>
+T SymmetricMatrix<T>::operator()(size_t i, size_t j) const {
+    if (i >= n || j >= n) throw std::out_of_range("Matrix indices out of range");
+    return data[index(i, j)];
+}
+
+template<typename T>
+T& SymmetricMatrix<T>::operator()(size_t i, size_t j) {
+    if (i >= n || j >= n) throw std::out_of_range("Matrix indices out of range");
+    return data[index(i, j)];
+}
+
+template<typename T>
+Matrix<T> SymmetricMatrix<T>::toDense() const {
+    Matrix<T> result(n, n);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j <= i; ++j) {
+            result(i, j) = result(j, i) = data[rowOffset(i) + j];
+        }
+    }
+    return result;
+}
+
+// Each packed row i contributes to output row i (lower part) and, by
+// symmetry, to output rows k < i (upper part), so the packed data is read once.
+template<typename T>
+Matrix<T> SymmetricMatrix<T>::multiply(const Matrix<T>& B) const {
+    if (B.getRows() != n) {
+        throw std::invalid_argument("Invalid matrix dimensions for multiplication");
+    }
+
+    const size_t m = B.getCols();
+    Matrix<T> result(n, m);
+    for (size_t i = 0; i < n; ++i) {
+        const T* s_row = data.data() + rowOffset(i);
+        std::vector<T>& out_i = result[i];
+        const std::vector<T>& b_i = B[i];
+        for (size_t k = 0; k < i; ++k) {
+            const T a = s_row[k];
+            if (a == T(0)) continue;
+            const std::vector<T>& b_k = B[k];
+            std::vector<T>& out_k = result[k];
+            for (size_t j = 0; j < m; ++j) {
+                out_i[j] += a * b_k[j];
+                out_k[j] += a * b_i[j];
+            }
+        }
+        const T d = s_row[i];
+        for (size_t j = 0; j < m; ++j) out_i[j] += d * b_i[j];
+    }
+    return result;
+}
+
+template<typename T>
+Matrix<T> SymmetricMatrix<T>::rightMultiply(const Matrix<T>& B) const {
+    if (B.getCols() != n) {
+        throw std::invalid_argument("Invalid matrix dimensions for multiplication");
+    }
+
+    const size_t m = B.getRows();
+    Matrix<T> result(m, n);
+    for (size_t r = 0; r < m; ++r) {
+        const std::vector<T>& x = B[r];
+        std::vector<T>& out = result[r];
+        for (size_t i = 0; i < n; ++i) {
+            const T* s_row = data.data() + rowOffset(i);
+            const T xi = x[i];
+            T sum = xi * s_row[i];
+            for (size_t k = 0; k < i; ++k) {
+                sum += x[k] * s_row[k];
+                out[k] += xi * s_row[k];
+            }
+            out[i] += sum;
+        }
+    }
+    return result;
+}
+
+// Packed row-oriented Cholesky; returns false if not positive definite
+template<typename T>
+bool SymmetricMatrix<T>::choleskyPacked(std::vector<T>& L) const {
+    L = data;
+    for (size_t i = 0; i < n; ++i) {
+        T* l_i = L.data() + rowOffset(i);
+        for (size_t j = 0; j <= i; ++j) {
+            const T* l_j = L.data() + rowOffset(j);
+            T sum = l_i[j];
+            for (size_t k = 0; k < j; ++k) sum -= l_i[k] * l_j[k];
+            if (i == j) {
+                if (!(sum > T(0))) return false;
+                l_i[i] = static_cast<T>(std::sqrt(sum));
+            } else {
+                l_i[j] = sum / l_j[j];
+            }
+        }
+    }
+    return true;
+}
+
+template<typename T>
+Matrix<T> SymmetricMatrix<T>::solve(const Matrix<T>& B) const {
+    if (B.getRows() != n) {
+        throw std::invalid_argument("Right-hand side rows must match matrix size");
+    }
+
+    std::vector<T> L;
+    if (!choleskyPacked(L)) {
+        // Indefinite: fall back to a pivoted LU of the dense form
+        return LUFactorization<T>(toDense()).solve(B);
+    }
+
+    const size_t m = B.getCols();
+    Matrix<T> X = B;
+    // L * Y = B
+    for (size_t i = 0; i < n; ++i) {
+        const T* l_i = L.data() + rowOffset(i);
+        std::vector<T>& xi = X[i];
+        for (size_t k = 0; k < i; ++k) {
+            const std::vector<T>& xk = X[k];
+            for (size_t j = 0; j < m; ++j) xi[j] -= l_i[k] * xk[j];
+        }
+        const T inv_d = T(1) / l_i[i];
+        for (size_t j = 0; j < m; ++j) xi[j] *= inv_d;
+    }
+    // L^T * X = Y
+    for (size_t i = n; i-- > 0;) {
+        const T* l_i = L.data() + rowOffset(i);
+        std::vector<T>& xi = X[i];
+        const T inv_d = T(1) / l_i[i];
+        for (size_t j = 0; j < m; ++j) xi[j] *= inv_d;
+        for (size_t k = 0; k < i; ++k) {
+            std::vector<T>& xk = X[k];
+            for (size_t j = 0; j < m; ++j) xk[j] -= l_i[k] * xi[j];
+        }
+    }
+    return X;
+}
+
+template<typename T>
+T SymmetricMatrix<T>::determinant() const {
+    std::vector<T> L;
+    if (!choleskyPacked(L)) {
+        return LUFactorization<T>(toDense()).determinant();
+    }
+
+    T det = T(1);
+    for (size_t i = 0; i < n; ++i) {
+        const T d = L[rowOffset(i) + i];
+        det *= d * d;
+    }
+    return det;
+}
+
+template<typename T>
+bool SymmetricMatrix<T>::isPositiveDefinite() const {
+    std::vector<T> L;
+    return choleskyPacked(L);
+}
+
+// ---------------------------------------------------------------------------
+// BandedMatrix
+// ---------------------------------------------------------------------------
+
+template<typename T>
+BandedMatrix<T>::BandedMatrix(size_t size, size_t lowerBandwidth, size_t upperBandwidth)
+    : data(size * (lowerBandwidth + upperBandwidth + 1), T(0)), n(size), kl(lowerBandwidth), ku(upperBandwidth) {}
+
+template<typename T>
+BandedMatrix<T>::BandedMatrix(const Matrix<T>& dense, size_t lowerBandwidth, size_t upperBandwidth)
+    : BandedMatrix(dense.getRows(), lowerBandwidth, upperBandwidth) {
+    if (dense.getRows() != dense.getCols()) {
+        throw std::invalid_argument("Banded matrix requires a square matrix");
+    }
+    for (size_t i = 0; i < n; ++i) {
+        const std::vector<T>& source = dense[i];
+        const size_t j_begin = i > kl ? i - kl : 0;
+        const size_t j_end = std::min(n, i + ku + 1);
+        for (size_t j = j_begin; j < j_end; ++j) {
+            data[i * width() + j + kl - i] = source[j];
+        }
+    }
+}
+
+template<typename T>
+T BandedMatrix<T>::operator()(size_t i, size_t j) const {
+    if (i >= n || j >= n) throw std::out_of_range("Matrix indices out of range");
+    if (!isStored(i, j)) return T(0);
+    return data[i * width() + j + kl - i];
+}
+
+template<typename T>
+T& BandedMatrix<T>::operator()(size_t i, size_t j) {
+    if (i >= n || j >= n) throw std::out_of_range("Matrix indices out of range");
+    if (!isStored(i, j)) throw std::out_of_range("Element is outside the stored band");
+    return data[i * width() + j + kl - i];
+}
+
+template<typename T>
+Matrix<T> BandedMatrix<T>::toDense() const {
+    Matrix<T> result(n, n);
+    for (size_t i = 0; i < n; ++i) {
+        const size_t j_begin = i > kl ? i - kl : 0;
+        const size_t j_end = std::min(n, i + ku + 1);
+        for (size_t j = j_begin; j < j_end; ++j) {
+            result(i, j) = data[i * width() + j + kl - i];
+        }
+    }
+    return result;
+}
+
+template<typename T>
+Matrix<T> BandedMatrix<T>::multiply(const Matrix<T>& B) const {
+    if (B.getRows() != n) {
+        throw std::invalid_argument("Invalid matrix dimensions for multiplication");
+    }
+
+    const size_t m = B.getCols();
+    Matrix<T> result(n, m);
+    for (size_t i = 0; i < n; ++i) {
+        const T* band = data.data() + i * width() + kl - i;  // band[j] == a(i, j)
+        std::vector<T>& out = result[i];
+        const size_t k_begin = i > kl ? i - kl : 0;
+        const size_t k_end = std::min(n, i + ku + 1);
+        for (size_t k = k_begin; k < k_end; ++k) {
+            const T a = band[k];
+            if (a == T(0)) continue;
+            const std::vector<T>& b_row = B[k];
+            for (size_t j = 0; j < m; ++j) out[j] += a * b_row[j];
+        }
+    }
+    return result;
+}
+
+template<typename T>
+Matrix<T> BandedMatrix<T>::rightMultiply(const Matrix<T>& B) const {
+    if (B.getCols() != n) {
+        throw std::invalid_argument("Invalid matrix dimensions for multiplication");
+    }
+
+    const size_t m = B.getRows();
+    Matrix<T> result(m, n);
+    for (size_t r = 0; r < m; ++r) {
+        const std::vector<T>& x = B[r];
+        std::vector<T>& out = result[r];
+        for (size_t k = 0; k < n; ++k) {
+            const T a = x[k];
+            if (a == T(0)) continue;
+            const T* band = data.data() + k * width() + kl - k;
+            const size_t j_begin = k > kl ? k - kl : 0;
+            const size_t j_end = std::min(n, k + ku + 1);
+            for (size_t j = j_begin; j < j_end; ++j) out[j] += a * band[j];
+        }
+    }
+    return result;
+}
+
+// Banded LU with partial pivoting (GBTRF-style, row-major). Row interchanges
+// let U fill in up to kl extra super-diagonals, so each working row keeps
+// columns i-kl..i+kl+ku. Interchanges are applied only to the active columns,
+// and the multipliers stay in the row where they were computed, so the
+// solve replays the interchanges step by step.
+template<typename T>
+void BandedMatrix<T>::factorize(std::vector<T>& lu, std::vector<size_t>& pivots, int& sign, bool& singular) const {
+    const size_t w = 2 * kl + ku + 1;
+    lu.assign(n * w, T(0));
+    for (size_t i = 0; i < n; ++i) {
+        std::copy(data.begin() + i * width(), data.begin() + (i + 1) * width(), lu.begin() + i * w);
+    }
+    auto at = [&](size_t i, size_t j) -> T& { return lu[i * w + j + kl - i]; };
+
+    pivots.resize(n);
+    sign = 1;
+    singular = false;
+    for (size_t k = 0; k < n; ++k) {
+        const size_t last = std::min(n - 1, k + kl);
+        size_t pivot_row = k;
+        T pivot_abs = std::abs(at(k, k));
+        for (size_t i = k + 1; i <= last; ++i) {
+            const T candidate = std::abs(at(i, k));
+            if (candidate > pivot_abs) {
+                pivot_abs = candidate;
+                pivot_row = i;
+            }
+        }
+        pivots[k] = pivot_row;
+
+        if (pivot_abs == T(0)) {
+            singular = true;
+            continue;
+        }
+
+        const size_t j_end = std::min(n - 1, k + kl + ku);
+        if (pivot_row != k) {
+            for (size_t j = k; j <= j_end; ++j) std::swap(at(k, j), at(pivot_row, j));
+            sign = -sign;
+        }
+
+        const T inv_pivot = T(1) / at(k, k);
+        for (size_t i = k + 1; i <= last; ++i) {
+            const T factor = at(i, k) * inv_pivot;
+            at(i, k) = factor;
+            if (factor == T(0)) continue;
+            for (size_t j = k + 1; j <= j_end; ++j) at(i, j) -= factor * at(k, j);
+        }
+    }
+}
+
+template<typename T>
+Matrix<T> BandedMatrix<T>::solve(const Matrix<T>& B) const {
+    if (B.getRows() != n) {
+        throw std::invalid_argument("Right-hand side rows must match matrix size");
+    }
+
+    std::vector<T> lu;
+    std::vector<size_t> pivots;
+    int sign;
+    bool singular;
+    factorize(lu, pivots, sign, singular);
+    if (singular) {
+        throw std::runtime_error("Matrix is singular and the system cannot be solved");
+    }
+
+    const size_t w = 2 * kl + ku + 1;
+    auto at = [&](size_t i, size_t j) { return lu[i * w + j + kl - i]; };
+    const size_t m = B.getCols();
+    Matrix<T> X = B;
+
+    // Replay interchanges and apply L
+    for (size_t k = 0; k < n; ++k) {
+        if (pivots[k] != k) std::swap(X[k], X[pivots[k]]);
+        const size_t last = std::min(n - 1, k + kl);
+        const std::vector<T>& xk = X[k];
+        for (size_t i = k + 1; i <= last; ++i) {
+            const T factor = at(i, k);
+            if (factor == T(0)) continue;
+            std::vector<T>& xi = X[i];
+            for (size_t j = 0; j < m; ++j) xi[j] -= factor * xk[j];
+        }
+    }
+
+    // Back substitution with U (bandwidth kl + ku)
+    for (size_t i = n; i-- > 0;) {
+        std::vector<T>& xi = X[i];
+        const size_t k_end = std::min(n - 1, i + kl + ku);
+        for (size_t k = i + 1; k <= k_end; ++k) {
+            const T factor = at(i, k);
+            if (factor == T(0)) continue;
+            const std::vector<T>& xk = X[k];
+            for (size_t j = 0; j < m; ++j) xi[j] -= factor * xk[j];
+        }
+        const T inv_d = T(1) / at(i, i);
+        for (size_t j = 0; j < m; ++j) xi[j] *= inv_d;
+    }
+    return X;
+}
+
+template<typename T>
+T BandedMatrix<T>::determinant() const {
+    std::vector<T> lu;
+    std::vector<size_t> pivots;
+    int sign;
+    bool singular;
+    factorize(lu, pivots, sign, singular);
+    if (singular) return T(0);
+
+    const size_t w = 2 * kl + ku + 1;
+    T det = static_cast<T>(sign);
+    for (size_t i = 0; i < n; ++i) {
+        det *= lu[i * w + kl];
+    }
+    return det;
+}
+
+// ---------------------------------------------------------------------------
+// DiagonalMatrix
+// ---------------------------------------------------------------------------
+
+template<typename T>
+DiagonalMatrix<T>::DiagonalMatrix(const Matrix<T>& dense) : diag(dense.getRows()) {
+    if (dense.getRows() != dense.getCols()) {
+        throw std::invalid_argument("Diagonal matrix requires a square matrix");
+    }
+    for (size_t i = 0; i < diag.size(); ++i) diag[i] = dense(i, i);
+}
+
+template<typename T>
+T DiagonalMatrix<T>::operator()(size_t i, size_t j) const {
+    if (i >= diag.size() || j >= diag.size()) throw std::out_of_range("Matrix indices out of range");
+    return i == j ? diag[i] : T(0);
+}
+
+template<typename T>
+T& DiagonalMatrix<T>::operator[](size_t i) {
+    if (i >= diag.size()) throw std::out_of_range("Diagonal index out of range");
+    return diag[i];
+}
+
+template<typename T>
+const T& DiagonalMatrix<T>::operator[](size_t i) const {
+    if (i >= diag.size()) throw std::out_of_range("Diagonal index out of range");
+    return diag[i];
+}
+
+template<typename T>
+Matrix<T> DiagonalMatrix<T>::toDense() const {
+    Matrix<T> result(diag.size(), diag.size());
+    for (size_t i = 0; i < diag.size(); ++i) result(i, i) = diag[i];
+    return result;
+}
+
+template<typename T>
+Matrix<T> DiagonalMatrix<T>::multiply(const Matrix<T>& B) const {
+    if (B.getRows() != diag.size()) {
+        throw std::invalid_argument("Invalid matrix dimensions for multiplication");
+    }
+
+    Matrix<T> result = B;
+    for (size_t i = 0; i < diag.size(); ++i) {
+        const T d = diag[i];
+        for (T& value : result[i]) value *= d;
+    }
+    return result;
+}
+
+template<typename T>
+Matrix<T> DiagonalMatrix<T>::rightMultiply(const Matrix<T>& B) const {
+    if (B.getCols() != diag.size()) {
+        throw std::invalid_argument("Invalid matrix dimensions for multiplication");
+    }
+
+    Matrix<T> result = B;
+    for (size_t r = 0; r < result.getRows(); ++r) {
+        std::vector<T>& row = result[r];
+        for (size_t j = 0; j < diag.size(); ++j) row[j] *= diag[j];
+    }
+    return result;
+}
+
+template<typename T>
+DiagonalMatrix<T> DiagonalMatrix<T>::multiply(const DiagonalMatrix<T>& other) const {
+    if (other.size() != diag.size()) {
+        throw std::invalid_argument("Invalid matrix dimensions for multiplication");
+    }
+
+    DiagonalMatrix<T> result(diag.size());
+    for (size_t i = 0; i < diag.size(); ++i) result.diag[i] = diag[i] * other.diag[i];
+    return result;
+}
+
+template<typename T>
+Matrix<T> DiagonalMatrix<T>::solve(const Matrix<T>& B) const {
+    if (B.getRows() != diag.size()) {
+        throw std::invalid_argument("Right-hand side rows must match matrix size");
+    }
+    return inverse().multiply(B);
+}
+
+template<typename T>
+DiagonalMatrix<T> DiagonalMatrix<T>::inverse() const {
+    DiagonalMatrix<T> result(diag.size());
+    for (size_t i = 0; i < diag.size(); ++i) {
+        if (diag[i] == T(0)) {
+            throw std::runtime_error("Matrix is singular and cannot be inverted");
+        }
+        result.diag[i] = T(1) / diag[i];
+    }
+    return result;
+}
+
+template<typename T>
+T DiagonalMatrix<T>::determinant() const {
+    T det = T(1);
+    for (const T& d : diag) det *= d;
+    return det;
+}
+
+// ---------------------------------------------------------------------------
+// TridiagonalMatrix
+// ---------------------------------------------------------------------------
+
+template<typename T>
+TridiagonalMatrix<T>::TridiagonalMatrix(size_t size)
+    : lower(size > 0 ? size - 1 : 0, T(0)), diag(size, T(0)), upper(size > 0 ? size - 1 : 0, T(0)) {}
+
+template<typename T>
+TridiagonalMatrix<T>::TridiagonalMatrix(const std::vector<T>& lowerDiag, const std::vector<T>& mainDiag,
+                                        const std::vector<T>& upperDiag)
+    : lower(lowerDiag), diag(mainDiag), upper(upperDiag) {
+    const size_t off = mainDiag.empty() ? 0 : mainDiag.size() - 1;
+    if (lowerDiag.size() != off || upperDiag.size() != off) {
+        throw std::invalid_argument("Off-diagonals must have one element fewer than the diagonal");
+    }
+}
+
+template<typename T>
+TridiagonalMatrix<T>::TridiagonalMatrix(const Matrix<T>& dense) : TridiagonalMatrix(dense.getRows()) {
+    if (dense.getRows() != dense.getCols()) {
+        throw std::invalid_argument("Tridiagonal matrix requires a square matrix");
+    }
+    for (size_t i = 0; i < diag.size(); ++i) {
+        diag[i] = dense(i, i);
+        if (i + 1 < diag.size()) {
+            lower[i] = dense(i + 1, i);
+            upper[i] = dense(i, i + 1);
+        }
+    }
+}
+
+template<typename T>
+T TridiagonalMatrix<T>::operator()(size_t i, size_t j) const {
+    if (i >= diag.size() || j >= diag.size()) throw std::out_of_range("Matrix indices out of range");
+    if (i == j) return diag[i];
+    if (i == j + 1) return lower[j];
+    if (j == i + 1) return upper[i];
+    return T(0);
+}
+
+template<typename T>
+T& TridiagonalMatrix<T>::operator()(size_t i, size_t j) {
+    if (i >= diag.size() || j >= diag.size()) throw std::out_of_range("Matrix indices out of range");
+    if (i == j) return diag[i];
+    if (i == j + 1) return lower[j];
+    if (j == i + 1) return upper[i];
+    throw std::out_of_range("Element is outside the three stored diagonals");
+}
+
+template<typename T>
+Matrix<T> TridiagonalMatrix<T>::toDense() const {
+    const size_t n = diag.size();
+    Matrix<T> result(n, n);
+    for (size_t i = 0; i < n; ++i) {
+        result(i, i) = diag[i];
+        if (i + 1 < n) {
+            result(i + 1, i) = lower[i];
+            result(i, i + 1) = upper[i];
+        }
+    }
+    return result;
+}
+
+template<typename T>
+Matrix<T> TridiagonalMatrix<T>::multiply(const Matrix<T>& B) const {
+    const size_t n = diag.size();
+    if (B.getRows() != n) {
+        throw std::invalid_argument("Invalid matrix dimensions for multiplication");
+    }
+
+    const size_t m = B.getCols();
+    Matrix<T> result(n, m);
+    for (size_t i = 0; i < n; ++i) {
+        std::vector<T>& out = result[i];
+        const std::vector<T>& b_i = B[i];
+        for (size_t j = 0; j < m; ++j) out[j] = diag[i] * b_i[j];
+        if (i > 0) {
+            const std::vector<T>& b_prev = B[i - 1];
+            for (size_t j = 0; j < m; ++j) out[j] += lower[i - 1] * b_prev[j];
+        }
+        if (i + 1 < n) {
+            const std::vector<T>& b_next = B[i + 1];
+            for (size_t j = 0; j < m; ++j) out[j] += upper[i] * b_next[j];
+        }
+    }
+    return result;
+}
+
+template<typename T>
+Matrix<T> TridiagonalMatrix<T>::rightMultiply(const Matrix<T>& B) const {
+    const size_t n = diag.size();
+    if (B.getCols() != n) {
+        throw std::invalid_argument("Invalid matrix dimensions for multiplication");
+    }
+
+    Matrix<T> result(B.getRows(), n);
+    for (size_t r = 0; r < B.getRows(); ++r) {
+        const std::vector<T>& x = B[r];
+        std::vector<T>& out = result[r];
+        for (size_t j = 0; j < n; ++j) {
+            T value = x[j] * diag[j];
+            if (j > 0) value += x[j - 1] * upper[j - 1];
+            if (j + 1 < n) value += x[j + 1] * lower[j];
+            out[j] = value;
+        }
+    }
+    return result;
+}
+
+// LAPACK GTSV: elimination with partial pivoting between adjacent rows;
+// a row interchange creates a second super-diagonal (du2).
+template<typename T>
+Matrix<T> TridiagonalMatrix<T>::solve(const Matrix<T>& B) const {
+    const size_t n = diag.size();
+    if (B.getRows() != n) {
+        throw std::invalid_argument("Right-hand side rows must match matrix size");
+    }
+
+    const size_t m = B.getCols();
+    Matrix<T> X = B;
+    if (n == 0) return X;
+
+    std::vector<T> dl = lower;
+    std::vector<T> d = diag;
+    std::vector<T> du = upper;
+    std::vector<T> du2(n, T(0));
+
+    for (size_t i = 0; i + 1 < n; ++i) {
+        if (std::abs(d[i]) >= std::abs(dl[i])) {
+            if (d[i] == T(0)) {
+                throw std::runtime_error("Matrix is singular and the system cannot be solved");
+            }
+            const T factor = dl[i] / d[i];
+            d[i + 1] -= factor * du[i];
+            std::vector<T>& next = X[i + 1];
+            const std::vector<T>& current = X[i];
+            for (size_t j = 0; j < m; ++j) next[j] -= factor * current[j];
+        } else {
+            const T factor = d[i] / dl[i];
+            d[i] = dl[i];
+            const T temp = d[i + 1];
+            d[i + 1] = du[i] - factor * temp;
+            if (i + 2 < n) {
+                du2[i] = du[i + 1];
+                du[i + 1] = -factor * du2[i];
+            }
+            du[i] = temp;
+            std::swap(X[i], X[i + 1]);
+            std::vector<T>& next = X[i + 1];
+            const std::vector<T>& current = X[i];
+            for (size_t j = 0; j < m; ++j) next[j] -= factor * current[j];
+        }
+    }
+    if (d[n - 1] == T(0)) {
+        throw std::runtime_error("Matrix is singular and the system cannot be solved");
+    }
+
+    for (size_t i = n; i-- > 0;) {
+        std::vector<T>& xi = X[i];
+        if (i + 1 < n) {
+            const std::vector<T>& x1 = X[i + 1];
+            for (size_t j = 0; j < m; ++j) xi[j] -= du[i] * x1[j];
+        }
+        if (i + 2 < n) {
+            const std::vector<T>& x2 = X[i + 2];
+            for (size_t j = 0; j < m; ++j) xi[j] -= du2[i] * x2[j];
+        }
+        const T inv_d = T(1) / d[i];
+        for (size_t j = 0; j < m; ++j) xi[j] *= inv_d;
+    }
+    return X;
+}
+
+// f_i = d_i * f_{i-1} - l_{i-1} * u_{i-1} * f_{i-2}
+template<typename T>
+T TridiagonalMatrix<T>::determinant() const {
+    T previous = T(1);
+    T current = diag.empty() ? T(1) : diag[0];
+    for (size_t i = 1; i < diag.size(); ++i) {
+        const T next = diag[i] * current - lower[i - 1] * upper[i - 1] * previous;
+        previous = current;
+        current = next;
+    }
+    return current;
+}
@@ -0,0 +1,221 @@
+#pragma once
+#include "Matrix.h"
+#include <vector>
+#include <stdexcept>
+
+// Structure-aware square matrices. Each type stores only its nonzero
+// pattern and provides multiply, solve and determinant kernels that run in
+// time proportional to that pattern. Mixing a structured matrix with a
+// dense Matrix<T> in operator* dispatches to the specialized kernel.
+
+// Triangular matrix in packed row-major storage (n(n+1)/2 elements)
+template<typename T = double>
+class TriangularMatrix {
+private:
+    std::vector<T> data;  // Row i holds columns i..n-1 (upper) or 0..i (lower)
+    size_t n;
+    TriangleType uplo;
+    DiagonalType diag;
+
+    size_t rowOffset(size_t i) const {
+        return uplo == TriangleType::Upper ? i * n - i * (i - 1) / 2 : i * (i + 1) / 2;
+    }
+    const T* row(size_t i) const { return data.data() + rowOffset(i); }
+
+public:
+    TriangularMatrix() : n(0), uplo(TriangleType::Upper), diag(DiagonalType::NonUnit) {}
+    TriangularMatrix(size_t size, TriangleType uplo, DiagonalType diag = DiagonalType::NonUnit);
+    TriangularMatrix(const Matrix<T>& dense, TriangleType uplo, DiagonalType diag = DiagonalType::NonUnit);
+
+    // Accessors
+    size_t size() const { return n; }
+    size_t getRows() const { return n; }
+    size_t getCols() const { return n; }
+    TriangleType triangle() const { return uplo; }
+    DiagonalType diagonal() const { return diag; }
+    bool isStored(size_t i, size_t j) const;
+
+    // Element access (the const form returns 0 / 1 outside the stored triangle)
+    T operator()(size_t i, size_t j) const;
+    T& operator()(size_t i, size_t j);
+
+    // Operations
+    Matrix<T> toDense() const;
+    Matrix<T> multiply(const Matrix<T>& B) const;       // this * B
+    Matrix<T> rightMultiply(const Matrix<T>& B) const;  // B * this
+    Matrix<T> solve(const Matrix<T>& B) const;          // this^{-1} * B by substitution
+    T determinant() const;
+    TriangularMatrix transpose() const;
+};
+
+// Symmetric matrix in packed storage (lower triangle, n(n+1)/2 elements)
+template<typename T = double>
+class SymmetricMatrix {
+private:
+    std::vector<T> data;  // Row i holds columns 0..i
+    size_t n;
+
+    static size_t rowOffset(size_t i) { return i * (i + 1) / 2; }
+    size_t index(size_t i, size_t j) const { return i >= j ? rowOffset(i) + j : rowOffset(j) + i; }
+    bool choleskyPacked(std::vector<T>& L) const;
+
+public:
+    SymmetricMatrix() : n(0) {}
+    explicit SymmetricMatrix(size_t size);
+    explicit SymmetricMatrix(const Matrix<T>& dense);  // Reads the lower triangle
+
+    // Accessors
+    size_t size() const { return n; }
+    size_t getRows() const { return n; }
+    size_t getCols() const { return n; }
+
+    // Element access ((i, j) and (j, i) refer to the same element)
+    T operator()(size_t i, size_t j) const;
+    T& operator()(size_t i, size_t j);
+
+    // Operations
+    Matrix<T> toDense() const;
+    Matrix<T> multiply(const Matrix<T>& B) const;       // this * B
+    Matrix<T> rightMultiply(const Matrix<T>& B) const;  // B * this
+    Matrix<T> solve(const Matrix<T>& B) const;          // Packed Cholesky, LU if indefinite
+    T determinant() const;
+    bool isPositiveDefinite() const;
+};
+
+// Banded matrix with kl sub- and ku super-diagonals, row-major band storage
+template<typename T = double>
+class BandedMatrix {
+private:
+    std::vector<T> data;  // Row i holds columns i-kl..i+ku
+    size_t n;
+    size_t kl;
+    size_t ku;
+
+    size_t width() const { return kl + ku + 1; }
+    void factorize(std::vector<T>& lu, std::vector<size_t>& pivots, int& sign, bool& singular) const;
+
+public:
+    BandedMatrix() : n(0), kl(0), ku(0) {}
+    BandedMatrix(size_t size, size_t lowerBandwidth, size_t upperBandwidth);
+    BandedMatrix(const Matrix<T>& dense, size_t lowerBandwidth, size_t upperBandwidth);
+
+    // Accessors
+    size_t size() const { return n; }
+    size_t getRows() const { return n; }
+    size_t getCols() const { return n; }
+    size_t getLowerBandwidth() const { return kl; }
+    size_t getUpperBandwidth() const { return ku; }
+    bool isStored(size_t i, size_t j) const { return i < n && j < n && j + kl >= i && j <= i + ku; }
+
+    // Element access (the const form returns 0 outside the band)
+    T operator()(size_t i, size_t j) const;
+    T& operator()(size_t i, size_t j);
+
+    // Operations
+    Matrix<T> toDense() const;
+    Matrix<T> multiply(const Matrix<T>& B) const;       // this * B
+    Matrix<T> rightMultiply(const Matrix<T>& B) const;  // B * this
+    Matrix<T> solve(const Matrix<T>& B) const;          // Banded LU with partial pivoting, O(n kl (kl + ku))
+    T determinant() const;
+};
+
+// Diagonal matrix
+template<typename T = double>
+class DiagonalMatrix {
+private:
+    std::vector<T> diag;
+
+public:
+    DiagonalMatrix() = default;
+    explicit DiagonalMatrix(size_t size, const T& value = T(0)) : diag(size, value) {}
+    explicit DiagonalMatrix(const std::vector<T>& values) : diag(values) {}
+    explicit DiagonalMatrix(const Matrix<T>& dense);  // Takes the main diagonal
+
+    // Accessors
+    size_t size() const { return diag.size(); }
+    size_t getRows() const { return diag.size(); }
+    size_t getCols() const { return diag.size(); }
+    const std::vector<T>& values() const { return diag; }
+
+    // Element access
+    T operator()(size_t i, size_t j) const;
+    T& operator[](size_t i);
+    const T& operator[](size_t i) const;
+
+    // Operations
+    Matrix<T> toDense() const;
+    Matrix<T> multiply(const Matrix<T>& B) const;       // this * B (row scaling)
+    Matrix<T> rightMultiply(const Matrix<T>& B) const;  // B * this (column scaling)
+    DiagonalMatrix multiply(const DiagonalMatrix& other) const;
+    Matrix<T> solve(const Matrix<T>& B) const;
+    DiagonalMatrix inverse() const;
+    T determinant() const;
+};
+
+// Tridiagonal matrix stored as three diagonals
+template<typename T = double>
+class TridiagonalMatrix {
+private:
+    std::vector<T> lower;  // a(i+1, i), n-1 entries
+    std::vector<T> diag;   // a(i, i), n entries
+    std::vector<T> upper;  // a(i, i+1), n-1 entries
+
+public:
+    TridiagonalMatrix() = default;
+    explicit TridiagonalMatrix(size_t size);
+    TridiagonalMatrix(const std::vector<T>& lowerDiag, const std::vector<T>& mainDiag,
+                      const std::vector<T>& upperDiag);
+    explicit TridiagonalMatrix(const Matrix<T>& dense);
+
+    // Accessors
+    size_t size() const { return diag.size(); }
+    size_t getRows() const { return diag.size(); }
+    size_t getCols() const { return diag.size(); }
+    const std::vector<T>& getLower() const { return lower; }
+    const std::vector<T>& getDiagonal() const { return diag; }
+    const std::vector<T>& getUpper() const { return upper; }
+
+    // Element access (the const form returns 0 off the three diagonals)
+    T operator()(size_t i, size_t j) const;
+    T& operator()(size_t i, size_t j);
+
+    // Operations
+    Matrix<T> toDense() const;
+    Matrix<T> multiply(const Matrix<T>& B) const;       // this * B
+    Matrix<T> rightMultiply(const Matrix<T>& B) const;  // B * this
+    Matrix<T> solve(const Matrix<T>& B) const;          // Gaussian elimination with partial pivoting (GTSV)
+    T determinant() const;                              // Continuant recurrence
+};
+
+// Mixed structured/dense products dispatch to the specialized kernels
+template<typename T>
+Matrix<T> operator*(const TriangularMatrix<T>& A, const Matrix<T>& B) { return A.multiply(B); }
+template<typename T>
+Matrix<T> operator*(const Matrix<T>& A, const TriangularMatrix<T>& B) { return B.rightMultiply(A); }
+template<typename T>
+Matrix<T> operator*(const SymmetricMatrix<T>& A, const Matrix<T>& B) { return A.multiply(B); }
+template<typename T>
+Matrix<T> operator*(const Matrix<T>& A, const SymmetricMatrix<T>& B) { return B.rightMultiply(A); }
+template<typename T>
+Matrix<T> operator*(const BandedMatrix<T>& A, const Matrix<T>& B) { return A.multiply(B); }
+template<typename T>
+Matrix<T> operator*(const Matrix<T>& A, const BandedMatrix<T>& B) { return B.rightMultiply(A); }
+template<typename T>
+Matrix<T> operator*(const DiagonalMatrix<T>& A, const Matrix<T>& B) { return A.multiply(B); }
+template<typename T>
+Matrix<T> operator*(const Matrix<T>& A, const DiagonalMatrix<T>& B) { return B.rightMultiply(A); }
+template<typename T>
+DiagonalMatrix<T> operator*(const DiagonalMatrix<T>& A, const DiagonalMatrix<T>& B) { return A.multiply(B); }
+template<typename T>
+Matrix<T> operator*(const TridiagonalMatrix<T>& A, const Matrix<T>& B) { return A.multiply(B); }
+template<typename T>
+Matrix<T> operator*(const Matrix<T>& A, const TridiagonalMatrix<T>& B) { return B.rightMultiply(A); }
+
+// Typedef for common types
+using TriangularMatrixD = TriangularMatrix<double>;
+using SymmetricMatrixD = SymmetricMatrix<double>;
+using BandedMatrixD = BandedMatrix<double>;
+using DiagonalMatrixD = DiagonalMatrix<double>;
+using TridiagonalMatrixD = TridiagonalMatrix<double>;
+
+#include "StructuredMatrix.cpp"  // Include implementation for template classes
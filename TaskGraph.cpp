@@ -0,0 +1,179 @@
+#include "TaskGraph.h"
+#include <algorithm>
+#include <chrono>
+
+namespace task_graph_detail {
+
+// Ready tasks of one thread. The owner takes from the front, where the
+// tasks it just readied go, highest priority first; thieves take from the
+// back, the oldest and least urgent work.
+struct ReadyQueue {
+    std::mutex mutex;
+    std::deque<size_t> tasks;
+};
+
+}  // namespace task_graph_detail
+
+inline void TaskGraph::depend(size_t before, size_t after) {
+    if (before == after) return;
+    // Every edge added while adding `after` ends in `after`, so a repeat
+    // from the same predecessor is always at the back of its list
+    std::vector<size_t>& successors = nodes[before].successors;
+    if (!successors.empty() && successors.back() == after) return;
+    successors.push_back(after);
+    ++nodes[after].predecessors;
+    ++edges;
+}
+
+inline size_t TaskGraph::add(std::function<void()> kernel, const std::vector<Handle>& reads,
+                             const std::vector<Handle>& writes, int priority) {
+    const size_t id = nodes.size();
+    nodes.push_back(Node{std::move(kernel), priority, 0, {}});
+
+    for (Handle handle : reads) {
+        Access& access = accesses[handle];
+        if (access.writer != SIZE_MAX) depend(access.writer, id);
+        access.readers.push_back(id);
+    }
+    for (Handle handle : writes) {
+        Access& access = accesses[handle];
+        if (access.writer != SIZE_MAX) depend(access.writer, id);
+        for (size_t reader : access.readers) depend(reader, id);
+        access.readers.clear();
+        access.writer = id;
+    }
+    return id;
+}
+
+inline TaskGraphStats TaskGraph::run(unsigned threads) {
+    using Clock = std::chrono::steady_clock;
+    using task_graph_detail::ReadyQueue;
+
+    const size_t count = nodes.size();
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(threads, count)));
+
+    TaskGraphStats stats;
+    stats.tasks = count;
+    stats.dependencies = edges;
+    stats.threads = threads;
+    const Clock::time_point start = Clock::now();
+
+    std::vector<std::atomic<size_t>> pending(count);
+    std::vector<size_t> roots;
+    for (size_t i = 0; i < count; ++i) {
+        pending[i].store(nodes[i].predecessors, std::memory_order_relaxed);
+        if (nodes[i].predecessors == 0) roots.push_back(i);
+    }
+    std::stable_sort(roots.begin(), roots.end(),
+                     [&](size_t a, size_t b) { return nodes[a].priority > nodes[b].priority; });
+
+    std::vector<ReadyQueue> queues(threads);
+    for (size_t r = 0; r < roots.size(); ++r) {
+        queues[r % threads].tasks.push_back(roots[r]);
+    }
+
+    std::atomic<size_t> remaining(count);
+    std::atomic<size_t> ready(roots.size());
+    std::atomic<size_t> steals(0);
+    std::atomic<bool> failed(false);
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::mutex errorMutex;
+    std::exception_ptr error;
+    std::vector<double> busyMs(threads, 0.0);
+
+    auto notify = [&]() {
+        // Taking the mutex orders the state change before a sleeper's check
+        { std::lock_guard<std::mutex> lock(sleepMutex); }
+        wake.notify_all();
+    };
+
+    auto take = [&](unsigned self, size_t& task) {
+        {
+            ReadyQueue& own = queues[self];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty()) {
+                task = own.tasks.front();
+                own.tasks.pop_front();
+                ready.fetch_sub(1);
+                return true;
+            }
+        }
+        for (unsigned offset = 1; offset < threads; ++offset) {
+            ReadyQueue& victim = queues[(self + offset) % threads];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = victim.tasks.back();
+                victim.tasks.pop_back();
+                ready.fetch_sub(1);
+                steals.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    };
+
+    auto worker = [&](unsigned self) {
+        std::vector<size_t> readied;
+        while (!failed.load() && remaining.load() > 0) {
+            size_t task;
+            if (!take(self, task)) {
+                std::unique_lock<std::mutex> lock(sleepMutex);
+                wake.wait(lock, [&]() { return ready.load() > 0 || remaining.load() == 0 || failed.load(); });
+                continue;
+            }
+
+            const Clock::time_point begin = Clock::now();
+            try {
+                nodes[task].kernel();
+            } catch (...) {
+                {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if (!error) error = std::current_exception();
+                }
+                failed.store(true);
+                notify();
+                break;
+            }
+            busyMs[self] += std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+
+            readied.clear();
+            for (size_t successor : nodes[task].successors) {
+                if (pending[successor].fetch_sub(1) == 1) readied.push_back(successor);
+            }
+            if (!readied.empty()) {
+                // Pushed lowest priority first, so the most urgent ends up in front
+                std::stable_sort(readied.begin(), readied.end(),
+                                 [&](size_t a, size_t b) { return nodes[a].priority < nodes[b].priority; });
+                {
+                    ReadyQueue& own = queues[self];
+                    std::lock_guard<std::mutex> lock(own.mutex);
+                    for (size_t successor : readied) own.tasks.push_front(successor);
+                }
+                ready.fetch_add(readied.size());
+                // One readied task is simply this thread's next one
+                if (readied.size() > 1) notify();
+            }
+            if (remaining.fetch_sub(1) == 1) notify();
+        }
+    };
+
+    std::vector<std::thread> helpers;
+    helpers.reserve(threads - 1);
+    for (unsigned t = 1; t < threads; ++t) {
+        helpers.emplace_back(worker, t);
+    }
+    worker(0);
+    for (std::thread& helper : helpers) helper.join();
+
+    stats.steals = steals.load();
+    stats.wallMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    for (double ms : busyMs) stats.busyMs += ms;
+
+    nodes.clear();
+    accesses.clear();
+    edges = 0;
+    if (error) std::rethrow_exception(error);
+    return stats;
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Task-graph (DAG) runtime for tile algorithms.
+//
+// Tasks are added in the order a sequential program would run them, each
+// with the data handles (usually tiles, see tile()) it reads and writes.
+// Dependencies are inferred from those like a superscalar processor does
+// for registers: a read waits for the last writer of the handle, a write
+// waits for the last writer and every reader since. run() then executes
+// the graph on a fixed set of threads, each of which starts the tasks its
+// own completions made ready and steals from the others when it runs dry,
+// so no thread waits at the end of a factorization step while there is
+// ready work anywhere in the graph.
+//
+// Priorities implement lookahead: among ready tasks a thread starts the
+// highest priority first, so the tile algorithms rank the panel of the next
+// step above the bulk of the current trailing update.
+
+struct TaskGraphStats {
+    size_t tasks = 0;
+    size_t dependencies = 0;  // Edges after removing duplicates
+    size_t steals = 0;        // Tasks started by a thread other than the one that readied them
+    unsigned threads = 0;
+    double wallMs = 0.0;
+    double busyMs = 0.0;      // Summed over threads
+
+    // Fraction of thread time spent running tasks
+    double efficiency() const { return wallMs > 0.0 && threads ? busyMs / (wallMs * threads) : 0.0; }
+};
+
+class TaskGraph {
+public:
+    using Handle = uint64_t;
+
+    // Handle of tile (i, j) of the matrix numbered `matrix` in one graph
+    static Handle tile(size_t matrix, size_t i, size_t j) {
+        return (static_cast<Handle>(matrix) << 48) | (static_cast<Handle>(i) << 24) | static_cast<Handle>(j);
+    }
+
+    // Adds a task after everything added before it that touches the same
+    // handles; returns its index
+    size_t add(std::function<void()> kernel, const std::vector<Handle>& reads, const std::vector<Handle>& writes,
+               int priority = 0);
+
+    size_t size() const { return nodes.size(); }
+
+    // Runs every task on `threads` threads (0 = hardware concurrency), the
+    // calling thread included, and empties the graph. The first exception
+    // thrown by a task stops the scheduling of further tasks and is
+    // rethrown once the running ones have finished.
+    TaskGraphStats run(unsigned threads = 0);
+
+private:
+    struct Node {
+        std::function<void()> kernel;
+        int priority;
+        size_t predecessors = 0;
+        std::vector<size_t> successors;
+    };
+    struct Access {
+        size_t writer = SIZE_MAX;
+        std::vector<size_t> readers;  // Since the last write
+    };
+
+    std::vector<Node> nodes;
+    std::unordered_map<Handle, Access> accesses;
+    size_t edges = 0;
+
+    void depend(size_t before, size_t after);
+};
+
+#include "TaskGraph.cpp"  // Include implementation (header-only library)
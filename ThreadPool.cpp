@@ -0,0 +1,99 @@
+#include "ThreadPool.h"
+
+template<typename R>
+bool AsyncTask<R>::cancel() {
+    if (!shared) return false;
+    int expected = QUEUED;
+    if (!shared->state.compare_exchange_strong(expected, CANCELLED)) return false;
+    // The worker that dequeues it sees CANCELLED and leaves the promise alone
+    shared->promise.set_exception(std::make_exception_ptr(TaskCancelled()));
+    return true;
+}
+
+inline ThreadPool::ThreadPool(unsigned threads) : nextSequence(0), running(0), stopping(false) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    workers.reserve(threads);
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([this]() { workerLoop(); });
+    }
+}
+
+inline ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    available.notify_all();
+    for (std::thread& worker : workers) worker.join();
+}
+
+inline ThreadPool& ThreadPool::global() {
+    static ThreadPool pool;
+    return pool;
+}
+
+inline size_t ThreadPool::pending() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return queue.size();
+}
+
+template<typename F>
+auto ThreadPool::submit(F&& task, TaskPriority priority) -> AsyncTask<std::invoke_result_t<std::decay_t<F>>> {
+    using R = std::invoke_result_t<std::decay_t<F>>;
+    using Task = AsyncTask<R>;
+    auto shared = std::make_shared<typename Task::Shared>();
+    Task handle(shared);
+
+    // std::function needs a copyable callable, so the task itself is shared
+    auto body = std::make_shared<std::decay_t<F>>(std::forward<F>(task));
+    enqueue(priority, [shared, body]() {
+        int expected = Task::QUEUED;
+        if (!shared->state.compare_exchange_strong(expected, Task::RUNNING)) return;
+        try {
+            if constexpr (std::is_void_v<R>) {
+                (*body)();
+                shared->promise.set_value();
+            } else {
+                shared->promise.set_value((*body)());
+            }
+        } catch (...) {
+            shared->promise.set_exception(std::current_exception());
+        }
+        shared->state.store(Task::FINISHED);
+    });
+    return handle;
+}
+
+inline void ThreadPool::enqueue(TaskPriority priority, std::function<void()> run) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopping) {
+            throw std::runtime_error("Thread pool is shutting down");
+        }
+        queue.push({static_cast<int>(priority), nextSequence++, std::move(run)});
+    }
+    available.notify_one();
+}
+
+inline void ThreadPool::waitIdle() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this]() { return queue.empty() && running == 0; });
+}
+
+inline void ThreadPool::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        available.wait(lock, [this]() { return stopping || !queue.empty(); });
+        if (queue.empty()) return;  // Stopping and drained
+
+        // priority_queue::top is const; the job is popped right after the move
+        Job job = std::move(const_cast<Job&>(queue.top()));
+        queue.pop();
+        ++running;
+        lock.unlock();
+        job.run();
+        lock.lock();
+        --running;
+        if (queue.empty() && running == 0) idle.notify_all();
+    }
+}
@@ -0,0 +1,118 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Library thread pool for work submitted as whole tasks, e.g. the async
+// kernels of Async.h. Queued tasks start in priority order, first come first
+// served within a priority. The kernels' own row splitting (parallel gemm,
+// syrk, k-NN) keeps using short-lived threads of its own.
+
+enum class TaskPriority { Low = 0, Normal = 1, High = 2 };
+
+// Thrown from AsyncTask::get() of a task that was cancelled before it started
+class TaskCancelled : public std::runtime_error {
+public:
+    TaskCancelled() : std::runtime_error("Task was cancelled before it started") {}
+};
+
+// Handle of a submitted task: a future plus cancellation. Cancellation only
+// prevents a task from starting; a running kernel is not interrupted.
+template<typename R>
+class AsyncTask {
+private:
+    enum State { QUEUED, RUNNING, FINISHED, CANCELLED };
+
+    struct Shared {
+        std::atomic<int> state{QUEUED};
+        std::promise<R> promise;
+    };
+
+    std::shared_ptr<Shared> shared;
+    std::future<R> future;
+
+    explicit AsyncTask(std::shared_ptr<Shared> s) : shared(std::move(s)), future(shared->promise.get_future()) {}
+    friend class ThreadPool;
+
+public:
+    AsyncTask() = default;
+
+    bool valid() const { return future.valid(); }
+    // Result of the task; rethrows its exception, or TaskCancelled
+    R get() { return future.get(); }
+    void wait() const { future.wait(); }
+    template<typename Rep, typename Period>
+    std::future_status waitFor(const std::chrono::duration<Rep, Period>& timeout) const {
+        return future.wait_for(timeout);
+    }
+    // Non-blocking check, for event loops that poll
+    bool ready() const { return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready; }
+
+    // True when the task had not started and now never will
+    bool cancel();
+    bool cancelled() const { return shared && shared->state.load() == CANCELLED; }
+
+    // Shareable future for several consumers (the handle loses its own)
+    std::shared_future<R> share() { return future.share(); }
+};
+
+class ThreadPool {
+public:
+    // 0 threads = hardware concurrency
+    explicit ThreadPool(unsigned threads = 0);
+    // Runs the tasks still queued, then joins the workers
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Process-wide pool used by the async kernels, started on first use
+    static ThreadPool& global();
+
+    unsigned size() const { return static_cast<unsigned>(workers.size()); }
+    size_t pending() const;  // Queued tasks, including cancelled ones not yet dropped
+
+    template<typename F>
+    auto submit(F&& task, TaskPriority priority = TaskPriority::Normal) -> AsyncTask<std::invoke_result_t<std::decay_t<F>>>;
+
+    // Blocks until the queue is empty and no task is running
+    void waitIdle();
+
+private:
+    struct Job {
+        int priority;
+        uint64_t sequence;
+        std::function<void()> run;
+    };
+    struct JobOrder {
+        bool operator()(const Job& a, const Job& b) const {
+            return a.priority != b.priority ? a.priority < b.priority : a.sequence > b.sequence;
+        }
+    };
+
+    std::vector<std::thread> workers;
+    std::priority_queue<Job, std::vector<Job>, JobOrder> queue;
+    mutable std::mutex mutex;
+    std::condition_variable available;
+    std::condition_variable idle;
+    uint64_t nextSequence;
+    size_t running;
+    bool stopping;
+
+    void enqueue(TaskPriority priority, std::function<void()> run);
+    void workerLoop();
+};
+
+#include "ThreadPool.cpp"  // Include implementation (header-only library)
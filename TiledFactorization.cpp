@@ -0,0 +1,476 @@
+#include "TiledFactorization.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+
+namespace tiled_detail {
+
+// Task priorities: the panel, then work feeding the next `lookahead`
+// panels, then the rest of the trailing update, then deferred row swaps
+constexpr int PANEL = 3;
+constexpr int LOOKAHEAD = 2;
+constexpr int UPDATE = 1;
+constexpr int DEFERRED = 0;
+
+constexpr size_t MATRIX_A = 0;
+constexpr size_t MATRIX_Q = 1;
+
+struct NotPositiveDefinite {};
+
+// Tiles (first..last, column) of one matrix
+inline std::vector<TaskGraph::Handle> tileColumn(size_t matrix, size_t first, size_t last, size_t column) {
+    std::vector<TaskGraph::Handle> handles;
+    for (size_t i = first; i < last; ++i) handles.push_back(TaskGraph::tile(matrix, i, column));
+    return handles;
+}
+
+}  // namespace tiled_detail
+
+template<typename T>
+CholeskyFactorization<T> tiledCholesky(Matrix<T> A, const TileOptions& options) {
+    return TileKernels<T>::cholesky(std::move(A), options);
+}
+
+template<typename T>
+LUFactorization<T> tiledLU(Matrix<T> A, const TileOptions& options) {
+    return TileKernels<T>::lu(std::move(A), options);
+}
+
+template<typename T>
+QRFactorization<T> tiledQR(Matrix<T> A, const TileOptions& options) {
+    return TileKernels<T>::qr(std::move(A), options);
+}
+
+template<typename T>
+size_t TileKernels<T>::tileSize(const TileOptions& options) {
+    return options.tileSize ? options.tileSize : Tuning::parameters<T>().luPanel;
+}
+
+template<typename T>
+unsigned TileKernels<T>::threads(const TileOptions& options) {
+    if (options.threads) return options.threads;
+    const unsigned tuned = Tuning::parameters<T>().threads;
+    return tuned ? tuned : std::max(1u, std::thread::hardware_concurrency());
+}
+
+// ---------------------------------------------------------------------------
+// Cholesky
+// ---------------------------------------------------------------------------
+
+template<typename T>
+void TileKernels<T>::potrf(Matrix<T>& A, size_t k0, size_t wk) {
+    for (size_t i = 0; i < wk; ++i) {
+        T* li = A[k0 + i].data() + k0;
+        for (size_t j = 0; j <= i; ++j) {
+            const T* lj = A[k0 + j].data() + k0;
+            T sum = li[j];
+            for (size_t q = 0; q < j; ++q) {
+                sum -= li[q] * lj[q];
+            }
+            if (i == j) {
+                if (!(sum > T(0))) throw tiled_detail::NotPositiveDefinite();
+                li[i] = static_cast<T>(std::sqrt(sum));
+            } else {
+                li[j] = sum / lj[j];
+            }
+        }
+        std::fill(li + i + 1, li + wk, T(0));
+    }
+}
+
+// Each row x of A(i,k) solves L x^T = a^T by forward substitution; the
+// result is also stored transposed in A(k,i), which the strictly upper
+// triangle leaves free, so the GEMM updates need no transposed operand
+template<typename T>
+void TileKernels<T>::trsmLowerTranspose(Matrix<T>& A, size_t k0, size_t wk, size_t i0, size_t wi) {
+    for (size_t r = 0; r < wi; ++r) {
+        T* x = A[i0 + r].data() + k0;
+        for (size_t c = 0; c < wk; ++c) {
+            const T* l = A[k0 + c].data() + k0;
+            T sum = x[c];
+            for (size_t q = 0; q < c; ++q) {
+                sum -= x[q] * l[q];
+            }
+            x[c] = sum / l[c];
+        }
+        for (size_t c = 0; c < wk; ++c) {
+            A[k0 + c][i0 + r] = x[c];
+        }
+    }
+}
+
+template<typename T>
+void TileKernels<T>::syrk(Matrix<T>& A, size_t k0, size_t wk, size_t i0, size_t wi) {
+    Matrix<T>::rankK(TriangleType::Lower, TransposeType::NoTranspose, false, wi, wk, T(-1), A, i0, k0, A, i0, i0, 1);
+}
+
+template<typename T>
+void TileKernels<T>::gemm(Matrix<T>& A, size_t k0, size_t wk, size_t i0, size_t wi, size_t j0, size_t wj) {
+    Matrix<T>::gemmThreads(wi, wj, wk, T(-1), A, i0, k0, A, k0, j0, A, i0, j0, 1);
+}
+
+template<typename T>
+CholeskyFactorization<T> TileKernels<T>::cholesky(Matrix<T>&& A, const TileOptions& options) {
+    using namespace tiled_detail;
+    if (A.getRows() != A.getCols()) {
+        throw std::invalid_argument("Cholesky decomposition requires a square matrix");
+    }
+    LINALG_PROFILE("tiledCholesky", A.getRows(), A.getCols(), double(A.getRows()) * A.getRows() * A.getRows() / 3.0);
+
+    const size_t n = A.getRows();
+    const size_t nb = tileSize(options);
+    const size_t tiles = (n + nb - 1) / nb;
+    const size_t ahead = options.lookahead;
+    auto width = [&](size_t t) { return std::min(nb, n - t * nb); };
+    auto tile = [](size_t i, size_t j) { return TaskGraph::tile(MATRIX_A, i, j); };
+
+    TaskGraph graph;
+    for (size_t k = 0; k < tiles; ++k) {
+        const size_t k0 = k * nb, wk = width(k);
+        graph.add([&A, k0, wk]() { potrf(A, k0, wk); }, {}, {tile(k, k)}, PANEL);
+        for (size_t i = k + 1; i < tiles; ++i) {
+            const size_t i0 = i * nb, wi = width(i);
+            graph.add([&A, k0, wk, i0, wi]() { trsmLowerTranspose(A, k0, wk, i0, wi); },
+                      {tile(k, k)}, {tile(i, k), tile(k, i)}, i <= k + ahead ? LOOKAHEAD : UPDATE);
+        }
+        for (size_t i = k + 1; i < tiles; ++i) {
+            const size_t i0 = i * nb, wi = width(i);
+            for (size_t j = k + 1; j < i; ++j) {
+                const size_t j0 = j * nb, wj = width(j);
+                graph.add([&A, k0, wk, i0, wi, j0, wj]() { gemm(A, k0, wk, i0, wi, j0, wj); },
+                          {tile(i, k), tile(k, j)}, {tile(i, j)}, j <= k + ahead ? LOOKAHEAD : UPDATE);
+            }
+            graph.add([&A, k0, wk, i0, wi]() { syrk(A, k0, wk, i0, wi); },
+                      {tile(i, k)}, {tile(i, i)}, i <= k + ahead ? LOOKAHEAD : UPDATE);
+        }
+    }
+
+    CholeskyFactorization<T> result;
+    try {
+        const TaskGraphStats stats = graph.run(threads(options));
+        if (options.stats) *options.stats = stats;
+    } catch (const NotPositiveDefinite&) {
+        result.positiveDefinite = false;
+    }
+
+    // Clear the transposed copies in the upper triangle
+    for (size_t i = 0; i < n; ++i) {
+        std::fill(A[i].begin() + i + 1, A[i].end(), T(0));
+    }
+    result.L = std::move(A);
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+// LU
+// ---------------------------------------------------------------------------
+
+// Unblocked partial-pivoted elimination restricted to the panel columns;
+// pivots[c] is the row swapped with row c (LAPACK's ipiv)
+template<typename T>
+void TileKernels<T>::getrf(Matrix<T>& A, size_t k0, size_t wk, std::vector<size_t>& pivots, bool& singular) {
+    const size_t n = A.getRows();
+    const size_t k1 = k0 + wk;
+    for (size_t k = k0; k < k1; ++k) {
+        size_t pivot_row = k;
+        T pivot_abs = std::abs(A[k][k]);
+        for (size_t i = k + 1; i < n; ++i) {
+            const T candidate = std::abs(A[i][k]);
+            if (candidate > pivot_abs) {
+                pivot_abs = candidate;
+                pivot_row = i;
+            }
+        }
+        pivots[k] = pivot_row;
+        if (pivot_abs == T(0)) {
+            singular = true;
+            pivots[k] = k;
+            continue;
+        }
+        if (pivot_row != k) {
+            std::swap_ranges(A[k].begin() + k0, A[k].begin() + k1, A[pivot_row].begin() + k0);
+        }
+
+        const T* pivot = A[k].data();
+        const T inv_pivot = T(1) / pivot[k];
+        for (size_t i = k + 1; i < n; ++i) {
+            T* row = A[i].data();
+            const T factor = row[k] * inv_pivot;
+            row[k] = factor;
+            if (factor == T(0)) continue;
+            for (size_t j = k + 1; j < k1; ++j) {
+                row[j] -= factor * pivot[j];
+            }
+        }
+    }
+}
+
+template<typename T>
+void TileKernels<T>::laswp(Matrix<T>& A, size_t k0, size_t wk, const std::vector<size_t>& pivots, size_t j0,
+                           size_t wj) {
+    for (size_t k = k0; k < k0 + wk; ++k) {
+        if (pivots[k] != k) {
+            std::swap_ranges(A[k].begin() + j0, A[k].begin() + j0 + wj, A[pivots[k]].begin() + j0);
+        }
+    }
+}
+
+template<typename T>
+void TileKernels<T>::trsmUnitLower(Matrix<T>& A, size_t k0, size_t wk, size_t j0, size_t wj) {
+    for (size_t i = k0 + 1; i < k0 + wk; ++i) {
+        T* row = A[i].data();
+        for (size_t p = k0; p < i; ++p) {
+            const T factor = row[p];
+            if (factor == T(0)) continue;
+            const T* source = A[p].data();
+            for (size_t j = j0; j < j0 + wj; ++j) {
+                row[j] -= factor * source[j];
+            }
+        }
+    }
+}
+
+template<typename T>
+LUFactorization<T> TileKernels<T>::lu(Matrix<T>&& A, const TileOptions& options) {
+    using namespace tiled_detail;
+    if (A.getRows() != A.getCols()) {
+        throw std::invalid_argument("LU decomposition requires a square matrix");
+    }
+    LINALG_PROFILE("tiledLU", A.getRows(), A.getCols(), 2.0 / 3.0 * A.getRows() * A.getRows() * A.getRows());
+
+    const size_t n = A.getRows();
+    const size_t nb = tileSize(options);
+    const size_t tiles = (n + nb - 1) / nb;
+    const size_t ahead = options.lookahead;
+    auto width = [&](size_t t) { return std::min(nb, n - t * nb); };
+    auto tile = [](size_t i, size_t j) { return TaskGraph::tile(MATRIX_A, i, j); };
+
+    std::vector<size_t> pivots(n);
+    bool singular = false;  // Panels are ordered by their dependencies, so never written concurrently
+
+    TaskGraph graph;
+    for (size_t k = 0; k < tiles; ++k) {
+        const size_t k0 = k * nb, wk = width(k);
+        graph.add([&A, &pivots, &singular, k0, wk]() { getrf(A, k0, wk, pivots, singular); },
+                  {}, tileColumn(MATRIX_A, k, tiles, k), PANEL);
+
+        for (size_t j = k + 1; j < tiles; ++j) {
+            const size_t j0 = j * nb, wj = width(j);
+            const int priority = j <= k + ahead ? LOOKAHEAD : UPDATE;
+            graph.add([&A, &pivots, k0, wk, j0, wj]() {
+                laswp(A, k0, wk, pivots, j0, wj);
+                trsmUnitLower(A, k0, wk, j0, wj);
+            }, {tile(k, k)}, tileColumn(MATRIX_A, k, tiles, j), priority);
+            for (size_t i = k + 1; i < tiles; ++i) {
+                const size_t i0 = i * nb, wi = width(i);
+                graph.add([&A, k0, wk, i0, wi, j0, wj]() { gemm(A, k0, wk, i0, wi, j0, wj); },
+                          {tile(i, k), tile(k, j)}, {tile(i, j)}, priority);
+            }
+        }
+        // The interchanges also apply to the finished L columns on the left;
+        // nothing waits on those
+        for (size_t j = 0; j < k; ++j) {
+            const size_t j0 = j * nb, wj = width(j);
+            graph.add([&A, &pivots, k0, wk, j0, wj]() { laswp(A, k0, wk, pivots, j0, wj); },
+                      {tile(k, k)}, tileColumn(MATRIX_A, k, tiles, j), DEFERRED);
+        }
+    }
+    const TaskGraphStats stats = graph.run(threads(options));
+    if (options.stats) *options.stats = stats;
+
+    LUFactorization<T> result;
+    result.permutation.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        result.permutation[i] = i;
+    }
+    for (size_t k = 0; k < n; ++k) {
+        if (pivots[k] != k) {
+            std::swap(result.permutation[k], result.permutation[pivots[k]]);
+            result.permutationSign = -result.permutationSign;
+        }
+    }
+    result.singular = singular;
+    result.lu = std::move(A);
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+// QR
+// ---------------------------------------------------------------------------
+
+// Householder vectors as in LAPACK's GEQR2 (v(0) = 1, stored below the
+// diagonal, beta on it), then U by the forward columnwise recurrence of
+// LARFT: U(0:c, c) = -tau_c * U(0:c, 0:c) * V(:, 0:c)^T * v_c
+template<typename T>
+void TileKernels<T>::geqrt(Matrix<T>& A, size_t k0, size_t count, BlockReflector& block) {
+    const size_t m = A.getRows();
+    const size_t rows = m - k0;
+    std::vector<T> tau(count, T(0));
+    std::vector<T> w(count);
+
+    for (size_t c = 0; c < count; ++c) {
+        const size_t col = k0 + c;
+        T norm2 = T(0);
+        for (size_t i = col + 1; i < m; ++i) {
+            norm2 += A[i][col] * A[i][col];
+        }
+        if (norm2 == T(0)) continue;  // H = I
+
+        const T alpha = A[col][col];
+        const T beta = alpha >= T(0) ? -static_cast<T>(std::sqrt(alpha * alpha + norm2))
+                                     : static_cast<T>(std::sqrt(alpha * alpha + norm2));
+        tau[c] = (beta - alpha) / beta;
+        const T scale = T(1) / (alpha - beta);
+        for (size_t i = col + 1; i < m; ++i) {
+            A[i][col] *= scale;
+        }
+        A[col][col] = beta;
+
+        // Remaining panel columns: w = v^T A, A -= tau * v * w^T
+        const size_t rest = count - c - 1;
+        if (rest == 0) continue;
+        const T* top = A[col].data() + col + 1;
+        std::copy(top, top + rest, w.begin());
+        for (size_t i = col + 1; i < m; ++i) {
+            const T* row = A[i].data();
+            const T v = row[col];
+            for (size_t j = 0; j < rest; ++j) {
+                w[j] += v * row[col + 1 + j];
+            }
+        }
+        T* topw = A[col].data() + col + 1;
+        for (size_t j = 0; j < rest; ++j) {
+            topw[j] -= tau[c] * w[j];
+        }
+        for (size_t i = col + 1; i < m; ++i) {
+            T* row = A[i].data();
+            const T factor = tau[c] * row[col];
+            for (size_t j = 0; j < rest; ++j) {
+                row[col + 1 + j] -= factor * w[j];
+            }
+        }
+    }
+
+    block.V = Matrix<T>(rows, count);
+    block.Vt = Matrix<T>(count, rows);
+    for (size_t r = 0; r < rows; ++r) {
+        const T* source = A[k0 + r].data() + k0;
+        T* target = block.V[r].data();
+        for (size_t c = 0; c < count && c <= r; ++c) {
+            const T value = c == r ? T(1) : source[c];
+            target[c] = value;
+            block.Vt[c][r] = value;
+        }
+    }
+
+    block.U = Matrix<T>(count, count);
+    std::vector<T> z(count);
+    for (size_t c = 0; c < count; ++c) {
+        block.U[c][c] = tau[c];
+        if (c == 0 || tau[c] == T(0)) continue;
+        // z = V(:, 0:c)^T * v_c, with v_c zero above row c
+        for (size_t q = 0; q < c; ++q) {
+            const T* vq = block.Vt[q].data();
+            const T* vc = block.Vt[c].data();
+            T sum = T(0);
+            for (size_t r = c; r < rows; ++r) {
+                sum += vq[r] * vc[r];
+            }
+            z[q] = sum;
+        }
+        for (size_t q = 0; q < c; ++q) {
+            const T* uq = block.U[q].data();
+            T sum = T(0);
+            for (size_t p = q; p < c; ++p) {
+                sum += uq[p] * z[p];
+            }
+            block.U[q][c] = -tau[c] * sum;
+        }
+    }
+    block.Ut = block.U.transpose();
+}
+
+// H^T X = X - V U^T (V^T X) and H X = X - V U (V^T X) on rows k0.. of X
+template<typename T>
+void TileKernels<T>::applyReflector(const BlockReflector& block, bool transpose, Matrix<T>& X, size_t k0, size_t c0,
+                                    size_t wc) {
+    const size_t rows = block.V.getRows();
+    const size_t count = block.V.getCols();
+    if (count == 0 || wc == 0) return;
+    Matrix<T> W(count, wc);
+    Matrix<T>::gemmThreads(count, wc, rows, T(1), block.Vt, 0, 0, X, k0, c0, W, 0, 0, 1);
+    if (transpose) {
+        Matrix<T>::trmm(MatrixSide::Left, TriangleType::Lower, DiagonalType::NonUnit, count, wc, block.Ut, 0, 0, W, 0, 0);
+    } else {
+        Matrix<T>::trmm(MatrixSide::Left, TriangleType::Upper, DiagonalType::NonUnit, count, wc, block.U, 0, 0, W, 0, 0);
+    }
+    Matrix<T>::gemmThreads(rows, wc, count, T(-1), block.V, 0, 0, W, 0, 0, X, k0, c0, 1);
+}
+
+// Factorization graph, then the graph forming the thin
+// Q = H_0 H_1 ... H_{p-1} * [I; 0] from the last block backwards; block k
+// leaves columns left of its first row untouched, so it only updates Q's
+// tile columns from k on
+template<typename T>
+QRFactorization<T> TileKernels<T>::qr(Matrix<T>&& A, const TileOptions& options) {
+    using namespace tiled_detail;
+    const size_t m = A.getRows();
+    const size_t n = A.getCols();
+    LINALG_PROFILE("tiledQR", m, n, 4.0 * m * m * n);
+
+    const size_t nb = tileSize(options);
+    const size_t K = std::min(m, n);
+    const size_t steps = (K + nb - 1) / nb;
+    const size_t rowTiles = (m + nb - 1) / nb;
+    const size_t colTiles = (n + nb - 1) / nb;
+    const size_t ahead = options.lookahead;
+
+    QRFactorization<T> result;
+    result.Q = Matrix<T>(m, K);
+    for (size_t i = 0; i < K; ++i) {
+        result.Q[i][i] = T(1);
+    }
+    Matrix<T>& Q = result.Q;
+    std::vector<BlockReflector> blocks(steps);
+
+    TaskGraph graph;
+    for (size_t k = 0; k < steps; ++k) {
+        const size_t k0 = k * nb;
+        const size_t count = std::min(nb, K - k0);
+        const std::vector<TaskGraph::Handle> panel = tileColumn(MATRIX_A, k, rowTiles, k);
+        BlockReflector& block = blocks[k];
+        graph.add([&A, &block, k0, count]() { geqrt(A, k0, count, block); }, {}, panel, PANEL);
+
+        // Columns of the panel's tile column beyond the reflectors (m < n only)
+        const size_t panelEnd = std::min(n, k0 + nb);
+        if (k0 + count < panelEnd) {
+            graph.add([&A, &block, k0, count, panelEnd]() {
+                applyReflector(block, true, A, k0, k0 + count, panelEnd - k0 - count);
+            }, {}, panel, PANEL);
+        }
+        for (size_t j = k + 1; j < colTiles; ++j) {
+            const size_t j0 = j * nb, wj = std::min(nb, n - j0);
+            graph.add([&A, &block, k0, j0, wj]() { applyReflector(block, true, A, k0, j0, wj); },
+                      panel, tileColumn(MATRIX_A, k, rowTiles, j), j <= k + ahead ? LOOKAHEAD : UPDATE);
+        }
+    }
+    for (size_t k = steps; k-- > 0;) {
+        const size_t k0 = k * nb;
+        const BlockReflector& block = blocks[k];
+        for (size_t j = k; j < steps; ++j) {
+            const size_t j0 = j * nb, wj = std::min(nb, K - j0);
+            graph.add([&Q, &block, k0, j0, wj]() { applyReflector(block, false, Q, k0, j0, wj); },
+                      tileColumn(MATRIX_A, k, rowTiles, k), tileColumn(MATRIX_Q, k, rowTiles, j), DEFERRED);
+        }
+    }
+    const TaskGraphStats stats = graph.run(threads(options));
+    if (options.stats) *options.stats = stats;
+
+    for (size_t i = 1; i < m; ++i) {
+        std::fill(A[i].begin(), A[i].begin() + std::min(i, n), T(0));
+    }
+    result.R = std::move(A);
+    result.R.resize(K, n);
+    return result;
+}
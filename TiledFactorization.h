@@ -0,0 +1,76 @@
+#pragma once
+#include "Matrix.h"
+#include "TaskGraph.h"
+#include <vector>
+
+// Tile-based Cholesky, LU and QR run as task graphs (TaskGraph.h).
+//
+// The matrix is split into square tiles and every factorization step
+// becomes a set of tile kernels: POTRF/TRSM/SYRK/GEMM for Cholesky, a panel
+// GETRF with row interchanges plus TRSM/GEMM for LU, and a panel GEQRT with
+// block reflector applications for QR. The runtime starts each kernel as
+// soon as the tiles it reads are final, so the next panel is factored while
+// the current trailing update is still running instead of after a barrier,
+// and `lookahead` steps of panel-side work outrank the rest.
+//
+// Results are the library's usual factorization objects and agree with the
+// sequential ones to rounding. Pivoting and reflectors span whole tile
+// columns (as LAPACK's, not the incremental pivoting of tile LU), so LU and
+// QR tasks that touch a panel column cover all of its tiles below the
+// diagonal; Cholesky is fully tile-granular. Factorizations are real-only.
+struct TileOptions {
+    size_t tileSize = 0;               // 0 = KernelTuning::luPanel
+    unsigned threads = 0;              // 0 = KernelTuning::threads, else hardware concurrency
+    size_t lookahead = 1;              // Steps ahead whose tasks outrank the trailing update
+    TaskGraphStats* stats = nullptr;   // Receives the run's statistics when set
+};
+
+template<typename T>
+CholeskyFactorization<T> tiledCholesky(Matrix<T> A, const TileOptions& options = TileOptions());
+
+template<typename T>
+LUFactorization<T> tiledLU(Matrix<T> A, const TileOptions& options = TileOptions());
+
+template<typename T>
+QRFactorization<T> tiledQR(Matrix<T> A, const TileOptions& options = TileOptions());
+
+// Tile kernels and graph builders; a friend of Matrix and the factorization
+// classes so that kernels run single-threaded on sub-blocks in place
+template<typename T>
+struct TileKernels {
+    static CholeskyFactorization<T> cholesky(Matrix<T>&& A, const TileOptions& options);
+    static LUFactorization<T> lu(Matrix<T>&& A, const TileOptions& options);
+    static QRFactorization<T> qr(Matrix<T>&& A, const TileOptions& options);
+
+private:
+    // Compact WY form of the reflectors of one QR panel: H = I - V * U * V^T
+    // with V unit lower trapezoidal (rows k0.. of the matrix) and U upper
+    // triangular; Vt and Ut are their transposes, kept for gemm and trmm
+    struct BlockReflector {
+        Matrix<T> V, Vt, U, Ut;
+    };
+
+    // Cholesky: A(k,k) = L L^T; A(i,k) <- A(i,k) L^-T, mirrored into A(k,i);
+    // A(i,i) -= A(i,k) A(i,k)^T; A(i,j) -= A(i,k) A(k,j)
+    static void potrf(Matrix<T>& A, size_t k0, size_t wk);
+    static void trsmLowerTranspose(Matrix<T>& A, size_t k0, size_t wk, size_t i0, size_t wi);
+    static void syrk(Matrix<T>& A, size_t k0, size_t wk, size_t i0, size_t wi);
+    static void gemm(Matrix<T>& A, size_t k0, size_t wk, size_t i0, size_t wi, size_t j0, size_t wj);
+
+    // LU: partial-pivoted panel of columns [k0, k0 + wk); the panel's row
+    // interchanges applied to columns [j0, j0 + wj); U(k,j) = L(k,k)^-1 A(k,j)
+    static void getrf(Matrix<T>& A, size_t k0, size_t wk, std::vector<size_t>& pivots, bool& singular);
+    static void laswp(Matrix<T>& A, size_t k0, size_t wk, const std::vector<size_t>& pivots, size_t j0, size_t wj);
+    static void trsmUnitLower(Matrix<T>& A, size_t k0, size_t wk, size_t j0, size_t wj);
+
+    // QR: Householder panel of `count` columns from k0; X(k0:, c0:c0+wc) <-
+    // H^T X (transpose) or H X
+    static void geqrt(Matrix<T>& A, size_t k0, size_t count, BlockReflector& block);
+    static void applyReflector(const BlockReflector& block, bool transpose, Matrix<T>& X, size_t k0, size_t c0,
+                               size_t wc);
+
+    static size_t tileSize(const TileOptions& options);
+    static unsigned threads(const TileOptions& options);
+};
+
+#include "TiledFactorization.cpp"  // Include implementation (header-only library)
@@ -0,0 +1,242 @@
+#include "Tuning.h"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+inline void KernelTuning::validate() const {
+    if (gemmBlockK == 0 || gemmBlockN == 0) {
+        throw std::invalid_argument("gemm block sizes must be positive");
+    }
+    if (gemmMicroRows != 1 && gemmMicroRows != 2 && gemmMicroRows != 4) {
+        throw std::invalid_argument("gemm micro-kernel rows must be 1, 2 or 4");
+    }
+    if (recursionCutoff == 0 || luPanel == 0) {
+        throw std::invalid_argument("Recursion cutoff and LU panel width must be positive");
+    }
+    if (strassenCutoff == 1) {
+        throw std::invalid_argument("Strassen cutoff must be 0 (off) or at least 2");
+    }
+    if (!(parallelMinFlops >= 0.0)) {
+        throw std::invalid_argument("Parallel flop threshold must be non-negative");
+    }
+}
+
+template<typename T>
+KernelTuning& Tuning::parameters() {
+    if constexpr (TuningType<T>::name == nullptr) {
+        static KernelTuning defaults;
+        return defaults;
+    } else {
+        // std::map references stay valid, so the lookup happens once per type
+        static KernelTuning& tuning = parameters(TuningType<T>::name);
+        return tuning;
+    }
+}
+
+inline KernelTuning& Tuning::parameters(const std::string& dtype) {
+    State& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return s.table[dtype];
+}
+
+inline std::string Tuning::defaultPath() {
+    if (const char* path = std::getenv("LINALG_TUNING_FILE")) return path;
+    const char* home = std::getenv("HOME");
+    return std::string(home ? home : ".") + "/.linalg_tuning.conf";
+}
+
+inline const std::string& Tuning::hostCpu() {
+    static const std::string model = []() {
+        std::ifstream cpuinfo("/proc/cpuinfo");
+        std::string line;
+        while (std::getline(cpuinfo, line)) {
+            if (line.compare(0, 10, "model name") == 0) {
+                const size_t colon = line.find(':');
+                if (colon != std::string::npos && colon + 1 < line.size()) {
+                    return line.substr(line.find_first_not_of(" \t", colon + 1));
+                }
+            }
+        }
+        return std::string("unknown");
+    }();
+    return model;
+}
+
+namespace tuning_detail {
+
+// Tuning files are INI-like:
+//
+//   [Intel(R) Xeon(R) Gold 6248 CPU @ 2.50GHz | double]
+//   gemm_block_k = 128
+//   ...
+//
+// Each section is kept as its header and raw lines so that saving can pass
+// other hosts' sections through unchanged.
+struct Section {
+    std::string cpu;
+    std::string dtype;
+    std::vector<std::string> lines;
+};
+
+inline std::string trim(const std::string& text) {
+    const size_t begin = text.find_first_not_of(" \t\r");
+    if (begin == std::string::npos) return "";
+    const size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(begin, end - begin + 1);
+}
+
+inline std::vector<Section> readSections(std::istream& is, const std::string& path) {
+    std::vector<Section> sections;
+    std::string line;
+    size_t number = 0;
+    while (std::getline(is, line)) {
+        ++number;
+        const std::string text = trim(line);
+        if (text.empty() || text[0] == '#') continue;
+        if (text.front() == '[') {
+            const size_t bar = text.rfind('|');
+            if (text.back() != ']' || bar == std::string::npos) {
+                throw std::runtime_error(path + ":" + std::to_string(number) + ": expected [cpu | dtype]");
+            }
+            sections.push_back({trim(text.substr(1, bar - 1)), trim(text.substr(bar + 1, text.size() - bar - 2)), {}});
+        } else if (sections.empty()) {
+            throw std::runtime_error(path + ":" + std::to_string(number) + ": setting outside a section");
+        } else {
+            sections.back().lines.push_back(text);
+        }
+    }
+    return sections;
+}
+
+inline void apply(KernelTuning& tuning, const std::string& line) {
+    const size_t equals = line.find('=');
+    if (equals == std::string::npos) {
+        throw std::runtime_error("expected key = value, got '" + line + "'");
+    }
+    const std::string key = trim(line.substr(0, equals));
+    const std::string value = trim(line.substr(equals + 1));
+    std::istringstream parser(value);
+    auto read = [&](auto& field) {
+        if (!(parser >> field) || !parser.eof()) {
+            throw std::runtime_error("invalid value '" + value + "' for " + key);
+        }
+    };
+    if (key == "gemm_block_k") read(tuning.gemmBlockK);
+    else if (key == "gemm_block_n") read(tuning.gemmBlockN);
+    else if (key == "gemm_micro_rows") read(tuning.gemmMicroRows);
+    else if (key == "recursion_cutoff") read(tuning.recursionCutoff);
+    else if (key == "lu_panel") read(tuning.luPanel);
+    else if (key == "strassen_cutoff") read(tuning.strassenCutoff);
+    else if (key == "parallel_min_flops") read(tuning.parallelMinFlops);
+    else if (key == "parallel_min_elements") read(tuning.parallelMinElements);
+    else if (key == "threads") read(tuning.threads);
+    else throw std::runtime_error("unknown setting '" + key + "'");
+}
+
+inline void write(std::ostream& os, const KernelTuning& tuning) {
+    os << "gemm_block_k = " << tuning.gemmBlockK << "\n"
+       << "gemm_block_n = " << tuning.gemmBlockN << "\n"
+       << "gemm_micro_rows = " << tuning.gemmMicroRows << "\n"
+       << "recursion_cutoff = " << tuning.recursionCutoff << "\n"
+       << "lu_panel = " << tuning.luPanel << "\n"
+       << "strassen_cutoff = " << tuning.strassenCutoff << "\n"
+       << "parallel_min_flops = " << tuning.parallelMinFlops << "\n"
+       << "parallel_min_elements = " << tuning.parallelMinElements << "\n"
+       << "threads = " << tuning.threads << "\n";
+}
+
+// Parameters of this host's sections of a tuning file, validated; false
+// when the file does not exist
+inline bool readHostSections(const std::string& path, std::map<std::string, KernelTuning>& result) {
+    std::ifstream file(path);
+    if (!file) return false;
+    for (const Section& section : readSections(file, path)) {
+        if (section.cpu != Tuning::hostCpu()) continue;
+        KernelTuning tuning;
+        try {
+            for (const std::string& line : section.lines) apply(tuning, line);
+            tuning.validate();
+        } catch (const std::exception& error) {
+            throw std::runtime_error(path + ": [" + section.cpu + " | " + section.dtype + "]: " + error.what());
+        }
+        result[section.dtype] = tuning;
+    }
+    return true;
+}
+
+}  // namespace tuning_detail
+
+// The default tuning file is read once, when the first kernel asks for its
+// parameters. A broken file must not make every computation fail, so it is
+// reported and the defaults are kept.
+inline Tuning::State::State() {
+    for (const char* dtype : {"float", "double", "complex<float>", "complex<double>"}) table[dtype];
+    const std::string path = defaultPath();
+    if (path.empty()) return;
+    std::map<std::string, KernelTuning> loaded;
+    try {
+        tuning_detail::readHostSections(path, loaded);
+    } catch (const std::exception& error) {
+        std::cerr << "Warning: ignoring tuning file: " << error.what() << std::endl;
+        return;
+    }
+    for (const auto& entry : loaded) table[entry.first] = entry.second;
+}
+
+inline Tuning::State& Tuning::state() {
+    static State instance;
+    return instance;
+}
+
+inline bool Tuning::load(const std::string& path) {
+    // Parse and validate everything before touching the live parameters
+    std::map<std::string, KernelTuning> updates;
+    if (!tuning_detail::readHostSections(path, updates)) return false;
+
+    State& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    for (const auto& entry : updates) s.table[entry.first] = entry.second;
+    return true;
+}
+
+inline void Tuning::save(const std::string& path) {
+    using namespace tuning_detail;
+    std::vector<Section> kept;
+    {
+        std::ifstream existing(path);
+        if (existing) {
+            for (Section& section : readSections(existing, path)) {
+                if (section.cpu != hostCpu()) kept.push_back(std::move(section));
+            }
+        }
+    }
+
+    std::ofstream file(path);
+    if (!file) {
+        throw std::runtime_error("Cannot open file for writing: " + path);
+    }
+    file << "# linalg kernel tuning, written by 'linalg tune'. One section per CPU model\n"
+         << "# and element type; a run only uses the sections of its own CPU.\n";
+    for (const Section& section : kept) {
+        file << "\n[" << section.cpu << " | " << section.dtype << "]\n";
+        for (const std::string& line : section.lines) file << line << "\n";
+    }
+
+    State& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    for (const auto& entry : s.table) {
+        file << "\n[" << hostCpu() << " | " << entry.first << "]\n";
+        write(file, entry.second);
+    }
+    if (!file) {
+        throw std::runtime_error("Failed writing tuning file: " + path);
+    }
+}
+
+inline void Tuning::reset() {
+    State& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    for (auto& entry : s.table) entry.second = KernelTuning();
+}
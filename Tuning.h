@@ -0,0 +1,71 @@
+#pragma once
+#include <complex>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Host-specific kernel parameters, one set per element type.
+//
+// The defaults reproduce the former compile-time constants. Running
+// PerformanceBenchmark::autotune() (linalg tune) measures better values on
+// the current host and saves them to the tuning file, which is read on the
+// first kernel call of every later run. The file holds one section per CPU
+// model and element type, so a single file can be shared by machines of
+// different generations; only the sections of the running CPU are used.
+struct KernelTuning {
+    size_t gemmBlockK = 64;         // Rows of B (depth) per gemm cache block
+    size_t gemmBlockN = 256;        // Columns of B and C per gemm cache block
+    size_t gemmMicroRows = 1;       // Rows of C updated per pass over a row of B (1, 2 or 4)
+    size_t recursionCutoff = 64;    // trmm / trtri / U*L recurse above this size
+    size_t luPanel = 64;            // Panel width of blocked LU
+    size_t strassenCutoff = 0;      // operator* uses Strassen when every dimension is >= this (0 = never)
+    double parallelMinFlops = 0.0;  // gemm splits rows across threads from this many flops (0 = never)
+    size_t parallelMinElements = 262144;  // Element-wise ops and reductions go parallel from this many elements (0 = never)
+    unsigned threads = 0;           // Threads for parallel gemm and element-wise loops (0 = hardware concurrency)
+
+    // Throws std::invalid_argument when a value would break a kernel
+    void validate() const;
+};
+
+// Section name of an element type in the tuning file; types without one
+// always use the defaults
+template<typename T> struct TuningType { static constexpr const char* name = nullptr; };
+template<> struct TuningType<float> { static constexpr const char* name = "float"; };
+template<> struct TuningType<double> { static constexpr const char* name = "double"; };
+template<> struct TuningType<std::complex<float>> { static constexpr const char* name = "complex<float>"; };
+template<> struct TuningType<std::complex<double>> { static constexpr const char* name = "complex<double>"; };
+
+class Tuning {
+public:
+    // Parameters used by the kernels for T. Loads the tuning file on first use.
+    template<typename T>
+    static KernelTuning& parameters();
+    static KernelTuning& parameters(const std::string& dtype);
+
+    // $LINALG_TUNING_FILE if set (empty disables loading), else ~/.linalg_tuning.conf
+    static std::string defaultPath();
+    // "model name" of /proc/cpuinfo, "unknown" elsewhere
+    static const std::string& hostCpu();
+
+    // Applies this host's sections of the file; returns false when the file
+    // does not exist. Throws std::runtime_error on malformed content.
+    static bool load(const std::string& path);
+    // Writes the current parameters as this host's sections, keeping the
+    // sections of other CPUs already in the file
+    static void save(const std::string& path);
+
+    // Back to the built-in defaults for every type
+    static void reset();
+
+private:
+    struct State {
+        std::mutex mutex;
+        std::map<std::string, KernelTuning> table;
+        State();
+    };
+    static State& state();
+};
+
+#include "Tuning.cpp"  // Include implementation (header-only library)
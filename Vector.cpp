@@ -1,144 +1,197 @@
 #include "Vector.h"
-#include <random>
 #include <iomanip>
 
 // Addition operator
 template<typename T>
-Vector<T> Vector<T>::operator+(const Vector<T>& other) const {
+Vector<T> Vector<T>::operator+(const Vector<T>& other) const & {
+    LINALG_PROFILE("Vector::add", dimension, 1, double(dimension), 3.0 * dimension * sizeof(T));
     if (dimension != other.dimension) {
         throw std::invalid_argument("Vector dimensions must match for addition");
     }
     
     Vector<T> result(dimension);
-    for (size_t i = 0; i < dimension; ++i) {
-        result.data[i] = data[i] + other.data[i];
-    }
+    parallelFor(dimension, 1, Tuning::parameters<T>(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) result.data[i] = data[i] + other.data[i];
+    });
     return result;
 }
 
+// Addition into an expiring left operand
+template<typename T>
+Vector<T> Vector<T>::operator+(const Vector<T>& other) && {
+    *this += other;
+    return std::move(*this);
+}
+
 // Subtraction operator
 template<typename T>
-Vector<T> Vector<T>::operator-(const Vector<T>& other) const {
+Vector<T> Vector<T>::operator-(const Vector<T>& other) const & {
+    LINALG_PROFILE("Vector::subtract", dimension, 1, double(dimension), 3.0 * dimension * sizeof(T));
     if (dimension != other.dimension) {
         throw std::invalid_argument("Vector dimensions must match for subtraction");
     }
     
     Vector<T> result(dimension);
-    for (size_t i = 0; i < dimension; ++i) {
-        result.data[i] = data[i] - other.data[i];
-    }
+    parallelFor(dimension, 1, Tuning::parameters<T>(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) result.data[i] = data[i] - other.data[i];
+    });
     return result;
 }
 
+// Subtraction into an expiring left operand
+template<typename T>
+Vector<T> Vector<T>::operator-(const Vector<T>& other) && {
+    *this -= other;
+    return std::move(*this);
+}
+
 // Scalar multiplication
 template<typename T>
-Vector<T> Vector<T>::operator*(const T& scalar) const {
+Vector<T> Vector<T>::operator*(const T& scalar) const & {
+    LINALG_PROFILE("Vector::scale", dimension, 1, double(dimension), 2.0 * dimension * sizeof(T));
     Vector<T> result(dimension);
-    for (size_t i = 0; i < dimension; ++i) {
-        result.data[i] = data[i] * scalar;
-    }
+    parallelFor(dimension, 1, Tuning::parameters<T>(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) result.data[i] = data[i] * scalar;
+    });
     return result;
 }
 
+// Scalar multiplication of an expiring vector, in place
+template<typename T>
+Vector<T> Vector<T>::operator*(const T& scalar) && {
+    *this *= scalar;
+    return std::move(*this);
+}
+
 // Scalar division
 template<typename T>
-Vector<T> Vector<T>::operator/(const T& scalar) const {
+Vector<T> Vector<T>::operator/(const T& scalar) const & {
+    LINALG_PROFILE("Vector::divide", dimension, 1, double(dimension), 2.0 * dimension * sizeof(T));
     if (std::abs(scalar) < std::numeric_limits<T>::epsilon()) {
         throw std::invalid_argument("Division by zero");
     }
     
     Vector<T> result(dimension);
     T inv_scalar = T(1) / scalar;
-    for (size_t i = 0; i < dimension; ++i) {
-        result.data[i] = data[i] * inv_scalar;
-    }
+    parallelFor(dimension, 1, Tuning::parameters<T>(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) result.data[i] = data[i] * inv_scalar;
+    });
     return result;
 }
 
+// Scalar division of an expiring vector, in place
+template<typename T>
+Vector<T> Vector<T>::operator/(const T& scalar) && {
+    *this /= scalar;
+    return std::move(*this);
+}
+
 // Addition assignment
 template<typename T>
 Vector<T>& Vector<T>::operator+=(const Vector<T>& other) {
+    LINALG_PROFILE("Vector::addAssign", dimension, 1, double(dimension), 3.0 * dimension * sizeof(T));
     if (dimension != other.dimension) {
         throw std::invalid_argument("Vector dimensions must match for addition");
     }
     
-    for (size_t i = 0; i < dimension; ++i) {
-        data[i] += other.data[i];
-    }
+    parallelFor(dimension, 1, Tuning::parameters<T>(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) data[i] += other.data[i];
+    });
     return *this;
 }
 
 // Subtraction assignment
 template<typename T>
 Vector<T>& Vector<T>::operator-=(const Vector<T>& other) {
+    LINALG_PROFILE("Vector::subtractAssign", dimension, 1, double(dimension), 3.0 * dimension * sizeof(T));
     if (dimension != other.dimension) {
         throw std::invalid_argument("Vector dimensions must match for subtraction");
     }
     
-    for (size_t i = 0; i < dimension; ++i) {
-        data[i] -= other.data[i];
-    }
+    parallelFor(dimension, 1, Tuning::parameters<T>(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) data[i] -= other.data[i];
+    });
     return *this;
 }
 
 // Scalar multiplication assignment
 template<typename T>
 Vector<T>& Vector<T>::operator*=(const T& scalar) {
-    for (size_t i = 0; i < dimension; ++i) {
-        data[i] *= scalar;
-    }
+    LINALG_PROFILE("Vector::scaleAssign", dimension, 1, double(dimension), 2.0 * dimension * sizeof(T));
+    parallelFor(dimension, 1, Tuning::parameters<T>(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) data[i] *= scalar;
+    });
     return *this;
 }
 
 // Scalar division assignment
 template<typename T>
 Vector<T>& Vector<T>::operator/=(const T& scalar) {
+    LINALG_PROFILE("Vector::divideAssign", dimension, 1, double(dimension), 2.0 * dimension * sizeof(T));
     if (std::abs(scalar) < std::numeric_limits<T>::epsilon()) {
         throw std::invalid_argument("Division by zero");
     }
     
     T inv_scalar = T(1) / scalar;
-    for (size_t i = 0; i < dimension; ++i) {
-        data[i] *= inv_scalar;
-    }
+    parallelFor(dimension, 1, Tuning::parameters<T>(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) data[i] *= inv_scalar;
+    });
     return *this;
 }
 
 // Unary minus
 template<typename T>
-Vector<T> Vector<T>::operator-() const {
+Vector<T> Vector<T>::operator-() const & {
+    LINALG_PROFILE("Vector::negate", dimension, 1, double(dimension), 2.0 * dimension * sizeof(T));
     Vector<T> result(dimension);
-    for (size_t i = 0; i < dimension; ++i) {
-        result.data[i] = -data[i];
-    }
+    parallelFor(dimension, 1, Tuning::parameters<T>(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) result.data[i] = -data[i];
+    });
     return result;
 }
 
+// Negation of an expiring vector, in place
+template<typename T>
+Vector<T> Vector<T>::operator-() && {
+    LINALG_PROFILE("Vector::negateInPlace", dimension, 1, double(dimension), 2.0 * dimension * sizeof(T));
+    parallelFor(dimension, 1, Tuning::parameters<T>(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) data[i] = -data[i];
+    });
+    return std::move(*this);
+}
+
 // Equality comparison
 template<typename T>
 bool Vector<T>::operator==(const Vector<T>& other) const {
+    LINALG_PROFILE("Vector::equals", dimension, 1, 0.0, 2.0 * dimension * sizeof(T));
     if (dimension != other.dimension) return false;
     
     const T EPSILON = std::numeric_limits<T>::epsilon() * 10;
-    for (size_t i = 0; i < dimension; ++i) {
-        if (std::abs(data[i] - other.data[i]) > EPSILON) return false;
-    }
-    return true;
+    return parallelReduce<bool>(dimension, 1, Tuning::parameters<T>(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (std::abs(data[i] - other.data[i]) > EPSILON) return false;
+        }
+        return true;
+    }, [](bool a, bool b) { return a && b; });
 }
 
 // Optimized dot product using std::inner_product
 template<typename T>
 T Vector<T>::dot(const Vector<T>& other) const {
+    LINALG_PROFILE("Vector::dot", dimension, 1, 2.0 * dimension, 2.0 * dimension * sizeof(T));
     if (dimension != other.dimension) {
         throw std::invalid_argument("Vector dimensions must match for dot product");
     }
     
-    return std::inner_product(data.begin(), data.end(), other.data.begin(), T(0));
+    return parallelReduce<T>(dimension, 1, Tuning::parameters<T>(), [&](size_t begin, size_t end) {
+        return std::inner_product(data.begin() + begin, data.begin() + end, other.data.begin() + begin, T(0));
+    }, std::plus<T>());
 }
 
 // Cross product (3D vectors only)
 template<typename T>
 Vector<T> Vector<T>::cross(const Vector<T>& other) const {
+    LINALG_PROFILE("Vector::cross", dimension, 1, 9.0, 9.0 * sizeof(T));
     if (dimension != 3 || other.dimension != 3) {
         throw std::invalid_argument("Cross product is only defined for 3D vectors");
     }
@@ -153,18 +206,23 @@ Vector<T> Vector<T>::cross(const Vector<T>& other) const {
 // Vector magnitude
 template<typename T>
 T Vector<T>::magnitude() const {
+    LINALG_PROFILE("Vector::magnitude", dimension, 1, 2.0 * dimension, double(dimension) * sizeof(T));
     return std::sqrt(magnitudeSquared());
 }
 
 // Vector magnitude squared (more efficient when you don't need the actual magnitude)
 template<typename T>
 T Vector<T>::magnitudeSquared() const {
-    return std::inner_product(data.begin(), data.end(), data.begin(), T(0));
+    LINALG_PROFILE("Vector::magnitudeSquared", dimension, 1, 2.0 * dimension, double(dimension) * sizeof(T));
+    return parallelReduce<T>(dimension, 1, Tuning::parameters<T>(), [&](size_t begin, size_t end) {
+        return std::inner_product(data.begin() + begin, data.begin() + end, data.begin() + begin, T(0));
+    }, std::plus<T>());
 }
 
 // Normalize vector
 template<typename T>
-Vector<T> Vector<T>::normalize() const {
+Vector<T> Vector<T>::normalize() const & {
+    LINALG_PROFILE("Vector::normalize", dimension, 1, 3.0 * dimension, 2.0 * dimension * sizeof(T));
     T mag = magnitude();
     if (mag < std::numeric_limits<T>::epsilon()) {
         throw std::runtime_error("Cannot normalize zero vector");
@@ -173,9 +231,17 @@ Vector<T> Vector<T>::normalize() const {
     return *this / mag;
 }
 
+// Normalize an expiring vector, reusing its storage
+template<typename T>
+Vector<T> Vector<T>::normalize() && {
+    normalizeInPlace();
+    return std::move(*this);
+}
+
 // Normalize vector in place
 template<typename T>
 Vector<T>& Vector<T>::normalizeInPlace() {
+    LINALG_PROFILE("Vector::normalizeInPlace", dimension, 1, 3.0 * dimension, 2.0 * dimension * sizeof(T));
     T mag = magnitude();
     if (mag < std::numeric_limits<T>::epsilon()) {
         throw std::runtime_error("Cannot normalize zero vector");
@@ -188,18 +254,21 @@ Vector<T>& Vector<T>::normalizeInPlace() {
 // Distance between vectors
 template<typename T>
 T Vector<T>::distance(const Vector<T>& other) const {
+    LINALG_PROFILE("Vector::distance", dimension, 1, 3.0 * dimension, 2.0 * dimension * sizeof(T));
     return (*this - other).magnitude();
 }
 
 // Distance squared between vectors
 template<typename T>
 T Vector<T>::distanceSquared(const Vector<T>& other) const {
+    LINALG_PROFILE("Vector::distanceSquared", dimension, 1, 3.0 * dimension, 2.0 * dimension * sizeof(T));
     return (*this - other).magnitudeSquared();
 }
 
 // Angle between vectors (in radians)
 template<typename T>
 T Vector<T>::angle(const Vector<T>& other) const {
+    LINALG_PROFILE("Vector::angle", dimension, 1);
     if (dimension != other.dimension) {
         throw std::invalid_argument("Vector dimensions must match for angle calculation");
     }
@@ -221,6 +290,7 @@ T Vector<T>::angle(const Vector<T>& other) const {
 // Project this vector onto another vector
 template<typename T>
 Vector<T> Vector<T>::project(const Vector<T>& onto) const {
+    LINALG_PROFILE("Vector::project", dimension, 1);
     if (dimension != onto.dimension) {
         throw std::invalid_argument("Vector dimensions must match for projection");
     }
@@ -237,34 +307,56 @@ Vector<T> Vector<T>::project(const Vector<T>& onto) const {
 // Reject this vector from another vector (orthogonal component)
 template<typename T>
 Vector<T> Vector<T>::reject(const Vector<T>& onto) const {
+    LINALG_PROFILE("Vector::reject", dimension, 1);
     return *this - project(onto);
 }
 
 // Utility functions
 template<typename T>
 void Vector<T>::fill(const T& value) {
-    std::fill(data.begin(), data.end(), value);
+    LINALG_PROFILE("Vector::fill", dimension, 1, 0.0, double(dimension) * sizeof(T));
+    parallelFor(dimension, 1, Tuning::parameters<T>(), [&](size_t begin, size_t end) {
+        std::fill(data.begin() + begin, data.begin() + end, value);
+    });
 }
 
 template<typename T>
 void Vector<T>::fillRandom(T min, T max) {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<T> dis(min, max);
-    
-    for (auto& element : data) {
-        element = dis(gen);
-    }
+    fillRandom(min, max, randomSeed());
+}
+
+// Element i is number i of the seed's stream, whichever thread draws it
+template<typename T>
+void Vector<T>::fillRandom(T min, T max, uint64_t seed) {
+    LINALG_PROFILE("Vector::fillRandom", dimension, 1, 0.0, double(dimension) * sizeof(T));
+    parallelFor(dimension, 1, Tuning::parameters<T>(), [&](size_t begin, size_t end) {
+        randomUniform(data.data() + begin, end - begin, begin, min, max, seed);
+    });
+}
+
+template<typename T>
+void Vector<T>::fillNormal(T mean, T stddev) {
+    fillNormal(mean, stddev, randomSeed());
+}
+
+template<typename T>
+void Vector<T>::fillNormal(T mean, T stddev, uint64_t seed) {
+    LINALG_PROFILE("Vector::fillNormal", dimension, 1, 0.0, double(dimension) * sizeof(T));
+    parallelFor(dimension, 1, Tuning::parameters<T>(), [&](size_t begin, size_t end) {
+        ::randomNormal(data.data() + begin, end - begin, begin, mean, stddev, seed);
+    });
 }
 
 template<typename T>
 void Vector<T>::resize(size_t newSize, const T& fillValue) {
+    LINALG_PROFILE("Vector::resize", newSize, 1);
     data.resize(newSize, fillValue);
     dimension = newSize;
 }
 
 template<typename T>
 Vector<T> Vector<T>::subVector(size_t start, size_t length) const {
+    LINALG_PROFILE("Vector::subVector", length, 1);
     if (start + length > dimension) {
         throw std::out_of_range("Subvector range exceeds vector bounds");
     }
@@ -276,25 +368,35 @@ Vector<T> Vector<T>::subVector(size_t start, size_t length) const {
 // Statistical functions
 template<typename T>
 T Vector<T>::sum() const {
-    return std::accumulate(data.begin(), data.end(), T(0));
+    LINALG_PROFILE("Vector::sum", dimension, 1, double(dimension), double(dimension) * sizeof(T));
+    return parallelReduce<T>(dimension, 1, Tuning::parameters<T>(), [&](size_t begin, size_t end) {
+        return std::accumulate(data.begin() + begin, data.begin() + end, T(0));
+    }, std::plus<T>());
 }
 
 template<typename T>
 T Vector<T>::mean() const {
+    LINALG_PROFILE("Vector::mean", dimension, 1, double(dimension), double(dimension) * sizeof(T));
     if (dimension == 0) return T(0);
     return sum() / static_cast<T>(dimension);
 }
 
 template<typename T>
 T Vector<T>::min() const {
+    LINALG_PROFILE("Vector::min", dimension, 1, double(dimension), double(dimension) * sizeof(T));
     if (dimension == 0) throw std::runtime_error("Cannot find min of empty vector");
-    return *std::min_element(data.begin(), data.end());
+    return parallelReduce<T>(dimension, 1, Tuning::parameters<T>(), [&](size_t begin, size_t end) {
+        return *std::min_element(data.begin() + begin, data.begin() + end);
+    }, [](T a, T b) { return std::min(a, b); });
 }
 
 template<typename T>
 T Vector<T>::max() const {
+    LINALG_PROFILE("Vector::max", dimension, 1, double(dimension), double(dimension) * sizeof(T));
     if (dimension == 0) throw std::runtime_error("Cannot find max of empty vector");
-    return *std::max_element(data.begin(), data.end());
+    return parallelReduce<T>(dimension, 1, Tuning::parameters<T>(), [&](size_t begin, size_t end) {
+        return *std::max_element(data.begin() + begin, data.begin() + end);
+    }, [](T a, T b) { return std::max(a, b); });
 }
 
 // Static factory methods
@@ -310,8 +412,25 @@ Vector<T> Vector<T>::ones(size_t dimension) {
 
 template<typename T>
 Vector<T> Vector<T>::random(size_t dimension, T min, T max) {
+    return random(dimension, min, max, randomSeed());
+}
+
+template<typename T>
+Vector<T> Vector<T>::random(size_t dimension, T min, T max, uint64_t seed) {
+    Vector<T> result(dimension);
+    result.fillRandom(min, max, seed);
+    return result;
+}
+
+template<typename T>
+Vector<T> Vector<T>::randomNormal(size_t dimension, T mean, T stddev) {
+    return randomNormal(dimension, mean, stddev, randomSeed());
+}
+
+template<typename T>
+Vector<T> Vector<T>::randomNormal(size_t dimension, T mean, T stddev, uint64_t seed) {
     Vector<T> result(dimension);
-    result.fillRandom(min, max);
+    result.fillNormal(mean, stddev, seed);
     return result;
 }
 
@@ -341,6 +460,42 @@ Vector<T> operator*(const T& scalar, const Vector<T>& vector) {
     return vector * scalar;
 }
 
+template<typename T>
+Vector<T> operator*(const T& scalar, Vector<T>&& vector) {
+    return std::move(vector) * scalar;
+}
+
+// Right operand expiring: addition commutes, so it accumulates the left one
+template<typename T>
+Vector<T> operator+(const Vector<T>& lhs, Vector<T>&& rhs) {
+    rhs += lhs;
+    return std::move(rhs);
+}
+
+template<typename T>
+Vector<T> operator+(Vector<T>&& lhs, Vector<T>&& rhs) {
+    return std::move(lhs) + rhs;
+}
+
+// rhs <- lhs - rhs, element by element
+template<typename T>
+Vector<T> operator-(const Vector<T>& lhs, Vector<T>&& rhs) {
+    LINALG_PROFILE("Vector::subtractInto", lhs.dimension, 1, double(lhs.dimension), 3.0 * lhs.dimension * sizeof(T));
+    if (lhs.dimension != rhs.dimension) {
+        throw std::invalid_argument("Vector dimensions must match for subtraction");
+    }
+    
+    for (size_t i = 0; i < lhs.dimension; ++i) {
+        rhs.data[i] = lhs.data[i] - rhs.data[i];
+    }
+    return std::move(rhs);
+}
+
+template<typename T>
+Vector<T> operator-(Vector<T>&& lhs, Vector<T>&& rhs) {
+    return std::move(lhs) - rhs;
+}
+
 template<typename T>
 std::ostream& operator<<(std::ostream& os, const Vector<T>& vector) {
     vector.print(os);
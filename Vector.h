@@ -5,6 +5,9 @@
 #include <stdexcept>
 #include <algorithm>
 #include <numeric>
+#include "Profiler.h"
+#include "ParallelFor.h"
+#include "Random.h"
 
 template<typename T = double>
 class Vector {
@@ -48,18 +51,24 @@ public:
     T& at(size_t index) { return operator[](index); }
     const T& at(size_t index) const { return operator[](index); }
 
-    // Vector operations
-    Vector operator+(const Vector& other) const;
-    Vector operator-(const Vector& other) const;
-    Vector operator*(const T& scalar) const;
-    Vector operator/(const T& scalar) const;
+    // Vector operations. The && overloads compute in the storage of an
+    // expiring left operand instead of allocating a result.
+    Vector operator+(const Vector& other) const &;
+    Vector operator+(const Vector& other) &&;
+    Vector operator-(const Vector& other) const &;
+    Vector operator-(const Vector& other) &&;
+    Vector operator*(const T& scalar) const &;
+    Vector operator*(const T& scalar) &&;
+    Vector operator/(const T& scalar) const &;
+    Vector operator/(const T& scalar) &&;
     Vector& operator+=(const Vector& other);
     Vector& operator-=(const Vector& other);
     Vector& operator*=(const T& scalar);
     Vector& operator/=(const T& scalar);
     
     // Unary operators
-    Vector operator-() const;
+    Vector operator-() const &;
+    Vector operator-() &&;
     
     // Comparison
     bool operator==(const Vector& other) const;
@@ -70,7 +79,8 @@ public:
     Vector cross(const Vector& other) const;  // Only for 3D vectors
     T magnitude() const;
     T magnitudeSquared() const;
-    Vector normalize() const;
+    Vector normalize() const &;
+    Vector normalize() &&;
     Vector& normalizeInPlace();
     
     // Distance functions
@@ -95,7 +105,12 @@ public:
     
     // Utility functions
     void fill(const T& value);
+    // Uniform on [min, max) ([min, max] for integer types) and normal;
+    // reproducible for a given seed whatever the thread count (Random.h)
     void fillRandom(T min = T(0), T max = T(1));
+    void fillRandom(T min, T max, uint64_t seed);
+    void fillNormal(T mean = T(0), T stddev = T(1));
+    void fillNormal(T mean, T stddev, uint64_t seed);
     void resize(size_t newSize, const T& fillValue = T(0));
     Vector subVector(size_t start, size_t length) const;
     
@@ -109,6 +124,9 @@ public:
     static Vector zeros(size_t dimension);
     static Vector ones(size_t dimension);
     static Vector random(size_t dimension, T min = T(0), T max = T(1));
+    static Vector random(size_t dimension, T min, T max, uint64_t seed);
+    static Vector randomNormal(size_t dimension, T mean = T(0), T stddev = T(1));
+    static Vector randomNormal(size_t dimension, T mean, T stddev, uint64_t seed);
     static Vector unitX() { return Vector({T(1), T(0), T(0)}); }
     static Vector unitY() { return Vector({T(0), T(1), T(0)}); }
     static Vector unitZ() { return Vector({T(0), T(0), T(1)}); }
@@ -127,10 +145,25 @@ public:
     template<typename U>
     friend Vector<U> operator*(const U& scalar, const Vector<U>& vector);
     
+    template<typename U>
+    friend Vector<U> operator-(const Vector<U>& lhs, Vector<U>&& rhs);
+    
     template<typename U>
     friend std::ostream& operator<<(std::ostream& os, const Vector<U>& vector);
 };
 
+// Overloads for an expiring right operand, which then holds the result
+template<typename T>
+Vector<T> operator+(const Vector<T>& lhs, Vector<T>&& rhs);
+template<typename T>
+Vector<T> operator+(Vector<T>&& lhs, Vector<T>&& rhs);
+template<typename T>
+Vector<T> operator-(const Vector<T>& lhs, Vector<T>&& rhs);
+template<typename T>
+Vector<T> operator-(Vector<T>&& lhs, Vector<T>&& rhs);
+template<typename T>
+Vector<T> operator*(const T& scalar, Vector<T>&& vector);
+
 // Typedef for common types
 using VectorD = Vector<double>;
 using VectorF = Vector<float>;
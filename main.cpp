@@ -1,6 +1,7 @@
 #include "Matrix.h"
 #include "Vector.h"
 #include "PerformanceBenchmark.h"
+#include "BatchCLI.h"
 #include <iostream>
 #include <string>
 #include <chrono>
@@ -304,7 +305,12 @@ void qrDecomposition() {
     std::cout << "\nComputation time: " << duration.count() << " microseconds" << std::endl;
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    // Any command-line argument selects the non-interactive batch mode
+    if (BatchCLI::isBatchInvocation(argc)) {
+        return BatchCLI::run(argc, argv);
+    }
+
     int choice;
     
     do {